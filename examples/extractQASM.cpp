@@ -0,0 +1,57 @@
+#include "f3c/io/QASMArchive.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main( int argc , char *argv[] ) {
+
+  // arguments
+  if ( argc < 2 ) {
+    std::cout << "usage: " << argv[0] << " archive [timestep [filename]]\n\n"
+              << "  Lists the snapshots of the QASM archive, or extracts the "
+                 "QASM of timestep\n"
+              << "  to filename (default: standard output)." << std::endl ;
+    return -1 ;
+  }
+
+  try {
+    f3c::io::QASMArchiveReader archive( argv[1] ) ;
+
+    // list snapshots
+    if ( argc < 3 ) {
+      std::cout << archive.nbRecords() << " snapshot(s)\n" ;
+      for ( size_t k = 0; k < archive.nbRecords(); k++ ) {
+        const auto record = archive.record( k ) ;
+        std::printf( "  %8llu: %u qubits, %zu bytes, // %.*s" ,
+                     (unsigned long long) record.timestep , record.nbQubits ,
+                     record.qasm.size() , int( record.comment.size() ) ,
+                     record.comment.data() ) ;
+      }
+      return 0 ;
+    }
+
+    // extract snapshot
+    const auto timestep = std::stoull( argv[2] ) ;
+    const size_t k = archive.find( timestep ) ;
+    if ( k == archive.nbRecords() ) {
+      std::cout << "ERROR: timestep " << timestep << " is not in \""
+                << argv[1] << "\"!" << std::endl ;
+      return -2 ;
+    }
+    f3c::io::QASMBuffer buffer ;
+    archive.qasm( k , buffer ) ;
+    if ( argc < 4 ) {
+      buffer.write( std::cout ) ;
+    } else {
+      std::ofstream stream( argv[3] , std::ios::binary ) ;
+      buffer.write( stream ) ;
+    }
+  } catch ( const std::exception& e ) {
+    std::cout << "ERROR: " << e.what() << std::endl ;
+    return -3 ;
+  }
+
+  return 0 ;
+
+}
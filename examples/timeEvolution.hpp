@@ -1,10 +1,26 @@
 #include "qclab/QCircuit.hpp"
 #include "f3c/SquareCircuit.hpp"
 #include "f3c/TriangleCircuit.hpp"
+#include "f3c/freeFermion.hpp"
+#include "f3c/precision.hpp"
 #include "f3c/parameters.hpp"
 #include "f3c/qgates/functors.hpp"
+#include "f3c/io/INIFile.hpp"
+#include "f3c/io/AsyncWriter.hpp"
+#include "f3c/io/QASMArchive.hpp"
+#include "f3c/io/QASMBuffer.hpp"
+#include "f3c/io/QASMTemplate.hpp"
 #include <string>
+#include <condition_variable>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 template <typename P>
 std::string printTimestep( const int i ,
@@ -52,61 +68,822 @@ std::string printTimestep( const int i ,
 }
 
 
-template <typename F, typename C, typename P>
-void qasm( const C& circuit , const size_t i , const double dt ,
-           const P* hx , const P* hy , const P* hz ,
-           const P* Jx , const P* Jy , const P* Jz ,
-           std::string filename ) {
+/**
+ * Returns the number of wires of the circuits of functor F on N qubits, i.e.,
+ * the 2N Majorana modes for TFIM-rotation gates and the N qubits otherwise.
+ */
+template <typename F>
+constexpr int wires( const int N ) {
+  return f3c::is_TFIM_v< typename F::gate_type > ? 2*N : N ;
+}
 
-  using gate_type = typename F::gate_type ;
-  using qasm_gate_type = typename F::qasm_gate_type ;
 
-  // generate qasm
-  std::stringstream qasm ;
-  if constexpr ( std::is_same_v< gate_type , qasm_gate_type > ) {
-    circuit.toQASM( qasm ) ;
-  } else {
-    using T = typename F::value_type ;
-    qclab::QCircuit< T , qasm_gate_type >  tmpcircuit( circuit.nbQubits() ) ;
-    for ( auto it = circuit.begin(); it != circuit.end(); ++it ) {
-      tmpcircuit.push_back( std::make_unique< qasm_gate_type >( **it ) ) ;
+/**
+ * Pool of the circuit snapshots of the writer threads. Every snapshot is
+ * allocated at its first use and later overwritten in place, the writer
+ * returns a snapshot to the pool once its QASM is rendered.
+ */
+template <typename T, typename G>
+class SnapshotPool {
+
+  public:
+    /// Circuit type of the snapshots.
+    using circuit_type = qclab::QCircuit< T , G > ;
+
+    /// Constructs a pool of `size` snapshots.
+    SnapshotPool( const size_t size )
+    : snapshots_( size )
+    {
+      for ( size_t k = size; k > 0; k-- ) free_.push_back( k-1 ) ;
+    }
+
+    /**
+     * Copies `circuit` into a free snapshot and returns its index, blocks
+     * while all snapshots are in use. The gates of the snapshot are
+     * overwritten in place, unless `circuit` has a different number of
+     * qubits or offset, or fewer gates.
+     */
+    template <typename C>
+    size_t acquire( const C& circuit ) {
+      std::unique_lock< std::mutex > lock( mutex_ ) ;
+      released_.wait( lock , [this]{ return !free_.empty() ; } ) ;
+      const size_t index = free_.back() ;
+      free_.pop_back() ;
+      lock.unlock() ;
+      auto& snapshot = snapshots_[index] ;
+      const size_t nbGates = circuit.nbGates() ;
+      if ( !snapshot || snapshot->nbQubits() != circuit.nbQubits() ||
+           snapshot->offset() != circuit.offset() ||
+           snapshot->nbGates() > nbGates ) {
+        snapshot = std::make_unique< circuit_type >( circuit.nbQubits() ,
+                                                     circuit.offset() ) ;
+        snapshot->reserve( nbGates ) ;
+      }
+      size_t k = 0 ;
+      for ( auto it = circuit.begin(); it != circuit.end(); ++it , ++k ) {
+        if ( k < snapshot->nbGates() ) {
+          *(*snapshot)[k] = **it ;
+        } else {
+          snapshot->push_back( std::make_unique< G >( **it ) ) ;
+        }
+      }
+      return index ;
+    }
+
+    /// Returns the snapshot `index`.
+    const circuit_type& operator[]( const size_t index ) const {
+      return *snapshots_[index] ;
+    }
+
+    /// Returns the snapshot `index` to the pool.
+    void release( const size_t index ) {
+      {
+        std::lock_guard< std::mutex > guard( mutex_ ) ;
+        free_.push_back( index ) ;
+      }
+      released_.notify_one() ;
+    }
+
+  private:
+    /// Snapshots, allocated at their first use.
+    std::vector< std::unique_ptr< circuit_type > >  snapshots_ ;
+    /// Indices of the free snapshots.
+    std::vector< size_t >  free_ ;
+    /// Mutex that guards the free snapshots.
+    std::mutex  mutex_ ;
+    /// Signals that a snapshot is returned to the pool.
+    std::condition_variable  released_ ;
+
+} ;
+
+
+/// Output stage of the QASM snapshots.
+struct OutputStage {
+  /// Constructs the output stage of the snapshots named `filename`.
+  OutputStage( const std::string& filename , const int writers ,
+               const int queue , const bool archive ,
+               const bool parameterized )
+  : poolSize( std::max( queue , 1 ) + std::max( writers , 0 ) )
+  , writer( writers , queue )
+  , filename( filename )
+  , parameterized( parameterized )
+  {
+    if ( archive ) {
+      this->archive = std::make_unique< f3c::io::QASMArchiveWriter >(
+                                                      filename + ".f3ca" ) ;
+    }
+  }
+
+  /// Waits for the queued snapshots and closes the archive and the table.
+  void finish() {
+    writer.finish() ;
+    if ( archive ) archive->close() ;
+    if ( angles ) angles->close() ;
+    if ( comments.is_open() ) comments.close() ;
+  }
+
+  /**
+   * Checks if `circuit` on N qubits has the topology of the parameterized
+   * template. The template, the angle table, and the comments file are
+   * created at the first square circuit, all later square circuits have the
+   * same topology.
+   */
+  template <typename F, typename C>
+  bool matches( const C& circuit , const int N ) {
+    if ( !parameterized ) return false ;
+    using size_type = typename C::size_type ;
+    const size_type nbGates = circuit.nbGates() ;
+    std::lock_guard< std::mutex > guard( mutex ) ;
+    if ( angles ) {
+      // compare in place with the topology of the template
+      if ( nbGates + 1 != topology.size() ) return false ;
+      if ( circuit.offset() != topology[0] ) return false ;
+      for ( size_type k = 0; k < nbGates; k++ ) {
+        if ( circuit[k]->qubitPair()[0] != topology[k+1] ) return false ;
+      }
+      return true ;
+    }
+    const size_type W = circuit.nbQubits() ;
+    if ( nbGates != W*(W-1)/2 ) return false ;
+    const size_t nbParameters = nbGates * F::nbAngles ;
+    f3c::io::QASMBuffer buffer ;
+    f3c::io::qasmTemplateHeader( buffer , "square circuit, bind the angles "
+                                 "of " + filename + ".angles; parameters "
+                                 "of the timesteps in " + filename +
+                                 ".comments" , N , nbParameters ) ;
+    f3c::io::qasmTemplate< F >( circuit , buffer ) ;
+    std::ofstream stream( filename + ".template.qasm" , std::ios::binary ) ;
+    buffer.write( stream ) ;
+    angles = std::make_unique< f3c::io::AngleTableWriter >(
+                                      filename + ".angles" , nbParameters ) ;
+    comments.open( filename + ".comments" , std::ios::trunc ) ;
+    topology.resize( nbGates + 1 ) ;
+    topology[0] = circuit.offset() ;
+    for ( size_type k = 0; k < nbGates; k++ ) {
+      topology[k+1] = circuit[k]->qubitPair()[0] ;
     }
-    tmpcircuit.toQASM( qasm ) ;
+    return true ;
   }
 
+  /**
+   * Appends the angles `values` of the snapshot at timestep `timestep` to
+   * the angle table, and its comment line `comment`, e.g., the Hamiltonian
+   * parameters, to the comments file.
+   */
+  void append( const uint64_t timestep , const double* values ,
+               const std::string& comment ) {
+    std::lock_guard< std::mutex > guard( mutex ) ;
+    angles->append( timestep , values ) ;
+    comments << comment ;
+  }
+
+  /**
+   * Returns the snapshot pool of the circuits with gates of type G. A pool
+   * holds a snapshot for every queued task and for the task of every writer
+   * thread.
+   */
+  template <typename T, typename G>
+  SnapshotPool< T , G >& pool() {
+    std::lock_guard< std::mutex > guard( mutex ) ;
+    auto& pool = pools[ std::type_index( typeid( G ) ) ] ;
+    if ( !pool ) pool = std::make_shared< SnapshotPool< T , G > >( poolSize );
+    return *std::static_pointer_cast< SnapshotPool< T , G > >( pool ) ;
+  }
+
+  /// Number of snapshots of every snapshot pool.
+  size_t  poolSize ;
+  /// Snapshot pools per gate type, they outlive the writer threads.
+  std::unordered_map< std::type_index , std::shared_ptr< void > >  pools ;
+  /// Writer threads of the QASM snapshots.
+  f3c::io::AsyncWriter  writer ;
+  /// Archive of the QASM snapshots, or one QASM file per snapshot if null.
+  std::unique_ptr< f3c::io::QASMArchiveWriter >  archive ;
+  /// Name of the QASM snapshots.
+  std::string  filename ;
+  /// Writes the square snapshots as angles of a parameterized template.
+  bool  parameterized ;
+  /// Angle table of the square snapshots, created with the template.
+  std::unique_ptr< f3c::io::AngleTableWriter >  angles ;
+  /// Comment lines of the rows of the angle table, in the order of the rows.
+  std::ofstream  comments ;
+  /// Offset and first wire of every gate of the template.
+  std::vector< int >  topology ;
+  /// Mutex that guards the template, the angle table, and the pools.
+  std::mutex  mutex ;
+} ;
+
+
+template <typename F, typename C, typename P>
+void writeQASM( const C& circuit , const size_t i , const double dt ,
+                const P* hx , const P* hy , const P* hz ,
+                const P* Jx , const P* Jy , const P* Jz ,
+                std::string filename , OutputStage& stage ) {
+
+  const int N = f3c::freeFermion::nbModes( circuit ) / 2 ;
+
+  // append the angles of the parameterized template
+  if ( stage.matches< F >( circuit , N ) ) {
+    static thread_local std::vector< double >  angles ;
+    angles.resize( circuit.nbGates() * F::nbAngles ) ;
+    f3c::io::qasmAngles< F >( circuit , angles.data() ) ;
+    stage.append( i+1 , angles.data() ,
+                  printTimestep( i , hx , hy , hz , Jx , Jy , Jz , dt ) ) ;
+    return ;
+  }
+
+  // generate qasm in a reusable buffer
+  static thread_local f3c::io::QASMBuffer  buffer ;
+  buffer.clear() ;
+  f3c::io::QASMArchiveWriter* archive = stage.archive.get() ;
+  const std::string comment = printTimestep( i , hx , hy , hz , Jx , Jy , Jz ,
+                                             dt ) ;
+
+  // append to archive
+  if ( archive ) {
+    F::toQASM( circuit , buffer ) ;
+    archive->append( i+1 , N , comment , buffer.view() ) ;
+    return ;
+  }
+
+  f3c::io::qasmHeader( buffer , comment , N ) ;
+  F::toQASM( circuit , buffer ) ;
+
   // write to file
   filename.append( std::to_string( i+1 ) ) ;
   filename.append( ".qasm" ) ;
-  std::ofstream stream( filename ) ;
-  const int N = circuit.nbQubits() ;
-  stream << "// Generated by f3c++\n"
-         << "// https://github.com/QuantumComputingLab/f3cpp\n\n"
-         << "// " << printTimestep( i , hx , hy , hz , Jx , Jy , Jz , dt )
-         << "\n\n"
-         << "OPENQASM 2.0;\n"
-         << "include \"qelib1.inc\";\n\n"
-         << "qreg q[" << N << "];\n"
-         << qasm.str() ;
+  std::ofstream stream( filename , std::ios::binary ) ;
+  buffer.write( stream ) ;
   stream.close() ;
 
 }
 
 
+/**
+ * Writes the QASM of `circuit` at timestep i to a file or to the archive.
+ * With asynchronous writer threads, `circuit` is copied into a snapshot of
+ * the pool of the output stage and the QASM is generated and written while
+ * the compression continues.
+ */
+template <typename F, typename C, typename P>
+void qasm( OutputStage& stage ,
+           const C& circuit , const size_t i , const double dt ,
+           const P* hx , const P* hy , const P* hz ,
+           const P* Jx , const P* Jy , const P* Jz ,
+           const std::string filename ) {
+
+  if ( stage.writer.nbThreads() == 0 ) {
+    writeQASM< F >( circuit , i , dt , hx , hy , hz , Jx , Jy , Jz ,
+                    filename , stage ) ;
+    return ;
+  }
+
+  // snapshot of the circuit, returned to the pool after writing
+  using G = f3c::freeFermion::gate_t< C > ;
+  using T = typename G::value_type ;
+  auto& pool = stage.pool< T , G >() ;
+  const size_t index = pool.acquire( circuit ) ;
+  stage.writer.push( [=,&stage,&pool]{
+    try {
+      writeQASM< F >( pool[index] , i , dt , hx , hy , hz , Jx , Jy , Jz ,
+                      filename , stage ) ;
+    } catch ( ... ) {
+      pool.release( index ) ;
+      throw ;
+    }
+    pool.release( index ) ;
+  } ) ;
+
+}
+
+
+/// Settings of the compression engine.
+struct Engine {
+  /// Number of timesteps that are merged as one pipelined wavefront.
+  int pipeline = 1 ;
+  /// Compiles constant Hamiltonians by repeated squaring of the timestep.
+  bool squaring = false ;
+  /// Number of chunks of timesteps that are compressed in parallel.
+  int chunks = 1 ;
+  /// Compiles the exact free-fermion propagator without Trotter steps.
+  bool exact = false ;
+  /// Merges the timesteps in single precision with error control.
+  bool mixed = false ;
+  /// Number of timesteps between 2 re-unitarizations in mixed precision.
+  int normalize = 10 ;
+  /// Error bound of the mixed precision that escalates to double precision.
+  double tolerance = 1e-4 ;
+  /// Number of asynchronous QASM writer threads, 0 writes synchronously.
+  int writers = 0 ;
+  /// Maximum number of circuit snapshots queued for the writer threads.
+  int queue = 4 ;
+  /// Appends all snapshots to one QASM archive instead of one file each.
+  bool archive = false ;
+  /**
+   * Writes the square snapshots once as parameterized OpenQASM 3 template
+   * and their angles as rows of a binary angle table. The comment lines of
+   * the snapshots are written to a separate text file.
+   */
+  bool parameterized = false ;
+  /**
+   * Compiles TFXY models with Jy = 0 with TFIM-rotation gates on the 2N
+   * Majorana modes. The QASM of these circuits has twice the CNOTs of the
+   * TFXY circuits.
+   */
+  bool tfim = false ;
+} ;
+
+
+/// Reads the settings of the compression engine from the INI file `file`.
+inline Engine engine( f3c::io::INIFile& file ) {
+
+  Engine engine ;
+  if ( file.contains( "Engine.pipeline" ) ) {
+    engine.pipeline = std::max( file.value< int >( "Engine.pipeline" ) , 1 ) ;
+  }
+  if ( file.contains( "Engine.squaring" ) ) {
+    engine.squaring = ( file.value< int >( "Engine.squaring" ) != 0 ) ;
+  }
+  if ( file.contains( "Engine.chunks" ) ) {
+    engine.chunks = std::max( file.value< int >( "Engine.chunks" ) , 1 ) ;
+  }
+  if ( file.contains( "Engine.exact" ) ) {
+    engine.exact = ( file.value< int >( "Engine.exact" ) != 0 ) ;
+  }
+  if ( file.contains( "Engine.mixed" ) ) {
+    engine.mixed = ( file.value< int >( "Engine.mixed" ) != 0 ) ;
+  }
+  if ( file.contains( "Engine.normalize" ) ) {
+    engine.normalize = std::max( file.value< int >( "Engine.normalize" ) , 1 );
+  }
+  if ( file.contains( "Engine.tolerance" ) ) {
+    engine.tolerance = file.value< double >( "Engine.tolerance" ) ;
+  }
+  if ( file.contains( "Engine.writers" ) ) {
+    engine.writers = std::max( file.value< int >( "Engine.writers" ) , 0 ) ;
+  }
+  if ( file.contains( "Engine.queue" ) ) {
+    engine.queue = std::max( file.value< int >( "Engine.queue" ) , 1 ) ;
+  }
+  if ( file.contains( "Engine.archive" ) ) {
+    engine.archive = ( file.value< int >( "Engine.archive" ) != 0 ) ;
+  }
+  if ( file.contains( "Engine.parameterized" ) ) {
+    engine.parameterized =
+                        ( file.value< int >( "Engine.parameterized" ) != 0 ) ;
+  }
+  if ( file.contains( "Engine.tfim" ) ) {
+    engine.tfim = ( file.value< int >( "Engine.tfim" ) != 0 ) ;
+  }
+  return engine ;
+
+}
+
+
+/// Checks if the parameters are constant over the first `ntot` timesteps.
+template <typename P>
+bool isConstant( const size_t ntot ,
+                 const P* hx , const P* hy , const P* hz ,
+                 const P* Jx , const P* Jy , const P* Jz ) {
+
+  for ( const P* p : { hx , hy , hz , Jx , Jy , Jz } ) {
+    for ( size_t i = 1; i < ntot; i++ ) {
+      if ( (*p)[i] != (*p)[0] ) return false ;
+    }
+  }
+  return true ;
+
+}
+
+
+/**
+ * Compresses the timesteps `first` up to `last` into a triangle circuit. The
+ * first (N+1)/2 timesteps are stacked in a square circuit, the remaining
+ * timesteps are merged one by one. The parallel regions run on `nbThreads`
+ * threads, or on the default number of OpenMP threads if `nbThreads` is 0.
+ */
+template <typename F, typename P>
+f3c::TriangleCircuit< typename F::value_type , typename F::gate_type >
+compressChunk( const int N , const double dt ,
+               const size_t first , const size_t last ,
+               const P* hx , const P* hy , const P* hz ,
+               const P* Jx , const P* Jy , const P* Jz ,
+               const int nbThreads = 0 ) {
+
+  using G = typename F::gate_type ;
+  using T = typename F::value_type ;
+  const int m = (N+1)/2 ;
+  assert( last - first >= size_t( m ) ) ;
+
+  // square circuit
+  qclab::QCircuit< T , G >  circ1( N , 0 , N-1 ) ;
+  f3c::SquareCircuit< T , G > square( N ) ;
+  for ( int k = 0; k < m; k++ ) {
+    const size_t i = first + k ;
+    F::template timestep( dt , (*hx)[i] , (*hy)[i] , (*hz)[i] ,
+                               (*Jx)[i] , (*Jy)[i] , (*Jz)[i] , circ1 ) ;
+    const int nbGates = ( k < N/2 ) ? N-1 : N/2 ;
+    for ( int j = 0; j < nbGates; j++ ) {
+      square[ j + (N-1)*k ] = std::move( circ1[j] ) ;
+    }
+  }
+
+  // square --> triangle
+  auto triangle = square.toTriangle( nbThreads ) ;
+  if ( N % 2 != 0 ) {
+    triangle.mergeLayer( qclab::Side::Right , circ1.begin() + N/2 ,
+                                              circ1.end() , nbThreads ) ;
+  }
+
+  // merge timesteps
+  for ( size_t i = first + m; i < last; i++ ) {
+    F::template timestep( dt , (*hx)[i] , (*hy)[i] , (*hz)[i] ,
+                               (*Jx)[i] , (*Jy)[i] , (*Jz)[i] , circ1 ) ;
+    triangle.mergeLayer( qclab::Side::Right , circ1.begin() , circ1.end() ,
+                         nbThreads ) ;
+  }
+  return triangle ;
+
+}
+
+
+/**
+ * Splits the OpenMP threads over `nb` concurrent tasks and the parallel
+ * regions nested in them, e.g., the wavefronts of mergeLayer. The outer loop
+ * runs on `outer` threads, the nested regions of every task request the
+ * remaining `inner` threads with their `num_threads` argument. No OpenMP
+ * settings are changed: without nested parallelism, e.g., enabled with
+ * OMP_MAX_ACTIVE_LEVELS=2, the nested regions run on 1 thread.
+ */
+struct NestedTeams {
+
+  explicit NestedTeams( const int nb ) {
+#ifdef _OPENMP
+    const int nbThreads = omp_get_max_threads() ;
+    outer = std::max( 1 , std::min( nb , nbThreads ) ) ;
+    if ( omp_get_max_active_levels() > omp_get_active_level() + 1 ) {
+      inner = std::max( 1 , nbThreads / outer ) ;
+    }
+#endif
+  }
+
+  /// Number of threads of the outer loop.
+  int outer = 1 ;
+  /// Number of threads of the nested regions of every task.
+  int inner = 1 ;
+
+} ;
+
+
+/**
+ * Composes the consecutive triangle circuits in `triangles` with a binary
+ * tree reduction. The triangles of every level are merged in parallel, the
+ * threads that are left over, e.g., for the last levels with few pairs, run
+ * the nested parallel regions of the merges. The result is stored in the
+ * first triangle.
+ */
+template <typename C>
+void reduceTriangles( std::vector< std::unique_ptr< C > >& triangles ) {
+
+  for ( size_t stride = 1; stride < triangles.size(); stride *= 2 ) {
+    const int nbPairs = ( triangles.size() - 1 ) / ( 2*stride ) + 1 ;
+    const NestedTeams teams( nbPairs ) ;
+    #pragma omp parallel for schedule(dynamic) num_threads(teams.outer)
+    for ( int k = 0; k < nbPairs; k++ ) {
+      const size_t i = 2*stride*k ;
+      if ( i + stride < triangles.size() ) {
+        triangles[i]->merge( qclab::Side::Right , *triangles[i + stride] ,
+                             teams.inner ) ;
+        triangles[i + stride].reset() ;
+      }
+    }
+  }
+
+}
+
+
+/**
+ * Compresses the timesteps `first` up to `last` into a triangle circuit. The
+ * timesteps are split in `nbChunks` chunks that are compressed in parallel
+ * with compressChunk and composed with reduceTriangles. The threads that are
+ * left over run the nested parallel regions of the chunks.
+ */
+template <typename F, typename P>
+f3c::TriangleCircuit< typename F::value_type , typename F::gate_type >
+compressChunks( const int N , const double dt ,
+                const size_t first , const size_t last , const int nbChunks ,
+                const P* hx , const P* hy , const P* hz ,
+                const P* Jx , const P* Jy , const P* Jz ) {
+
+  using C = f3c::TriangleCircuit< typename F::value_type ,
+                                  typename F::gate_type > ;
+  assert( nbChunks >= 1 ) ;
+
+  std::vector< std::unique_ptr< C > >  chunks( nbChunks ) ;
+  const NestedTeams teams( nbChunks ) ;
+  #pragma omp parallel for schedule(dynamic) num_threads(teams.outer)
+  for ( int c = 0; c < nbChunks; c++ ) {
+    const size_t i1 = first + ( c * ( last - first ) ) / nbChunks ;
+    const size_t i2 = first + ( ( c+1 ) * ( last - first ) ) / nbChunks ;
+    chunks[c] = std::make_unique< C >(
+      compressChunk< F >( N , dt , i1 , i2 , hx , hy , hz , Jx , Jy , Jz ,
+                          teams.inner ) ) ;
+  }
+  reduceTriangles( chunks ) ;
+  return std::move( *chunks[0] ) ;
+
+}
+
+
+/**
+ * Compiles the exact propagators of the free-fermion Hamiltonian at the output
+ * timesteps. The single-particle matrix is updated with one matrix exponential
+ * per run of timesteps with equal parameters, and factored into a triangle
+ * circuit at every output.
+ */
+template <typename F, typename P>
+int exactEvolution( const int N , const size_t ntot , const double dt ,
+                    const size_t imin , const size_t imax ,
+                    const size_t step ,
+                    const P* hx , const P* hy , const P* hz ,
+                    const P* Jx , const P* Jy , const P* Jz ,
+                    const std::string filename , const int debug ,
+                    const Engine& engine ) {
+
+  using G = typename F::gate_type ;
+  using T = typename F::value_type ;
+  using R = qclab::real_t< T > ;
+  namespace ff = f3c::freeFermion ;
+
+  // output stage
+  OutputStage  stage( filename , engine.writers , engine.queue ,
+                      engine.archive , engine.parameterized ) ;
+
+  auto coefficients = [&]( const size_t i ) {
+    return F::coefficients( R( (*hx)[i] ) , R( (*hy)[i] ) , R( (*hz)[i] ) ,
+                            R( (*Jx)[i] ) , R( (*Jy)[i] ) , R( (*Jz)[i] ) ) ;
+  } ;
+
+  // single-particle matrix
+  auto O = ff::eye< R >( 2*N ) ;
+  qclab::QCircuit< T , G >  circuit( wires< F >( N ) ) ;
+  size_t out = imin ;
+  size_t i = 0 ;
+  while ( i < ntot ) {
+    // run of timesteps with equal parameters up to the next output
+    const auto c = coefficients( i ) ;
+    size_t next = i + 1 ;
+    while ( ( next < ntot ) && ( next != out || out > imax ) &&
+            ( coefficients( next ) == c ) ) {
+      next++ ;
+    }
+    std::cout << "* timesteps " << i+1 << "-" << next << ": "
+              << printTimestep( next-1 , hx , hy , hz , Jx , Jy , Jz ) ;
+    auto H = ff::generator< R >( N , c[0] , c[1] , c[2] ) ;
+    for ( auto& h : H ) h *= R( ( next - i ) * dt ) ;
+    O = ff::gemm( 2*N , ff::expm( 2*N , H ) , O ) ;
+    i = next ;
+    // output
+    if ( ( out == i && i <= imax ) || ( i == ntot ) ) {
+      std::printf( "    - compile exact propagator\n" ) ;
+      auto triangle = ff::compile< T , G >( N , O ) ;
+      circuit = triangle.toSquare() ;
+      if ( out == i && i <= imax ) {
+        qasm< F >( stage , circuit , i-1 , dt , hx , hy , hz , Jx , Jy , Jz ,
+                   filename ) ;
+        out += step ;
+      }
+    }
+  }
+
+  std::cout << std::endl ;
+  if ( debug > 1 && !f3c::is_TFIM_v< G > ) {
+    qclab::printMatrix( circuit.matrix() ) ;
+    std::cout << std::endl ;
+  }
+
+  // wait for the output stage
+  stage.finish() ;
+
+  // successful
+  return 0 ;
+
+}
+
+
+/// Rebinds the functor type F to the value type U.
+template <typename F, typename U>
+struct rebind ;
+
+/// Template specialized rebind for functor templates.
+template <template <typename> class F, typename T, typename U>
+struct rebind< F< T > , U > {
+  using type = F< U > ;
+} ;
+
+
+/**
+ * Compresses the timesteps in single precision with double precision error
+ * control. The first (N+1)/2 timesteps are compressed as one chunk, the
+ * remaining timesteps are merged one by one. Every `engine.normalize`
+ * timesteps, before every output, and at the end, the gates of the triangle
+ * are re-unitarized and the error of the triangle is measured in double
+ * precision against the single-particle matrix of the Trotter circuit.
+ * Once the error exceeds `engine.tolerance`, the last accepted checkpoint,
+ * i.e., the last single precision triangle within the tolerance, is
+ * converted to double precision, and the timesteps since that checkpoint and
+ * the remaining timesteps are merged in double precision.
+ */
+template <typename F, typename P>
+int mixedEvolution( const int nbQubits , const size_t ntot , const double dt ,
+                    const size_t imin , const size_t imax ,
+                    const size_t step ,
+                    const P* hx , const P* hy , const P* hz ,
+                    const P* Jx , const P* Jy , const P* Jz ,
+                    const std::string filename , const int debug ,
+                    const Engine& engine ) {
+
+  using G = typename F::gate_type ;
+  using T = typename F::value_type ;
+  using R = qclab::real_t< T > ;
+  using F32 = typename rebind< F , std::complex< float > >::type ;
+  using G32 = typename F32::gate_type ;
+  using T32 = typename F32::value_type ;
+
+  const int N = wires< F >( nbQubits ) ;
+  const size_t m = (N+1)/2 ;
+  const size_t nbGates = N-1 ;
+  assert( ntot > m ) ;
+
+  // output stage
+  OutputStage  stage( filename , engine.writers , engine.queue ,
+                      engine.archive , engine.parameterized ) ;
+
+  // single-particle matrix of the reference circuit
+  auto reference = f3c::freeFermion::eye< R >( 2*nbQubits ) ;
+
+  // 1 timestep circuits
+  qclab::QCircuit< T , G >  circ1( N , 0 , N-1 ) ;
+  qclab::QCircuit< T32 , G32 >  circ32( N , 0 , N-1 ) ;
+  qclab::QCircuit< T , G >  tmpcirc1( N , 0 , N-1 ) ;
+
+  // outputs of the first timesteps are the stacked timesteps
+  size_t out = imin ;
+  qclab::QCircuit< T , G >  stack( N ) ;
+  for ( size_t i = 0; i < m; i++ ) {
+    std::cout << "* " << printTimestep( i , hx , hy , hz , Jx , Jy , Jz ) ;
+    F::template timestep( dt , (*hx)[i] , (*hy)[i] , (*hz)[i] ,
+                               (*Jx)[i] , (*Jy)[i] , (*Jz)[i] , circ1 ) ;
+    f3c::freeFermion::apply( circ1 , reference ) ;
+    for ( size_t j = 0; j < nbGates; j++ ) {
+      stack.push_back( std::move( circ1[j] ) ) ;
+    }
+    if ( out == i+1 && i+1 <= imax ) {
+      qasm< F >( stage , stack , i , dt , hx , hy , hz , Jx , Jy , Jz ,
+                 filename ) ;
+      out += step ;
+    }
+  }
+
+  // single precision triangle
+  std::printf( "    - compress %i timestep(s) in single precision\n" ,
+               int( m ) ) ;
+  auto triangle32 = compressChunk< F32 >( N , dt , 0 , m ,
+                                          hx , hy , hz , Jx , Jy , Jz ) ;
+  f3c::SquareCircuit< T32 , G32 >  snapshot32( N ) ;
+
+  // last accepted checkpoint: the single precision triangle after timestep
+  // `accepted`, unitary in double precision, from where an escalation is
+  // replayed
+  using C = f3c::TriangleCircuit< T , G > ;
+  auto checkpoint = std::make_unique< C >( f3c::convert< T , G >(
+                                                          triangle32 ) ) ;
+  f3c::normalize( *checkpoint ) ;
+  size_t accepted = m ;
+
+  // double precision triangle after escalation
+  std::unique_ptr< C >  triangle ;
+  f3c::SquareCircuit< T , G >  snapshot( N ) ;
+
+  // merge timesteps
+  R error = 0 ;
+  for ( size_t i = m; i < ntot; i++ ) {
+    std::cout << "* " << printTimestep( i , hx , hy , hz , Jx , Jy , Jz ) ;
+    const bool output = ( out == i+1 && i+1 <= imax ) ;
+    F::template timestep( dt , (*hx)[i] , (*hy)[i] , (*hz)[i] ,
+                               (*Jx)[i] , (*Jy)[i] , (*Jz)[i] , tmpcirc1 ) ;
+    f3c::freeFermion::apply( tmpcirc1 , reference ) ;
+    if ( triangle ) {
+      F::template timestep( dt , (*hx)[i] , (*hy)[i] , (*hz)[i] ,
+                                 (*Jx)[i] , (*Jy)[i] , (*Jz)[i] , circ1 ) ;
+      triangle->mergeLayer( qclab::Side::Right , circ1.begin() ,
+                                                 circ1.end() ) ;
+    } else {
+      F32::template timestep( dt , (*hx)[i] , (*hy)[i] , (*hz)[i] ,
+                                   (*Jx)[i] , (*Jy)[i] , (*Jz)[i] , circ32 ) ;
+      triangle32.mergeLayer( qclab::Side::Right , circ32.begin() ,
+                                                  circ32.end() ) ;
+      // re-unitarize and measure the error in double precision
+      if ( ( i+1-m ) % engine.normalize == 0 || output || i+1 == ntot ) {
+        const R defect = f3c::normalize( triangle32 ) ;
+        auto check = std::make_unique< C >( f3c::convert< T , G >(
+                                                          triangle32 ) ) ;
+        f3c::normalize( *check ) ;              // unitary in double precision
+        error = f3c::freeFermion::nrmF( *check , reference ) ;
+        std::printf( "    - re-unitarize: defect = %.4e , error = %.4e\n" ,
+                     double( defect ) , double( error ) ) ;
+        if ( error > engine.tolerance ) {
+          // replay the timesteps since the last checkpoint in double
+          // precision
+          std::printf( "    - tolerance %.1e exceeded, escalate to double "
+                       "precision from timestep %i\n" , engine.tolerance ,
+                       int( accepted ) ) ;
+          triangle = std::move( checkpoint ) ;
+          for ( size_t k = accepted; k <= i; k++ ) {
+            F::template timestep( dt , (*hx)[k] , (*hy)[k] , (*hz)[k] ,
+                                       (*Jx)[k] , (*Jy)[k] , (*Jz)[k] ,
+                                       circ1 ) ;
+            triangle->mergeLayer( qclab::Side::Right , circ1.begin() ,
+                                                       circ1.end() ) ;
+          }
+        } else {
+          checkpoint = std::move( check ) ;
+          accepted = i+1 ;
+        }
+      }
+    }
+    // output
+    if ( output ) {
+      if ( triangle ) {
+        triangle->snapshotSquare( snapshot ) ;
+        qasm< F >( stage , snapshot , i , dt , hx , hy , hz , Jx , Jy , Jz ,
+                   filename ) ;
+      } else {
+        triangle32.snapshotSquare( snapshot32 ) ;
+        qasm< F32 >( stage , snapshot32 , i , dt , hx , hy , hz ,
+                     Jx , Jy , Jz , filename ) ;
+      }
+      out += step ;
+      if ( debug && triangle ) {
+        std::printf( "  --> nrmF = %.4e\n" ,
+                     f3c::freeFermion::nrmF( *triangle , reference ) ) ;
+      }
+    }
+  }
+
+  // error of the final triangle
+  if ( triangle ) error = f3c::freeFermion::nrmF( *triangle , reference ) ;
+  std::cout << std::endl ;
+  std::printf( "  error = %.4e (%s precision)\n\n" , double( error ) ,
+               triangle ? "escalated to double" : "single" ) ;
+
+  // wait for the output stage
+  stage.finish() ;
+
+  // successful
+  return 0 ;
+
+}
+
+
 template <typename F, typename P = f3c::Param< double >>
-int timeEvolution( const int N , const int ntot , const double dt ,
-                   const int imin , const int imax , const int step ,
+int timeEvolution( const int nbQubits , const size_t ntot , const double dt ,
+                   const size_t imin , const size_t imax , const size_t step ,
                    const P* hx , const P* hy , const P* hz ,
                    const P* Jx , const P* Jy , const P* Jz ,
                    const std::string filename = std::string( "out" ) ,
-                   const int debug = 0 ) {
+                   const int debug = 0 ,
+                   const Engine& engine = Engine() ) {
 
   using G = typename F::gate_type ;
   using T = typename F::value_type ;
   using R = qclab::real_t< T > ;
 
+  // exact free-fermion compilation
+  if ( engine.exact ) {
+    return exactEvolution< F >( nbQubits , ntot , dt , imin , imax , step ,
+                                hx , hy , hz , Jx , Jy , Jz ,
+                                filename , debug , engine ) ;
+  }
+
+  // circuit width
+  const int N = wires< F >( nbQubits ) ;
+
+  // single precision with error control
+  if ( engine.mixed && ntot > size_t( (N+1)/2 ) ) {
+    return mixedEvolution< F >( nbQubits , ntot , dt , imin , imax , step ,
+                                hx , hy , hz , Jx , Jy , Jz ,
+                                filename , debug , engine ) ;
+  }
+
+  // output stage
+  OutputStage  stage( filename , engine.writers , engine.queue ,
+                      engine.archive , engine.parameterized ) ;
+
   // quantum circuit
   qclab::QCircuit< T , G >  circuit( N ) ;
-  qclab::QCircuit< T , G >  tmpcircuit( N ) ;
+
+  // single-particle matrix of the reference circuit
+  auto reference = f3c::freeFermion::eye< R >( debug ? 2*nbQubits : 0 ) ;
 
   // 1 timestep circuit
   size_t nbGates1 = N/2 ;
@@ -116,7 +893,7 @@ int timeEvolution( const int N , const int ntot , const double dt ,
 
   // build circuit
   size_t out = imin ;
-  if ( ntot <= N/2 ) {
+  if ( ntot <= size_t( N/2 ) ) {
     // loop over timesteps
     for ( size_t i = 0; i < ntot; i++ ) {
       std::cout << "* " << printTimestep( i , hx , hy , hz , Jx , Jy , Jz ) ;
@@ -127,7 +904,8 @@ int timeEvolution( const int N , const int ntot , const double dt ,
       }
       // output
       if ( out == i+1 && i+1 <= imax ) {
-        qasm< F >( circuit , i , dt , hx , hy , hz , Jx , Jy , Jz , filename ) ;
+        qasm< F >( stage , circuit , i , dt , hx , hy , hz , Jx , Jy , Jz ,
+                   filename ) ;
         out += step ;
       }
     }
@@ -147,9 +925,7 @@ int timeEvolution( const int N , const int ntot , const double dt ,
       if ( debug ) {
         F::template timestep( dt , (*hx)[i] , (*hy)[i] , (*hz)[i] ,
                                    (*Jx)[i] , (*Jy)[i] , (*Jz)[i] , tmpcirc1 ) ;
-        for ( size_t j = 0; j < N-1; j++ ) {
-          tmpcircuit.push_back( std::move( tmpcirc1[j] ) ) ;
-        }
+        f3c::freeFermion::apply( tmpcirc1 , reference ) ;
       }
       // output
       if ( out == i+1 && i+1 <= imax ) {
@@ -158,7 +934,8 @@ int timeEvolution( const int N , const int ntot , const double dt ,
           auto gate = *square[k] ;
           tmpsquare[k] = std::make_unique< decltype( gate ) >( gate ) ;
         }
-        qasm< F >( tmpsquare , i , dt , hx , hy , hz , Jx , Jy , Jz , filename);
+        qasm< F >( stage , tmpsquare , i , dt , hx , hy , hz ,
+                   Jx , Jy , Jz , filename ) ;
         out += step ;
       }
     }
@@ -176,63 +953,149 @@ int timeEvolution( const int N , const int ntot , const double dt ,
       if ( debug ) {
         F::template timestep( dt , (*hx)[i] , (*hy)[i] , (*hz)[i] ,
                                    (*Jx)[i] , (*Jy)[i] , (*Jz)[i] , tmpcirc1 ) ;
-        for ( size_t j = 0; j < N-1; j++ ) {
-          tmpcircuit.push_back( std::move( tmpcirc1[j] ) ) ;
-        }
+        f3c::freeFermion::apply( tmpcirc1 , reference ) ;
       }
     }
     //
     // square --> triangle
     auto triangle = square.toTriangle() ;
+    // reusable square snapshot of the triangle for the outputs
+    f3c::SquareCircuit< T , G >  snapshot( N ) ;
     // odd number of qubits
     if ( N % 2 != 0 ) {
       std::printf( "    - merge layer2\n" ) ;
-      #pragma omp parallel for
-      for ( size_t j = N/2; j < N-1; j++ ) {
-        triangle.merge( qclab::Side::Right , circ1[j] ) ;
-      }
+      triangle.mergeLayer( qclab::Side::Right , circ1.begin() + N/2 ,
+                                                circ1.end() ) ;
       // output
-      if ( out == N/2+1 && N/2+1 <= imax ) {
-        f3c::TriangleCircuit< T , G >  tmptriangle( triangle ) ;
-        circuit = tmptriangle.toSquare() ;
-        qasm< F >( circuit , N/2 , dt , hx , hy , hz , Jx , Jy , Jz , filename);
+      if ( out == size_t( N/2+1 ) && out <= imax ) {
+        triangle.snapshotSquare( snapshot ) ;
+        qasm< F >( stage , snapshot , N/2 , dt , hx , hy , hz ,
+                   Jx , Jy , Jz , filename ) ;
         out += step ;
-        if ( debug ) std::printf( "  --> nrmF = %.4e\n" ,
-                                  qclab::nrmF( circuit , tmpcircuit ) ) ;
+        if ( debug ) {
+          std::printf( "  --> nrmF = %.4e\n" ,
+                       f3c::freeFermion::nrmF( snapshot , reference ) ) ;
+        }
       }
     }
     //
     // merge timesteps
-    for ( int i = (N+1)/2; i < ntot; i++ ) {
-      std::cout << "* " << printTimestep( i , hx , hy , hz , Jx , Jy , Jz ) ;
-      F::template timestep( dt , (*hx)[i] , (*hy)[i] , (*hz)[i] ,
-                                 (*Jx)[i] , (*Jy)[i] , (*Jz)[i] , circ1 ) ;
-      std::printf( "    - merge layer1\n" ) ;
-      #pragma omp parallel for
-      for ( size_t j = 0; j < N/2; j++ ) {
-        triangle.merge( qclab::Side::Right , circ1[j] ) ;
-      }
-      std::printf( "    - merge layer2\n" ) ;
-      #pragma omp parallel for
-      for ( size_t j = N/2; j < N-1; j++ ) {
-        triangle.merge( qclab::Side::Right , circ1[j] ) ;
+    const bool squaring = engine.squaring &&
+                          isConstant( ntot , hx , hy , hz , Jx , Jy , Jz ) ;
+    if ( engine.squaring && !squaring ) {
+      std::printf( "    - parameters not constant, squaring disabled\n" ) ;
+    }
+    if ( squaring || ( engine.chunks > 1 ) ) {
+      // U((N+1)/2 dt) is the base of the powers and the minimal chunk size
+      const size_t m = (N+1)/2 ;
+      const f3c::TriangleCircuit< T , G >  base( triangle ) ;
+      std::unique_ptr< f3c::TriangleCircuit< T , G > >  stride ;
+      size_t strideSize = 0 ;
+      size_t i = m ;
+      while ( i < ntot ) {
+        const bool output = ( out > i ) && ( out <= imax ) && ( out <= ntot ) ;
+        const size_t next = output ? out : ntot ;
+        std::cout << "* timesteps " << i+1 << "-" << next << ": "
+                  << printTimestep( next-1 , hx , hy , hz , Jx , Jy , Jz ) ;
+        // merge powers of the base, the remaining timesteps are merged one
+        // by one
+        size_t k = i ;
+        if ( squaring ) {
+          const size_t q = ( next - i ) / m ;
+          if ( q > 0 ) {
+            if ( strideSize != q ) {
+              strideSize = q ;
+              stride = std::make_unique< f3c::TriangleCircuit< T , G > >(
+                                                          base.power( q ) ) ;
+            }
+            std::printf( "    - merge %i timestep(s) by squaring\n" ,
+                         int( q * m ) ) ;
+            triangle.merge( qclab::Side::Right , *stride ) ;
+            k += q * m ;
+          }
+        } else {
+          // compress chunks in parallel and reduce them in a binary tree
+          const size_t nbChunks = std::min( size_t( engine.chunks ) ,
+                                            ( next - i ) / m ) ;
+          if ( nbChunks > 1 ) {
+            std::printf( "    - merge %i timestep(s) in %i chunks\n" ,
+                         int( next - i ) , int( nbChunks ) ) ;
+            const auto chunked = compressChunks< F >( N , dt , i , next ,
+                                                      nbChunks , hx , hy , hz ,
+                                                      Jx , Jy , Jz ) ;
+            triangle.merge( qclab::Side::Right , chunked ) ;
+            k = next ;
+          }
+        }
+        if ( k < next ) {
+          std::printf( "    - merge %i timestep(s)\n" , int( next - k ) ) ;
+        }
+        for ( ; k < next; k++ ) {
+          F::template timestep( dt , (*hx)[k] , (*hy)[k] , (*hz)[k] ,
+                                     (*Jx)[k] , (*Jy)[k] , (*Jz)[k] , circ1 ) ;
+          triangle.mergeLayer( qclab::Side::Right , circ1.begin() ,
+                                                    circ1.end() ) ;
+        }
+        // debug
+        if ( debug ) {
+          for ( ; i < next; i++ ) {
+            F::template timestep( dt , (*hx)[i] , (*hy)[i] , (*hz)[i] ,
+                                       (*Jx)[i] , (*Jy)[i] , (*Jz)[i] ,
+                                       tmpcirc1 ) ;
+            f3c::freeFermion::apply( tmpcirc1 , reference ) ;
+          }
+        }
+        i = next ;
+        // output
+        if ( output ) {
+          triangle.snapshotSquare( snapshot ) ;
+          qasm< F >( stage , snapshot , i-1 , dt , hx , hy , hz ,
+                     Jx , Jy , Jz , filename ) ;
+          out += step ;
+          if ( debug ) {
+            std::printf( "  --> nrmF = %.4e\n" ,
+                         f3c::freeFermion::nrmF( snapshot , reference ) ) ;
+          }
+        }
       }
-      // debug
-      if ( debug ) {
+    } else {
+      qclab::QCircuit< T , G >  pipeline( N ) ;
+      pipeline.reserve( engine.pipeline * (N-1) ) ;
+      for ( size_t i = (N+1)/2; i < ntot; i++ ) {
+        std::cout << "* " << printTimestep( i , hx , hy , hz , Jx , Jy , Jz ) ;
         F::template timestep( dt , (*hx)[i] , (*hy)[i] , (*hz)[i] ,
-                                   (*Jx)[i] , (*Jy)[i] , (*Jz)[i] , tmpcirc1 ) ;
+                                   (*Jx)[i] , (*Jy)[i] , (*Jz)[i] , circ1 ) ;
         for ( size_t j = 0; j < N-1; j++ ) {
-          tmpcircuit.push_back( std::move( tmpcirc1[j] ) ) ;
+          pipeline.push_back( std::move( circ1[j] ) ) ;
+        }
+        // merge pipelined timesteps before output and at the end
+        const bool output = ( out == i+1 && i+1 <= imax ) ;
+        if ( output || ( i+1 == ntot ) ||
+             ( pipeline.nbGates() >= size_t( engine.pipeline * (N-1) ) ) ) {
+          std::printf( "    - merge %i timestep(s)\n" ,
+                       int( pipeline.nbGates() / (N-1) ) ) ;
+          triangle.mergeLayer( qclab::Side::Right , pipeline.begin() ,
+                                                    pipeline.end() ) ;
+          pipeline.clear() ;
+        }
+        // debug
+        if ( debug ) {
+          F::template timestep( dt , (*hx)[i] , (*hy)[i] , (*hz)[i] ,
+                                     (*Jx)[i] , (*Jy)[i] , (*Jz)[i] ,
+                                     tmpcirc1 ) ;
+          f3c::freeFermion::apply( tmpcirc1 , reference ) ;
+        }
+        // output
+        if ( output ) {
+          triangle.snapshotSquare( snapshot ) ;
+          qasm< F >( stage , snapshot , i , dt , hx , hy , hz ,
+                     Jx , Jy , Jz , filename ) ;
+          out += step ;
+          if ( debug ) {
+            std::printf( "  --> nrmF = %.4e\n" ,
+                         f3c::freeFermion::nrmF( snapshot , reference ) ) ;
+          }
         }
-      }
-      // output
-      if ( out == i+1 && i+1 <= imax ) {
-        f3c::TriangleCircuit< T , G >  tmptriangle( triangle ) ;
-        circuit = tmptriangle.toSquare() ;
-        qasm< F >( circuit , i , dt , hx , hy , hz , Jx , Jy , Jz , filename ) ;
-        out += step ;
-        if ( debug ) std::printf( "  --> nrmF = %.4e\n" ,
-                                  qclab::nrmF( circuit , tmpcircuit ) ) ;
       }
     }
     //
@@ -241,11 +1104,14 @@ int timeEvolution( const int N , const int ntot , const double dt ,
   }
 
   std::cout << std::endl ;
-  if ( debug > 1 ) {
+  if ( debug > 1 && !f3c::is_TFIM_v< G > ) {
     qclab::printMatrix( circuit.matrix() ) ;
     std::cout << std::endl ;
   }
 
+  // wait for the output stage
+  stage.finish() ;
+
   // successful
   return 0 ;
 
@@ -7,6 +7,8 @@ int main( int argc , char *argv[] ) {
   using R = double ;
   using T = std::complex< R > ;
   using F = f3c::qgates::TFXYfunctor< T > ;
+  using FU1 = f3c::qgates::TFXYU1functor< T > ;
+  using FIM = f3c::qgates::TFIMfunctor< T > ;
   using P = f3c::Param< R > ;
   using CV = f3c::ConstValue< R > ;
 
@@ -103,8 +105,30 @@ int main( int argc , char *argv[] ) {
             << "    Jx = " << *Jx << "\n"
             << "    Jy = " << *Jy << "\n\n" ;
 
+  // particle number conserving gates if Jx = Jy for all timesteps
+  bool u1 = true ;
+  for ( int i = 0; i < n; i++ ) u1 = u1 && ( (*Jx)[i] == (*Jy)[i] ) ;
+  if ( u1 ) {
+    std::cout << "  Jx = Jy: particle number conserving gates\n\n" ;
+    return timeEvolution< FU1 , P >( N , n , dt , imin , imax , step ,
+                                     P0 , P0 , hz , Jx , Jy , P0 , name ,
+                                     debug , engine( file ) ) ;
+  }
+
+  // real Givens rotations on the Majorana modes if Jy = 0 for all timesteps,
+  // only on request as their QASM has twice the CNOTs of the TFXY gates
+  bool tfim = engine( file ).tfim ;
+  for ( int i = 0; i < n; i++ ) tfim = tfim && ( (*Jy)[i] == 0 ) ;
+  if ( tfim ) {
+    std::cout << "  Jy = 0: TFIM gates on 2N Majorana modes\n\n" ;
+    return timeEvolution< FIM , P >( N , n , dt , imin , imax , step ,
+                                     P0 , P0 , hz , Jx , P0 , P0 , name ,
+                                     debug , engine( file ) ) ;
+  }
+
   return timeEvolution< F , P >( N , n , dt , imin , imax , step ,
-                                 P0 , P0 , hz , Jx , Jy , P0 , name , debug ) ;
+                                 P0 , P0 , hz , Jx , Jy , P0 , name , debug ,
+                                 engine( file ) ) ;
 
 }
 
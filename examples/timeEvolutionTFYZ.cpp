@@ -104,7 +104,8 @@ int main( int argc , char *argv[] ) {
             << "    Jz = " << *Jz << "\n\n" ;
 
   return timeEvolution< F , P >( N , n , dt , imin , imax , step ,
-                                 hx , P0 , P0 , P0 , Jy , Jz , name , debug ) ;
+                                 hx , P0 , P0 , P0 , Jy , Jz , name , debug ,
+                                 engine( file ) ) ;
 
 }
 
@@ -98,7 +98,8 @@ int main( int argc , char *argv[] ) {
             << "    Jy = " << *Jy << "\n\n" ;
 
   return timeEvolution< F , P >( N , n , dt , imin , imax , step ,
-                                 P0 , P0 , P0 , Jx , Jy , P0 , name , debug ) ;
+                                 P0 , P0 , P0 , Jx , Jy , P0 , name , debug ,
+                                 engine( file ) ) ;
 
 }
 
@@ -98,7 +98,8 @@ int main( int argc , char *argv[] ) {
             << "    Jz = " << *Jz << "\n\n" ;
 
   return timeEvolution< F , P >( N , n , dt , imin , imax , step ,
-                                 P0 , P0 , P0 , P0 , Jy , Jz , name , debug ) ;
+                                 P0 , P0 , P0 , P0 , Jy , Jz , name , debug ,
+                                 engine( file ) ) ;
 
 }
 
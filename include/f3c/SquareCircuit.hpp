@@ -63,8 +63,14 @@ namespace f3c {
         }
       } // SquareCircuit(circuit)
 
-      /// Converts this square quantum circuit into a triangle quantum circuit.
-      TriangleCircuit< T , G > toTriangle() {
+      /**
+       * \brief Converts this square quantum circuit into a triangle quantum
+       *        circuit.
+       *
+       * The gates are copied on `nbThreads` threads, or on the default number
+       * of OpenMP threads if `nbThreads` is 0.
+       */
+      TriangleCircuit< T , G > toTriangle( const int nbThreads = 0 ) {
         const auto n = this->nbQubits() ;
         TriangleCircuit< T , G >  triangle( n ) ;
         auto& gates = this->gates_ ;
@@ -75,12 +81,12 @@ namespace f3c {
           const size_type stride = n/2 - 1 ;
           // copy diagonal
           const size_type last = lastIdx( 0 ) ;
-          #pragma omp parallel for
+          #pragma omp parallel for num_threads( f3c::threads( nbThreads ) )
           for ( size_type i = 0; i < n-1; i++ ) {
             triangle[i] = std::move( gates[ last + i * stride ] ) ;
           }
           // copy subdiagonals
-          #pragma omp parallel for
+          #pragma omp parallel for num_threads( f3c::threads( nbThreads ) )
           for ( int l = 1; l < n-1; l += 2 ) {
             const auto idx = triangle.ascIdx( l , n - 2 ) ;
             const auto last = lastIdx( l + 1 ) ;
@@ -104,7 +110,7 @@ namespace f3c {
           //
           const size_type stride = n/2 ;
           // copy (sub)diagonals
-          #pragma omp parallel for
+          #pragma omp parallel for num_threads( f3c::threads( nbThreads ) )
           for ( int l = 0; l < n-1; l += 2 ) {
             const auto idx = triangle.ascIdx( l , n - 2 ) ;
             const auto last = lastIdx( l + 1 ) ;
@@ -146,16 +152,12 @@ namespace f3c {
       inline void turnovers( const int q , const int nb ,
                              std::unique_ptr< G >& gate1 ,
                              TriangleCircuit< T , G >& triangle ) {
-        std::unique_ptr< G >  gateA ;
-        std::unique_ptr< G >  gateB ;
-        std::unique_ptr< G >  gateC ;
         for ( int l = 0; l < nb; l++ ) {
           const auto idx = triangle.ascIdx( l , q + l + 1 ) ;
-          f3c::turnover( *gate1 , *triangle[ idx ] , *triangle[ idx + 1 ] ,
-                         gateA , gateB , gateC ) ;
-          triangle[ idx     ] = std::move( gateA ) ;
-          triangle[ idx + 1 ] = std::move( gateB ) ;
-          gate1 = std::move( gateC ) ;
+          f3c::turnoverInPlace< true >( *gate1 , *triangle[ idx ] ,
+                                        *triangle[ idx + 1 ] ) ;
+          std::swap( gate1 , triangle[ idx     ] ) ;
+          std::swap( gate1 , triangle[ idx + 1 ] ) ;
         }
       }
 
@@ -6,6 +6,12 @@
 #include "qclab/QCircuit.hpp"
 #include "qclab/qgates/QGate2.hpp"
 #include "f3c/turnover.hpp"
+#include "f3c/turnoverBatch.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <vector>
 
 namespace f3c {
 
@@ -134,89 +140,112 @@ namespace f3c {
        *        quantum circuit.
        */
       void merge( qclab::Side side , std::unique_ptr< G >& gate ) {
+        merge( side , *gate ) ;
+      }
+
+      /**
+       * \brief Merges the gates in the range [`first`,`last`) on side `side`
+       *        with this triangle quantum circuit.
+       *
+       * The result represents the same circuit as merging the gates one by
+       * one in the given order. The turnover chains of the different gates
+       * are executed as a wavefront: every step of a chain is scheduled right
+       * after the last step of a preceding chain that touches the same gates
+       * of this triangle. The steps in one front touch disjoint gates and are
+       * executed in parallel. The schedule only depends on the qubits of the
+       * gates, so the result is independent of the number of threads.
+       *
+       * For two-axes, TFIM and TFXY matrix gates, the steps of a front are
+       * computed in batches of SIMD lanes with turnoverBatch. These kernels
+       * round differently from the scalar turnovers of merge, so the result
+       * is not bitwise identical to merging the gates one by one. The
+       * Frobenius norm of the difference between both circuits is bounded by
+       * a small multiple of n^2 eps per merged timestep, with n the number of
+       * qubits and eps the machine precision. For the other gate types, the
+       * result equals merging the gates one by one.
+       *
+       * A range with the gates of several consecutive timesteps is merged as
+       * a pipeline: the chains of a later timestep start as soon as the
+       * chains of the earlier timesteps have moved past the gates they need.
+       *
+       * The iterators dereference to `std::unique_ptr< G >`, e.g., iterators
+       * of a `qclab::QCircuit< T , G >`. The travelling gates are copied to
+       * local storage, the gates in the range are not modified. The wavefront
+       * runs on `nbThreads` threads, or on the default number of OpenMP
+       * threads if `nbThreads` is 0.
+       */
+      template <typename Iterator>
+      void mergeLayer( qclab::Side side , Iterator first , Iterator last ,
+                       const int nbThreads = 0 ) {
         const int n = this->nbQubits() ;
-        assert( gate->qubits()[0] < n - 1 ) ;
-        assert( gate->qubits()[1] < n ) ;
-        const int qubit = gate->qubit() ;
-        auto& gates = this->gates_ ;
-        std::unique_ptr< G >  gateA ;
-        std::unique_ptr< G >  gateB ;
-        std::unique_ptr< G >  gateC ;
-        if ( ascend() ) {
-          //
-          // ascending
-          //
-          if ( side == qclab::Side::Left ) {
-            // left
-            int layer = 0 ;
-            for ( int q = qubit; q < n-2 ; q++ ) {
-              // turnovers
-              const auto idx2 = ascIdx( layer , q + 1 ) ;
-              const auto idx3 = ascIdx( layer , q     ) ;
-              f3c::turnover( *gate , *gates[idx2] , *gates[idx3] ,
-                             gateA , gateB , gateC ) ;
-              gates[idx2] = std::move( gateA ) ;
-              gates[idx3] = std::move( gateB ) ;
-              gate = std::move( gateC ) ;
-              layer++ ;
-            }
-            // fuse
-            const auto idx = ascIdx( layer , n - 2 ) ;
-            gates[idx] = std::make_unique< G >( (*gate) * (*gates[idx]) ) ;
-          } else {
-            // right
-            const int layer = qubit ;
-            for ( int q = qubit; q < n-2 ; q++ ) {
-              // turnovers
-              const auto idx1 = ascIdx( layer     , q     ) ;
-              const auto idx2 = ascIdx( layer + 1 , q + 1 ) ;
-              f3c::turnover( *gates[idx1] , *gates[idx2] , *gate ,
-                             gateA , gateB , gateC ) ;
-              gate = std::move( gateA ) ;
-              gates[idx1] = std::move( gateB ) ;
-              gates[idx2] = std::move( gateC ) ;
+        // chains, merging an identity is a no-op
+        std::vector< G >  chains ;
+        std::vector< int >  qubits ;
+        chains.reserve( std::distance( first , last ) ) ;
+        qubits.reserve( chains.capacity() ) ;
+        int nbSteps = 0 ;
+        for ( ; first != last; ++first ) {
+          assert( f3c::qubitPair( **first )[0] < n - 1 ) ;
+          assert( f3c::qubitPair( **first )[1] < n ) ;
+          if ( f3c::isIdentity( **first ) ) continue ;
+          chains.push_back( **first ) ;
+          qubits.push_back( (*first)->qubit() ) ;
+          nbSteps += n - qubits.back() - 1 ;
+        }
+        const int nbChains = chains.size() ;
+        if ( nbChains == 0 ) return ;
+        // schedule, `front` holds the last front that touched each gate
+        std::vector< int >  times( nbSteps ) ;
+        std::vector< int >  front( this->nbGates() , -1 ) ;
+        int nbFronts = 0 ;
+        int k = 0 ;
+        for ( int j = 0; j < nbChains; j++ ) {
+          const int nb = n - qubits[j] - 2 ;
+          int t = -1 ;
+          for ( int step = 0; step <= nb; step++ ) {
+            size_type idx1 = 0 , idx2 = 0 ;
+            chainIdx( side , qubits[j] , step , idx1 , idx2 ) ;
+            t = std::max( t , front[idx1] ) ;
+            if ( step < nb ) t = std::max( t , front[idx2] ) ;
+            t++ ;
+            front[idx1] = t ;
+            if ( step < nb ) front[idx2] = t ;
+            times[k++] = t ;
+          }
+          nbFronts = std::max( nbFronts , t + 1 ) ;
+        }
+        // sort steps by front
+        std::vector< int >  offsets( nbFronts + 1 , 0 ) ;
+        for ( int i = 0; i < nbSteps; i++ ) offsets[ times[i] + 1 ]++ ;
+        for ( int t = 0; t < nbFronts; t++ ) offsets[t+1] += offsets[t] ;
+        std::vector< std::pair< int , int > >  steps( nbSteps ) ;
+        {
+          std::vector< int >  pos( offsets.begin() , offsets.end() - 1 ) ;
+          k = 0 ;
+          for ( int j = 0; j < nbChains; j++ ) {
+            for ( int step = 0; step <= n - qubits[j] - 2; step++ ) {
+              steps[ pos[ times[k++] ]++ ] = { j , step } ;
             }
-            // fuse
-            const auto idx = ascIdx( layer , n - 2 ) ;
-            *gates[idx] *= *gate ;
           }
-        } else {
-          //
-          // descending
-          //
-          if ( side == qclab::Side::Left ) {
-            // left
-            const int layer = n - qubit - 2 ;
-            for ( int q = qubit; q < n-2 ; q++ ) {
-              // turnovers
-              const auto idx2 = desIdx( layer - 1 , q + 1 ) ;
-              const auto idx3 = desIdx( layer     , q     ) ;
-              f3c::turnover( *gate , *gates[idx2] , *gates[idx3] ,
-                             gateA , gateB , gateC ) ;
-              gates[idx2] = std::move( gateA ) ;
-              gates[idx3] = std::move( gateB ) ;
-              gate = std::move( gateC ) ;
+        }
+        // wavefront
+        #pragma omp parallel num_threads( f3c::threads( nbThreads ) )
+        for ( int t = 0; t < nbFronts; t++ ) {
+          if constexpr ( f3c::is_two_axes_v< G > || f3c::is_TFIM_v< G > ||
+                         f3c::is_TFXY_matrix_v< G > ) {
+            // batches of turnovers in SIMD lanes
+            constexpr int batch = 64 ;
+            #pragma omp for schedule(static)
+            for ( int i = offsets[t]; i < offsets[t+1]; i += batch ) {
+              mergeSteps( side , std::min( batch , offsets[t+1] - i ) ,
+                          &steps[i] , qubits.data() , chains.data() ) ;
             }
-            // fuse
-            const auto idx = desIdx( layer , n - 2 ) ;
-            gates[idx] = std::make_unique< G >( (*gate) * (*gates[idx]) ) ;
           } else {
-            // right
-            int layer = n - 2 ;
-            for ( int q = qubit; q < n-2 ; q++ ) {
-              // turnovers
-              const auto idx1 = desIdx( layer , q     ) ;
-              const auto idx2 = desIdx( layer , q + 1 ) ;
-              f3c::turnover( *gates[idx1] , *gates[idx2] , *gate ,
-                             gateA , gateB , gateC ) ;
-              gate = std::move( gateA ) ;
-              gates[idx1] = std::move( gateB ) ;
-              gates[idx2] = std::move( gateC ) ;
-              layer-- ;
+            #pragma omp for schedule(static)
+            for ( int i = offsets[t]; i < offsets[t+1]; i++ ) {
+              const auto [ j , step ] = steps[i] ;
+              mergeStep( side , qubits[j] , step , chains[j] ) ;
             }
-            // fuse
-            const auto idx = desIdx( layer , n - 2 ) ;
-            *gates[idx] *= *gate ;
           }
         }
       }
@@ -226,8 +255,88 @@ namespace f3c {
        *        quantum circuit.
        */
       void merge( qclab::Side side , const G& gate ) {
-        std::unique_ptr< G >  p = std::make_unique< G >( gate ) ;
-        merge( side , p ) ;
+        const int n = this->nbQubits() ;
+        assert( f3c::qubitPair( gate )[0] < n - 1 ) ;
+        assert( f3c::qubitPair( gate )[1] < n ) ;
+        if ( f3c::isIdentity( gate ) ) return ;
+        mergeChain( side , gate.qubit() , gate ) ;
+      }
+
+      /**
+       * \brief Merges the given triangle quantum circuit `triangle` on side
+       *        `side` with this triangle quantum circuit.
+       *
+       * On the right side, the result is the circuit with the gates of this
+       * triangle followed by the gates of `triangle`, on the left side vice
+       * versa. The n(n-1)/2 gates of `triangle` are merged as one wavefront
+       * with mergeLayer on `nbThreads` threads, or on the default number of
+       * OpenMP threads if `nbThreads` is 0.
+       */
+      void merge( qclab::Side side ,
+                  const TriangleCircuit< T , G >& triangle ,
+                  const int nbThreads = 0 ) {
+        assert( triangle.nbQubits() == this->nbQubits() ) ;
+        const auto nbGates = triangle.nbGates() ;
+        vector_type gates( nbGates ) ;
+        #pragma omp parallel for num_threads( f3c::threads( nbThreads ) )
+        for ( size_type c = 0; c < nbGates; c++ ) {
+          gates[c] = std::make_unique< G >( *triangle[c] ) ;
+        }
+        if ( side == qclab::Side::Right ) {
+          mergeLayer( side , gates.begin() , gates.end() , nbThreads ) ;
+        } else {
+          mergeLayer( side , gates.rbegin() , gates.rend() , nbThreads ) ;
+        }
+      }
+
+      /**
+       * \brief Returns the triangle quantum circuit that equals `exponent`
+       *        repetitions of this triangle quantum circuit.
+       *
+       * The power is computed by repeated squaring, i.e., with
+       * O(log(exponent)) triangle compositions. The identity triangle is only
+       * used for a zero `exponent`, all other powers are composed from copies
+       * of this triangle.
+       */
+      TriangleCircuit< T , G > power( size_t exponent ) const {
+        if ( exponent == 0 ) return identity( this->nbQubits() , ascend_ ) ;
+        TriangleCircuit< T , G >  square( *this ) ;
+        while ( ( exponent & 1 ) == 0 ) {
+          const TriangleCircuit< T , G >  tmp( square ) ;
+          square.merge( qclab::Side::Right , tmp ) ;
+          exponent >>= 1 ;
+        }
+        TriangleCircuit< T , G >  result( square ) ;
+        exponent >>= 1 ;
+        while ( exponent > 0 ) {
+          const TriangleCircuit< T , G >  tmp( square ) ;
+          square.merge( qclab::Side::Right , tmp ) ;
+          if ( exponent & 1 ) result.merge( qclab::Side::Right , square ) ;
+          exponent >>= 1 ;
+        }
+        return result ;
+      }
+
+      /**
+       * \brief Returns the identity triangle quantum circuit of `nbQubits`.
+       *
+       * The gates are default constructed gates of type `G`, which represent
+       * the identity for all f3c gate types.
+       */
+      static TriangleCircuit< T , G > identity( const int nbQubits ,
+                                                const bool ascend = true ) {
+        TriangleCircuit< T , G >  triangle( nbQubits ) ;
+        size_type c = 0 ;
+        for ( int l = 0; l < nbQubits-1; l++ ) {
+          for ( int i = 0; i < nbQubits-l-1; i++ ) {
+            const int qubits[2] = { nbQubits-i-2 , nbQubits-i-1 } ;
+            triangle[c] = std::make_unique< G >() ;
+            triangle[c]->setQubits( &qubits[0] ) ;
+            c++ ;
+          }
+        }
+        if ( !ascend ) triangle.makeDescend() ;
+        return triangle ;
       }
 
       /// Converts this triangle quantum circuit into a square quantum circuit.
@@ -294,6 +403,132 @@ namespace f3c {
         return square ;
       }
 
+      /**
+       * \brief Stores the square form of this triangle quantum circuit in
+       *        `square` without modifying this triangle.
+       *
+       * Every gate of this triangle is copied by value into the position of
+       * `square` where it ends up in `toSquare`, and the turnovers are applied
+       * to the gates of `square`. Gates that are already allocated in `square`
+       * are overwritten, such that repeated snapshots into the same square
+       * circuit do not allocate memory. The turnover chains are split once
+       * over the threads and executed as a wavefront: a chain enters a layer
+       * as soon as the preceding chain has left it, such that concurrent
+       * turnovers act on different layers. The copies and the turnovers are
+       * separated by a single barrier.
+       */
+      void snapshotSquare( SquareCircuit< T , G >& square ) const {
+        const int n = this->nbQubits() ;
+        assert( square.nbQubits() == n ) ;
+        assert( square.nbGates() == this->nbGates() ) ;
+        const auto& gates = this->gates_ ;
+        auto asc = [n]( const int layer , const int qubit ) -> size_type {
+          return ( layer * ( 2*n - layer - 1 ) ) / 2 + n - qubit - 2 ;
+        } ;
+        //
+        // positions in square of the gates in ascending order
+        std::vector< size_type >  pos( this->nbGates() ) ;
+        const size_type stride = n/2 - ( n % 2 == 0 ) ;
+        if ( n % 2 == 0 ) {
+          // turnovers
+          for ( int i = 0; i < n/2 - 1; i++ ) {
+            const auto first = asc( n - 2*i - 2 , n - 2 ) ;
+            for ( int j = 0; j <= 2*i; j++ ) pos[ first + j ] = i + j * stride ;
+          }
+          // diagonal
+          const size_type last = square.lastIdx( 0 ) ;
+          for ( int i = 0; i < n-1; i++ ) pos[i] = last + i * stride ;
+          // subdiagonals
+          for ( int l = 1; l < n-1; l += 2 ) {
+            const auto idx = asc( l , n - 2 ) ;
+            const auto last = square.lastIdx( l + 1 ) ;
+            for ( int i = 0; i < n-l-1; i++ ) {
+              pos[ idx + i ] = last + i * stride ;
+            }
+          }
+        } else {
+          // turnovers
+          for ( int i = 0; i < n/2; i++ ) {
+            const auto first = asc( n - 2*i - 2 , n - 2 ) ;
+            for ( int j = 0; j <= 2*i; j++ ) {
+              const auto offset = j/2 * stride + ( j + 1 )/2 * ( stride - 1 ) ;
+              pos[ first + j ] = i + offset ;
+            }
+          }
+          // (sub)diagonals
+          for ( int l = 0; l < n-1; l += 2 ) {
+            const auto idx = asc( l , n - 2 ) ;
+            const auto last = square.lastIdx( l + 1 ) ;
+            for ( int i = 0; i < n-l-1; i++ ) {
+              const auto offset = ( i + 1 )/2 * stride + i/2 * ( stride - 1 ) ;
+              pos[ idx + i ] = last + offset ;
+            }
+          }
+        }
+        //
+        // turnover chains in the order of `toSquare`: chain c moves the gate
+        // at index j of layer l down to layer 0
+        std::vector< int >  chainL , chainJ ;
+        for ( int i = 0; i < ( n - 1 )/2; i++ ) {
+          for ( int j = 0; j <= 2*i; j++ ) {
+            chainL.push_back( n - 2*i - 2 ) ;
+            chainJ.push_back( j ) ;
+          }
+        }
+        const int nbChains = chainL.size() ;
+        // number of layers done per chain
+        std::vector< std::atomic< int > >  done( nbChains ) ;
+        for ( auto& d : done ) d.store( 0 , std::memory_order_relaxed ) ;
+        //
+        // every thread copies its share of the gates and, after the only
+        // barrier, runs whole turnover chains. Chain c only waits for chain
+        // c - 1 to leave a layer before entering it.
+        #pragma omp parallel
+        {
+          //
+          // copy gates
+          #pragma omp for
+          for ( int l = 0; l < n-1; l++ ) {
+            const auto first = asc( l , n - 2 ) ;
+            for ( int i = 0; i < n-l-1; i++ ) {
+              const auto& gate = ascend_ ? gates[ first + i ]
+                                         : gates[ des2asc( l , i ) ] ;
+              auto& dst = square[ pos[ first + i ] ] ;
+              if ( dst ) {
+                *dst = *gate ;
+              } else {
+                dst = std::make_unique< G >( *gate ) ;
+              }
+            }
+          }
+          //
+          // turnovers
+          #pragma omp for schedule(static,1) nowait
+          for ( int c = 0; c < nbChains; c++ ) {
+            const int l = chainL[c] ;
+            const int j = chainJ[c] ;
+            const auto first = asc( l , n - 2 ) ;
+            for ( int k = 0; k < l; k++ ) {
+              if ( c > 0 ) {
+                // chain c - 1 is done with layer l - k - 1
+                const int prev = chainL[c-1] - l + k + 1 ;
+                while ( done[c-1].load( std::memory_order_acquire ) < prev ) {
+                  std::this_thread::yield() ;
+                }
+              }
+              const auto idx = asc( l - k - 1 , n - 2 - j - k ) ;
+              auto& gate1 = square[ pos[ idx     ] ] ;
+              auto& gate2 = square[ pos[ idx + 1 ] ] ;
+              auto& gate3 = square[ pos[ first + j ] ] ;
+              f3c::turnoverInPlace< false >( *gate1 , *gate2 , *gate3 ) ;
+              std::swap( gate3 , gate1 ) ;
+              std::swap( gate1 , gate2 ) ;
+              done[c].store( k + 1 , std::memory_order_release ) ;
+            }
+          }
+        }
+      }
+
       /// Returns the ascending to descending index.
       inline size_type asc2des( const int layer , const int index ) const {
         const auto n = this->nbQubits() ;
@@ -330,19 +565,176 @@ namespace f3c {
       }
 
     private:
+      /**
+       * \brief Returns the linear indices `idx1` and `idx2` of the gates of
+       *        this triangle that are involved in step `step` of merging a
+       *        gate on qubit `qubit` on side `side`.
+       *
+       * The last step, `step` = n - `qubit` - 2, is the fuse that only
+       * involves the gate `idx1`.
+       */
+      inline void chainIdx( const qclab::Side side , const int qubit ,
+                            const int step ,
+                            size_type& idx1 , size_type& idx2 ) const {
+        const int n = this->nbQubits() ;
+        const int q = qubit + step ;
+        const bool fuse = ( q == n - 2 ) ;
+        if ( ascend() ) {
+          if ( side == qclab::Side::Left ) {
+            if ( fuse ) { idx1 = ascIdx( step , n - 2 ) ; return ; }
+            idx1 = ascIdx( step , q + 1 ) ;
+            idx2 = ascIdx( step , q     ) ;
+          } else {
+            if ( fuse ) { idx1 = ascIdx( qubit , n - 2 ) ; return ; }
+            idx1 = ascIdx( qubit     , q     ) ;
+            idx2 = ascIdx( qubit + 1 , q + 1 ) ;
+          }
+        } else {
+          if ( side == qclab::Side::Left ) {
+            const int layer = n - qubit - 2 ;
+            if ( fuse ) { idx1 = desIdx( layer , n - 2 ) ; return ; }
+            idx1 = desIdx( layer - 1 , q + 1 ) ;
+            idx2 = desIdx( layer     , q     ) ;
+          } else {
+            if ( fuse ) { idx1 = desIdx( qubit , n - 2 ) ; return ; }
+            idx1 = desIdx( n - step - 2 , q     ) ;
+            idx2 = desIdx( n - step - 2 , q + 1 ) ;
+          }
+        }
+      }
+
+      /**
+       * \brief Merges the gate `gate`, on qubit `qubit`, on side `side` with
+       *        this triangle as one fused turnover chain.
+       *
+       * The travelling gate is kept in a local copy for the whole chain, the
+       * turnovers write their results directly into the gates of this
+       * triangle, and the gates of the next step are prefetched.
+       */
+      void mergeChain( const qclab::Side side , const int qubit ,
+                       const G& gate ) {
+        const int nb = this->nbQubits() - qubit - 2 ;
+        auto& gates = this->gates_ ;
+        G  travel( gate ) ;
+        size_type idx1 = 0 , idx2 = 0 ;
+        chainIdx( side , qubit , 0 , idx1 , idx2 ) ;
+        for ( int step = 0; step < nb; step++ ) {
+          G& gate1 = *gates[idx1] ;
+          G& gate2 = *gates[idx2] ;
+          chainIdx( side , qubit , step + 1 , idx1 , idx2 ) ;
+          f3c::prefetch( gates[idx1].get() ) ;
+          if ( step + 1 < nb ) f3c::prefetch( gates[idx2].get() ) ;
+          // the gate moves down the chain, hence all turnovers are vees
+          if ( side == qclab::Side::Left ) {
+            f3c::turnover< true >( travel , gate1 , gate2 ,
+                                   gate1 , gate2 , travel ) ;
+          } else {
+            f3c::turnover< true >( gate1 , gate2 , travel ,
+                                   travel , gate1 , gate2 ) ;
+          }
+        }
+        // fuse
+        if ( side == qclab::Side::Left ) {
+          *gates[idx1] = travel * (*gates[idx1]) ;
+        } else {
+          *gates[idx1] *= travel ;
+        }
+      }
+
+      /**
+       * \brief Applies step `step` of merging the gate `gate`, originally on
+       *        qubit `qubit`, on side `side` with this triangle.
+       */
+      inline void mergeStep( const qclab::Side side , const int qubit ,
+                             const int step , G& gate ) {
+        size_type idx1 = 0 , idx2 = 0 ;
+        chainIdx( side , qubit , step , idx1 , idx2 ) ;
+        auto& gates = this->gates_ ;
+        if ( step < this->nbQubits() - qubit - 2 ) {
+          // turnover in place, followed by moving the gates to their slots
+          // (the gate moves down the chain, hence all turnovers are vees)
+          if ( side == qclab::Side::Left ) {
+            f3c::turnoverInPlace< true >( gate , *gates[idx1] ,
+                                          *gates[idx2] ) ;
+            std::swap( gate , *gates[idx1] ) ;
+            std::swap( gate , *gates[idx2] ) ;
+          } else {
+            f3c::turnoverInPlace< true >( *gates[idx1] , *gates[idx2] ,
+                                          gate ) ;
+            std::swap( gate , *gates[idx1] ) ;
+            std::swap( *gates[idx1] , *gates[idx2] ) ;
+          }
+        } else {
+          // fuse
+          if ( side == qclab::Side::Left ) {
+            *gates[idx1] = gate * (*gates[idx1]) ;
+          } else {
+            *gates[idx1] *= gate ;
+          }
+        }
+      }
+
+      /**
+       * \brief Applies the `nb` steps `steps` of merging the gates `chains`,
+       *        originally on qubits `qubits`, on side `side` with this
+       *        triangle.
+       *
+       * The steps touch disjoint gates of this triangle. Their turnovers are
+       * computed as one batch with turnoverBatch.
+       */
+      void mergeSteps( const qclab::Side side , const int nb ,
+                       const std::pair< int , int >* steps ,
+                       const int* qubits , G* chains ) {
+        constexpr int batch = 64 ;
+        assert( nb <= batch ) ;
+        const G*  gates1[batch] ;
+        const G*  gates2[batch] ;
+        const G*  gates3[batch] ;
+        G*  gatesA[batch] ;
+        G*  gatesB[batch] ;
+        G*  gatesC[batch] ;
+        auto& gates = this->gates_ ;
+        int m = 0 ;
+        for ( int i = 0; i < nb; i++ ) {
+          const auto [ j , step ] = steps[i] ;
+          if ( step == this->nbQubits() - qubits[j] - 2 ) {
+            // fuse
+            mergeStep( side , qubits[j] , step , chains[j] ) ;
+            continue ;
+          }
+          size_type idx1 = 0 , idx2 = 0 ;
+          chainIdx( side , qubits[j] , step , idx1 , idx2 ) ;
+          G* gate = &chains[j] ;
+          if ( side == qclab::Side::Left ) {
+            gates1[m] = gate ;
+            gates2[m] = gates[idx1].get() ;
+            gates3[m] = gates[idx2].get() ;
+            gatesA[m] = gates[idx1].get() ;
+            gatesB[m] = gates[idx2].get() ;
+            gatesC[m] = gate ;
+          } else {
+            gates1[m] = gates[idx1].get() ;
+            gates2[m] = gates[idx2].get() ;
+            gates3[m] = gate ;
+            gatesA[m] = gate ;
+            gatesB[m] = gates[idx1].get() ;
+            gatesC[m] = gates[idx2].get() ;
+          }
+          m++ ;
+        }
+        f3c::turnoverBatch( m , gates1 , gates2 , gates3 ,
+                            gatesA , gatesB , gatesC ) ;
+      }
+
       inline void turnovers( const int l , const int q ,
                              std::unique_ptr< G >& gate3 ) {
-        std::unique_ptr< G >  gateA ;
-        std::unique_ptr< G >  gateB ;
-        std::unique_ptr< G >  gateC ;
         auto& gates = this->gates_ ;
         for ( int k = 0; k < l; k++ ) {
           const auto idx = ascIdx( l - k - 1 , q - k ) ;
-          f3c::turnover( *gates[idx] , *gates[idx+1] , *gate3 ,
-                         gateA , gateB , gateC ) ;
-          gate3 = std::move( gateA ) ;
-          gates[ idx     ] = std::move( gateB ) ;
-          gates[ idx + 1 ] = std::move( gateC ) ;
+          f3c::turnoverInPlace< false >( *gates[idx] , *gates[idx+1] ,
+                                         *gate3 ) ;
+          std::swap( gate3 , gates[ idx ] ) ;
+          std::swap( gates[ idx ] , gates[ idx + 1 ] ) ;
         }
       }
 
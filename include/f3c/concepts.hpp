@@ -15,7 +15,12 @@
 #include "f3c/qgates/RotationTFXY.hpp"
 #include "f3c/qgates/RotationTFXZ.hpp"
 #include "f3c/qgates/RotationTFYZ.hpp"
+#include "f3c/qgates/RotationTFXYMatrix.hpp"
+#include "f3c/qgates/RotationTFXYU1Matrix.hpp"
+#include "f3c/qgates/RotationTFIM.hpp"
+#include <array>
 #include <type_traits>
+#include <utility>
 //#include <concepts> // TODO: c++20
 
 namespace f3c {
@@ -242,7 +247,122 @@ namespace f3c {
 //  template <class T>
 //  concept TFTwoAxesTurnoverable = is_TF_two_axes_v< T > ;
 
+
+  /// Default helper class for is_TFXY_matrix.
+  template <typename T>
+  struct is_TFXY_matrix_helper
+  : std::false_type { } ;
+
+  /// Template specialized helper class for is_TFXY_matrix.
+  template <typename T>
+  struct is_TFXY_matrix_helper< f3c::qgates::RotationTFXYMatrix< T > >
+  : std::true_type { } ;
+
+  /// Returns type of is_TFXY_matrix.
+  template <typename T>
+  struct is_TFXY_matrix
+  : is_TFXY_matrix_helper< T >::type { } ;
+
+  /// Checks if T is a TFXY-rotation matrix gate.
+  template <typename T>
+  inline constexpr bool is_TFXY_matrix_v = is_TFXY_matrix< T >::value ;
+
+  /// Default helper class for is_TFXY_U1_matrix.
+  template <typename T>
+  struct is_TFXY_U1_matrix_helper
+  : std::false_type { } ;
+
+  /// Template specialized helper class for is_TFXY_U1_matrix.
+  template <typename T>
+  struct is_TFXY_U1_matrix_helper< f3c::qgates::RotationTFXYU1Matrix< T > >
+  : std::true_type { } ;
+
+  /// Returns type of is_TFXY_U1_matrix.
+  template <typename T>
+  struct is_TFXY_U1_matrix
+  : is_TFXY_U1_matrix_helper< T >::type { } ;
+
+  /// Checks if T is a TFXY-U(1)-rotation matrix gate.
+  template <typename T>
+  inline constexpr bool is_TFXY_U1_matrix_v = is_TFXY_U1_matrix< T >::value ;
+
+  /// Default helper class for is_TFIM.
+  template <typename T>
+  struct is_TFIM_helper
+  : std::false_type { } ;
+
+  /// Template specialized helper class for is_TFIM.
+  template <typename T>
+  struct is_TFIM_helper< f3c::qgates::RotationTFIM< T > >
+  : std::true_type { } ;
+
+  /// Returns type of is_TFIM.
+  template <typename T>
+  struct is_TFIM
+  : is_TFIM_helper< T >::type { } ;
+
+  /// Checks if T is a TFIM-rotation gate on 2 Majorana modes.
+  template <typename T>
+  inline constexpr bool is_TFIM_v = is_TFIM< T >::value ;
+
+  /// Default helper class for has_qubitPair.
+  template <typename T, typename = void>
+  struct has_qubitPair
+  : std::false_type { } ;
+
+  /// Template specialized helper class for has_qubitPair.
+  template <typename T>
+  struct has_qubitPair< T ,
+           std::void_t< decltype( std::declval< const T& >().qubitPair() ) > >
+  : std::true_type { } ;
+
+  /// Checks if T is a 2-qubit gate with a non-allocating qubitPair().
+  template <typename T>
+  inline constexpr bool has_qubitPair_v = has_qubitPair< T >::value ;
+
+  /**
+   * \brief Returns the qubits of the 2-qubit gate `gate` in ascending order.
+   *
+   * Gates with qubitPair() return their qubits without allocating, all other
+   * gates fall back on qubits().
+   */
+  template <typename G>
+  inline std::array< int , 2 > qubitPair( const G& gate ) {
+    if constexpr ( has_qubitPair_v< G > ) {
+      return gate.qubitPair() ;
+    } else {
+      const auto qubits = gate.qubits() ;
+      return { qubits[0] , qubits[1] } ;
+    }
+  }
+
+  /**
+   * \brief Checks if the gate `gate` is exactly the identity.
+   *
+   * One axis, two axes, TFXY-rotation matrix, TFXY-U(1)-rotation, and
+   * TFIM-rotation gates are inspected, all other gates are never treated as
+   * the identity.
+   */
+  template <typename G>
+  inline bool isIdentity( const G& gate ) {
+    if constexpr ( is_TFXY_matrix_v< G > ) {
+      using T = typename G::value_type ;
+      return ( gate.a() == T(1) ) && ( gate.b() == T(1) ) &&
+             ( gate.c() == T(0) ) && ( gate.d() == T(0) ) ;
+    } else if constexpr ( is_TFXY_U1_matrix_v< G > ) {
+      using T = typename G::value_type ;
+      return ( gate.a() == T(1) ) && ( gate.b() == T(1) ) &&
+             ( gate.c() == T(0) ) ;
+    } else if constexpr ( is_two_axes_v< G > ) {
+      const auto& [ rot0 , rot1 ] = gate.rotations() ;
+      return ( rot0.cos() == 1 ) && ( rot1.cos() == 1 ) ;
+    } else if constexpr ( is_one_axis_v< G > || is_TFIM_v< G > ) {
+      return gate.rotation().cos() == 1 ;
+    } else {
+      return false ;
+    }
+  }
+
 } // namespace f3c
 
 #endif
-
@@ -0,0 +1,592 @@
+//  (C) Copyright Roel Van Beeumen and Daan Camps 2021.
+
+#ifndef f3c_freeFermion_hpp
+#define f3c_freeFermion_hpp
+
+#include "f3c/util.hpp"
+#include "f3c/concepts.hpp"
+#include "f3c/TriangleCircuit.hpp"
+#include "f3c/qgates/RotationTFXYMatrix.hpp"
+#include <vector>
+
+namespace f3c {
+
+  /**
+   * \brief Single-particle representation of free-fermion circuits.
+   *
+   * The qubits are mapped to 2N Majorana operators by the Jordan-Wigner
+   * transformation,
+   *    \f$\gamma_{2q} = Z_0 \cdots Z_{q-1} X_q\f$ and
+   *    \f$\gamma_{2q+1} = Z_0 \cdots Z_{q-1} Y_q\f$.
+   * A free-fermion unitary U maps every Majorana operator to a linear
+   * combination of Majorana operators,
+   *    \f$U \gamma_b U^\dagger = \sum_a O_{ab} \gamma_a\f$,
+   * with O a real 2N x 2N orthogonal matrix. The map is a group homomorphism
+   * that is 2-to-1: U and -U have the same single-particle matrix O.
+   *
+   * All matrices are stored column-major, as the 2 x 2 matrices in util.hpp.
+   * Gates of the XZ and YZ models use the Jordan-Wigner strings of Y and X
+   * instead, i.e., Y X Z and X Y Z take the roles of X Y Z.
+   * Hamiltonians are expressed in the XY frame: XZ and YZ models are
+   * compiled as XY models with the parameters mapped by their functors.
+   * Circuits of TFIM-rotation gates act directly on the 2N Majorana modes.
+   */
+  namespace freeFermion {
+
+    /// Returns the product C = A * B of two real n x n matrices.
+    template <typename R>
+    std::vector< R > gemm( const int n , const std::vector< R >& A ,
+                                         const std::vector< R >& B ) {
+      std::vector< R >  C( n*n , 0 ) ;
+      #pragma omp parallel for
+      for ( int j = 0; j < n; j++ ) {
+        for ( int k = 0; k < n; k++ ) {
+          const R b = B[k + n*j] ;
+          if ( b == 0 ) continue ;
+          for ( int i = 0; i < n; i++ ) {
+            C[i + n*j] += A[i + n*k] * b ;
+          }
+        }
+      }
+      return C ;
+    }
+
+    /// Returns the n x n identity matrix.
+    template <typename R>
+    std::vector< R > eye( const int n ) {
+      std::vector< R >  I( n*n , 0 ) ;
+      for ( int i = 0; i < n; i++ ) I[i + n*i] = 1 ;
+      return I ;
+    }
+
+    /**
+     * \brief Returns the 2N x 2N generator h of the single-particle matrix
+     *        \f$O(t) = \exp(t h)\f$ of the time evolution
+     *        \f$U(t) = \exp(-i t H)\f$ with the Hamiltonian
+     *        \f$H = \sum_q h Z_q +
+     *               \sum_q ( J_0 X_q X_{q+1} + J_1 Y_q Y_{q+1} )\f$
+     *        on `nbQubits` qubits.
+     */
+    template <typename R>
+    std::vector< R > generator( const int nbQubits ,
+                                const R h , const R J0 , const R J1 ) {
+      const int n = 2*nbQubits ;
+      std::vector< R >  G( n*n , 0 ) ;
+      // exp(-i t c (-i g_a g_b)) has single-particle matrix exp(2 t c E_ab)
+      auto add = [&G,n]( const int a , const int b , const R c ) {
+        G[b + n*a] += 2*c ;
+        G[a + n*b] -= 2*c ;
+      } ;
+      for ( int q = 0; q < nbQubits; q++ ) {
+        add( 2*q , 2*q+1 , h ) ;                  // Z_q = -i g_2q g_2q+1
+      }
+      for ( int q = 0; q < nbQubits-1; q++ ) {
+        add( 2*q+1 , 2*q+2 ,  J0 ) ;              // XX = -i g_2q+1 g_2q+2
+        add( 2*q   , 2*q+3 , -J1 ) ;              // YY =  i g_2q g_2q+3
+      }
+      return G ;
+    }
+
+    /**
+     * \brief Returns the matrix exponential of the real n x n matrix `A`.
+     *
+     * The exponential is computed by scaling and squaring with a truncated
+     * Taylor series.
+     */
+    template <typename R>
+    std::vector< R > expm( const int n , std::vector< R > A ) {
+      // scaling
+      R norm = 0 ;
+      for ( int j = 0; j < n; j++ ) {
+        R sum = 0 ;
+        for ( int i = 0; i < n; i++ ) sum += std::abs( A[i + n*j] ) ;
+        norm = std::max( norm , sum ) ;
+      }
+      int s = 0 ;
+      while ( norm > 0.5 ) {
+        norm /= 2 ;
+        s++ ;
+      }
+      const R scale = std::ldexp( R(1) , -s ) ;
+      for ( auto& a : A ) a *= scale ;
+      // Taylor series
+      auto E = eye< R >( n ) ;
+      auto term = eye< R >( n ) ;
+      for ( int k = 1; k <= 18; k++ ) {
+        term = gemm( n , term , A ) ;
+        for ( auto& t : term ) t /= k ;
+        for ( int i = 0; i < n*n; i++ ) E[i] += term[i] ;
+      }
+      // squaring
+      for ( int k = 0; k < s; k++ ) {
+        E = gemm( n , E , E ) ;
+      }
+      return E ;
+    }
+
+    /**
+     * \brief Returns the Pauli matrices { P1 , P2 , S } of the local Majorana
+     *        operators P1, P2 and the Jordan-Wigner string S of a gate,
+     *        encoded as 0 = X, 1 = Y, 2 = Z.
+     */
+    template <typename G>
+    constexpr std::array< int , 3 > frame() {
+      using T = typename G::value_type ;
+      if constexpr ( std::is_same_v< G , qgates::RotationXZ< T > > ||
+                     std::is_same_v< G , qgates::RotationTFXZ< T > > ) {
+        return { 0 , 2 , 1 } ;
+      } else if constexpr ( std::is_same_v< G , qgates::RotationYZ< T > > ||
+                            std::is_same_v< G , qgates::RotationTFYZ< T > > ) {
+        return { 1 , 2 , 0 } ;
+      } else {
+        return { 0 , 1 , 2 } ;
+      }
+    }
+
+    /**
+     * \brief Returns the 4 x 4 single-particle matrix of a 2-qubit gate of
+     *        one of the XY, XZ, YZ, TFXY, TFXZ, or TFYZ models.
+     */
+    template <typename G>
+    std::array< qclab::real_t< typename G::value_type > , 16 >
+    majorana( const G& gate ) {
+      using T = typename G::value_type ;
+      using R = qclab::real_t< T > ;
+      const T i( 0 , 1 ) ;
+      const std::array< T , 4 >  P[4] = { { 0 , 1 , 1 ,  0 } ,     // X
+                                          { 0 , i , -i , 0 } ,     // Y
+                                          { 1 , 0 , 0 , -1 } ,     // Z
+                                          { 1 , 0 , 0 ,  1 } } ;   // I
+      // local Majorana operators P1 I, P2 I, S P1, S P2
+      constexpr auto f = frame< G >() ;
+      const int ops[4][2] = { { f[0] , 3 } , { f[1] , 3 } ,
+                              { f[2] , f[0] } , { f[2] , f[1] } } ;
+      auto kron = [&P]( const int a , const int b , const int r ,
+                        const int c ) {
+        return P[a][ r/2 + 2*(c/2) ] * P[b][ r%2 + 2*(c%2) ] ;
+      } ;
+      const auto U = gate.matrix() ;
+      // UgU[b] = U * g_b * U^H
+      std::array< std::array< T , 16 > , 4 >  UgU ;
+      for ( int b = 0; b < 4; b++ ) {
+        for ( int r = 0; r < 4; r++ ) {
+          for ( int c = 0; c < 4; c++ ) {
+            T sum = 0 ;
+            for ( int k = 0; k < 4; k++ ) {
+              for ( int l = 0; l < 4; l++ ) {
+                sum += U(r,k) * kron( ops[b][0] , ops[b][1] , k , l ) *
+                       std::conj( U(c,l) ) ;
+              }
+            }
+            UgU[b][r + 4*c] = sum ;
+          }
+        }
+      }
+      // O(a,b) = trace( g_a * U * g_b * U^H ) / 4
+      std::array< R , 16 >  O ;
+      for ( int a = 0; a < 4; a++ ) {
+        for ( int b = 0; b < 4; b++ ) {
+          T trace = 0 ;
+          for ( int r = 0; r < 4; r++ ) {
+            for ( int k = 0; k < 4; k++ ) {
+              trace += kron( ops[a][0] , ops[a][1] , r , k ) * UgU[b][k + 4*r];
+            }
+          }
+          O[a + 4*b] = std::real( trace ) / 4 ;
+        }
+      }
+      return O ;
+    }
+
+    /// Gate type of the quantum circuit type C.
+    template <typename C>
+    using gate_t =
+      std::decay_t< decltype( **std::declval< const C& >().begin() ) > ;
+
+    /**
+     * \brief Returns the number of Majorana modes of a quantum circuit, i.e.,
+     *        2N for a circuit on N qubits and N for a circuit of TFIM-rotation
+     *        gates on N modes.
+     */
+    template <typename C>
+    int nbModes( const C& circuit ) {
+      if constexpr ( f3c::is_TFIM_v< gate_t< C > > ) {
+        return circuit.nbQubits() ;
+      } else {
+        return 2 * circuit.nbQubits() ;
+      }
+    }
+
+    /**
+     * \brief Applies a quantum circuit of 2-qubit gates on nearest neighbor
+     *        qubits to the 2N x 2N single-particle matrix `O`, i.e., `O` is
+     *        overwritten by the single-particle matrix of the circuit times
+     *        `O`.
+     *
+     * Every gate updates 4 rows of `O`, such that the cost is O(N) per gate
+     * and O(N^3) for a square or triangle circuit. TFIM-rotation gates are
+     * real Givens rotations that update 2 rows of `O`.
+     */
+    template <typename C>
+    void apply( const C& circuit ,
+                std::vector< qclab::real_t< typename C::value_type > >& O ) {
+      using R = qclab::real_t< typename C::value_type > ;
+      const int n = nbModes( circuit ) ;
+      assert( O.size() == n*n ) ;
+      if constexpr ( f3c::is_TFIM_v< gate_t< C > > ) {
+        for ( auto it = circuit.begin(); it != circuit.end(); ++it ) {
+          // Givens rotation [c -s; s c] with the full angle theta
+          const auto& rot = (*it)->rotation() ;
+          const R c = rot.cos() * rot.cos() - rot.sin() * rot.sin() ;
+          const R s = 2 * rot.cos() * rot.sin() ;
+          const int k = (*it)->qubitPair()[0] ;
+          for ( int j = 0; j < n; j++ ) {
+            const R a = O[k   + n*j] ;
+            const R b = O[k+1 + n*j] ;
+            O[k   + n*j] = c * a - s * b ;
+            O[k+1 + n*j] = s * a + c * b ;
+          }
+        }
+        return ;
+      }
+      std::array< R , 4 >  row ;
+      for ( auto it = circuit.begin(); it != circuit.end(); ++it ) {
+        const auto B = majorana( **it ) ;
+        const int w = 2 * f3c::qubitPair( **it )[0] ;
+        // O = B * O on rows w, ..., w+3
+        for ( int j = 0; j < n; j++ ) {
+          for ( int r = 0; r < 4; r++ ) {
+            row[r] = 0 ;
+            for ( int k = 0; k < 4; k++ ) row[r] += B[r + 4*k] * O[w+k + n*j];
+          }
+          for ( int r = 0; r < 4; r++ ) O[w+r + n*j] = row[r] ;
+        }
+      }
+    }
+
+    /**
+     * \brief Returns the 2N x 2N single-particle matrix of a quantum circuit of
+     *        2-qubit gates on nearest neighbor qubits.
+     */
+    template <typename C>
+    auto majoranaCircuit( const C& circuit ) {
+      using R = qclab::real_t< typename C::value_type > ;
+      auto O = eye< R >( nbModes( circuit ) ) ;
+      apply( circuit , O ) ;
+      return O ;
+    }
+
+    /**
+     * \brief Returns the Frobenius norm of the difference between the
+     *        single-particle matrices of a quantum circuit and `O`.
+     *
+     * This verifies free-fermion circuits in O(N^3) instead of comparing
+     * 2^N x 2^N unitaries. The norm vanishes if and only if the circuit equals
+     * the unitary of `O` up to a global sign.
+     */
+    template <typename C>
+    auto nrmF( const C& circuit ,
+        const std::vector< qclab::real_t< typename C::value_type > >& O ) {
+      using R = qclab::real_t< typename C::value_type > ;
+      const auto O1 = majoranaCircuit( circuit ) ;
+      assert( O1.size() == O.size() ) ;
+      R nrm = 0 ;
+      for ( size_t i = 0; i < O.size(); i++ ) {
+        nrm += ( O1[i] - O[i] ) * ( O1[i] - O[i] ) ;
+      }
+      return std::sqrt( nrm ) ;
+    }
+
+    /**
+     * \brief Returns the Frobenius norm of the difference between the
+     *        single-particle matrices of 2 quantum circuits.
+     */
+    template <typename C1, typename C2>
+    auto nrmF( const C1& circuit1 , const C2& circuit2 ) {
+      return nrmF( circuit1 , majoranaCircuit( circuit2 ) ) ;
+    }
+
+    /**
+     * \brief Factors the real n x n orthogonal matrix `O` with determinant 1
+     *        into n(n-1)/2 Givens rotations on neighboring indices.
+     *
+     * The rotations are returned in triangle order, i.e., for l = 0, ..., n-2
+     * the indices (n-2,n-1), ..., (l,l+1), as the cosines `c` and sines `s`
+     * of rotation matrices [c -s; s c] with O = G_{last} ... G_1 G_0.
+     */
+    template <typename R>
+    void givensChain( const int n , std::vector< R > O ,
+                      std::vector< R >& c , std::vector< R >& s ) {
+      c.resize( n*(n-1)/2 ) ;
+      s.resize( n*(n-1)/2 ) ;
+      int g = 0 ;
+      for ( int l = 0; l < n-1; l++ ) {
+        for ( int j = n-2; j >= l; j-- ) {
+          // zero O(l,j+1) with columns j and j+1
+          const R x = O[l + n*j] ;
+          const R y = O[l + n*(j+1)] ;
+          const R r = std::hypot( x , y ) ;
+          const R cg = ( r == 0 ) ? R(1) : x / r ;
+          const R sg = ( r == 0 ) ? R(0) : -y / r ;
+          for ( int i = l; i < n; i++ ) {
+            const R a = O[i + n*j] ;
+            const R b = O[i + n*(j+1)] ;
+            O[i + n*j]     = cg * a - sg * b ;
+            O[i + n*(j+1)] = sg * a + cg * b ;
+          }
+          c[g] = cg ;
+          s[g] = sg ;
+          g++ ;
+        }
+      }
+    }
+
+    /**
+     * \brief Computes the values `a`, `b`, `c`, and `d` of the TFXY-rotation
+     *        matrix gate with 4 x 4 single-particle matrix `O`.
+     */
+    template <typename T>
+    void tfxyValues( const std::array< qclab::real_t< T > , 16 >& O ,
+                     T& a , T& b , T& c , T& d ) {
+      using R = qclab::real_t< T > ;
+      std::vector< R >  cg ;
+      std::vector< R >  sg ;
+      givensChain( 4 , std::vector< R >( O.begin() , O.end() ) , cg , sg ) ;
+      const int link[6] = { 2 , 1 , 0 , 2 , 1 , 2 } ;
+      // even block [a -d'; d a'] and odd block [b -c'; c b']
+      a = 1 ; b = 1 ; c = 0 ; d = 0 ;
+      const T i( 0 , 1 ) ;
+      for ( int g = 0; g < 6; g++ ) {
+        // elementary gate with half angle theta/2
+        const R theta = std::atan2( sg[g] , cg[g] ) ;
+        const R ch = std::cos( theta / 2 ) ;
+        const R sh = std::sin( theta / 2 ) ;
+        T ae , de , bo , co ;
+        if ( link[g] == 0 ) {          // Z on the first qubit
+          ae = T( ch , -sh ) ; de = 0 ; bo = T( ch , -sh ) ; co = 0 ;
+        } else if ( link[g] == 1 ) {   // XX
+          ae = ch ; de = -i * sh ; bo = ch ; co = -i * sh ;
+        } else {                       // Z on the second qubit
+          ae = T( ch , -sh ) ; de = 0 ; bo = T( ch , sh ) ; co = 0 ;
+        }
+        // left multiplication
+        const T a1 = ae * a - std::conj( de ) * d ;
+        const T d1 = de * a + std::conj( ae ) * d ;
+        const T b1 = bo * b - std::conj( co ) * c ;
+        const T c1 = co * b + std::conj( bo ) * c ;
+        a = a1 ; b = b1 ; c = c1 ; d = d1 ;
+      }
+    }
+
+    /**
+     * \brief Compiles the free-fermion unitary with 2N x 2N single-particle
+     *        matrix `O` into an ascending triangle quantum circuit of
+     *        N(N-1)/2 gates of type `G` on `nbQubits` = N qubits.
+     *
+     * For TFXY-rotation matrix gates, every gate eliminates 2 rows of `O` on a
+     * window of 4 columns. For TFXY-U(1)-rotation gates, `O` is the real form
+     * of an N x N unitary matrix, which is factored into complex Givens
+     * rotations. For XY, XZ, and YZ-rotation gates, `O` splits in 2
+     * independent chains of N Majorana operators, which are factored into
+     * Givens rotations with the same triangle structure. For TFIM-rotation
+     * gates, the triangle has N(2N-1) gates on the 2N Majorana modes, one for
+     * every Givens rotation of `O`. The result equals the unitary up to a
+     * global sign. The cost is O(N^3).
+     */
+    template <typename T, typename G>
+    TriangleCircuit< T , G > compile(
+        const int nbQubits , const std::vector< qclab::real_t< T > >& O ) {
+      using R = qclab::real_t< T > ;
+      const int N = nbQubits ;
+      const int n = 2*N ;
+      TriangleCircuit< T , G >  triangle( f3c::is_TFIM_v< G > ? n : N ) ;
+      if constexpr ( f3c::is_TFIM_v< G > ) {
+        std::vector< R >  c , s ;
+        givensChain( n , O , c , s ) ;
+        size_t k = 0 ;
+        for ( int l = 0; l < n-1; l++ ) {
+          for ( int j = n-2; j >= l; j-- ) {
+            const R theta = std::atan2( s[k] , c[k] ) ;
+            triangle[k] = std::make_unique< G >( j , j+1 , theta ) ;
+            k++ ;
+          }
+        }
+      } else if constexpr ( f3c::is_two_axes_v< G > ) {
+        // chains A = { 0 , 3 , 4 , 7 , ... } and B = { 1 , 2 , 5 , 6 , ... }
+        std::vector< R >  A( N*N ) ;
+        std::vector< R >  B( N*N ) ;
+        for ( int j = 0; j < N; j++ ) {
+          for ( int i = 0; i < N; i++ ) {
+            A[i + N*j] = O[2*i + i%2     + n*( 2*j + j%2 )] ;
+            B[i + N*j] = O[2*i + 1 - i%2 + n*( 2*j + 1 - j%2 )] ;
+          }
+        }
+        std::vector< R >  cA , sA , cB , sB ;
+        givensChain( N , A , cA , sA ) ;
+        givensChain( N , B , cB , sB ) ;
+        size_t k = 0 ;
+        for ( int l = 0; l < N-1; l++ ) {
+          for ( int j = N-2; j >= l; j-- ) {
+            // link j of chain A is YY for j even and XX for j odd
+            const R thetaA = std::atan2( sA[k] , cA[k] ) ;
+            const R thetaB = std::atan2( sB[k] , cB[k] ) ;
+            const R thetaXX = ( j % 2 == 0 ) ?  thetaB :  thetaA ;
+            const R thetaYY = ( j % 2 == 0 ) ? -thetaA : -thetaB ;
+            triangle[k] = std::make_unique< G >( j , j+1 , thetaXX , thetaYY );
+            k++ ;
+          }
+        }
+      } else if constexpr ( f3c::is_TFXY_U1_matrix_v< G > ) {
+        // particle number conserving: O is the real form of the N x N unitary
+        // matrix W with W(j,k) = O(2j,2k) - i O(2j,2k+1)
+        std::vector< T >  W( N*N ) ;
+        for ( int k = 0; k < N; k++ ) {
+          for ( int j = 0; j < N; j++ ) {
+            W[j + N*k] = T( O[2*j + n*2*k] , -O[2*j + n*(2*k+1)] ) ;
+          }
+        }
+        std::vector< std::array< T , 4 > >  blocks( N*(N-1)/2 ) ;
+        size_t k = 0 ;
+        for ( int l = 0; l < N-1; l++ ) {
+          for ( int q = N-2; q >= l; q-- ) {
+            // zero W(l,q+1) with Q = [conj(x) -y; conj(y) x] / r in SU(2)
+            const T x = W[l + N*q] ;
+            const T y = W[l + N*(q+1)] ;
+            const R r = std::sqrt( std::norm( x ) + std::norm( y ) ) ;
+            std::array< T , 4 >  Q = { 1 , 0 , 0 , 1 } ;
+            if ( r > 0 ) {
+              Q = { std::conj( x ) / r , std::conj( y ) / r , -y / r , x / r } ;
+            }
+            // W(:,q:q+1) = W(:,q:q+1) * Q
+            for ( int i = l; i < N; i++ ) {
+              const T u = W[i + N*q] ;
+              const T v = W[i + N*(q+1)] ;
+              W[i + N*q]     = u * Q[0] + v * Q[1] ;
+              W[i + N*(q+1)] = u * Q[2] + v * Q[3] ;
+            }
+            blocks[k] = Q ;
+            k++ ;
+          }
+        }
+        // absorb the remaining phase of the last mode in the last gate
+        {
+          const T psi = std::conj( W[(N-1) + N*(N-1)] ) ;
+          blocks.back()[2] *= psi ;
+          blocks.back()[3] *= psi ;
+        }
+        // gates with single-particle matrices Q^H
+        k = 0 ;
+        for ( int l = 0; l < N-1; l++ ) {
+          for ( int q = N-2; q >= l; q-- ) {
+            const auto& Q = blocks[k] ;
+            const T a = std::sqrt( Q[0] * Q[3] - Q[1] * Q[2] ) ;
+            const T b = std::conj( a ) * Q[0] ;
+            const T c = a * std::conj( Q[1] ) ;
+            triangle[k] = std::make_unique< G >( q , q+1 , a , b , c ) ;
+            k++ ;
+          }
+        }
+      } else {
+        static_assert( std::is_same_v< G ,
+                                       f3c::qgates::RotationTFXYMatrix< T > > );
+        std::vector< R >  W( O ) ;
+        std::vector< std::array< R , 16 > >  blocks( N*(N-1)/2 ) ;
+        size_t k = 0 ;
+        for ( int l = 0; l < N-1; l++ ) {
+          for ( int q = N-2; q >= l; q-- ) {
+            // Householder QR of the 4 x 2 block W(2l:2l+1,2q:2q+3)^T
+            const int w = 2*q ;
+            std::array< R , 16 >  Q = { 1 , 0 , 0 , 0 , 0 , 1 , 0 , 0 ,
+                                        0 , 0 , 1 , 0 , 0 , 0 , 0 , 1 } ;
+            R X[8] ;
+            int reflections = 0 ;
+            for ( int r = 0; r < 4; r++ ) {
+              X[r]     = W[2*l   + n*(w+r)] ;
+              X[r + 4] = W[2*l+1 + n*(w+r)] ;
+            }
+            for ( int col = 0; col < 2; col++ ) {
+              R v[4] = { 0 , 0 , 0 , 0 } ;
+              R norm = 0 ;
+              for ( int r = col; r < 4; r++ ) {
+                v[r] = X[r + 4*col] ;
+                norm += v[r] * v[r] ;
+              }
+              norm = std::sqrt( norm ) ;
+              if ( norm == 0 ) continue ;
+              v[col] += ( v[col] >= 0 ) ? norm : -norm ;
+              reflections++ ;
+              R vv = 0 ;
+              for ( int r = col; r < 4; r++ ) vv += v[r] * v[r] ;
+              // X = H X and Q = Q H with H = I - 2 v v^T / v^T v
+              for ( int j = 0; j < 2; j++ ) {
+                R dot = 0 ;
+                for ( int r = col; r < 4; r++ ) dot += v[r] * X[r + 4*j] ;
+                for ( int r = col; r < 4; r++ ) X[r + 4*j] -= 2*dot/vv * v[r] ;
+              }
+              for ( int i = 0; i < 4; i++ ) {
+                R dot = 0 ;
+                for ( int r = col; r < 4; r++ ) dot += Q[i + 4*r] * v[r] ;
+                for ( int r = col; r < 4; r++ ) Q[i + 4*r] -= 2*dot/vv * v[r] ;
+              }
+            }
+            // positive diagonal and determinant 1
+            int flips = reflections ;
+            for ( int col = 0; col < 2; col++ ) {
+              if ( X[col + 4*col] < 0 ) {
+                for ( int i = 0; i < 4; i++ ) Q[i + 4*col] = -Q[i + 4*col] ;
+                flips++ ;
+              }
+            }
+            if ( flips % 2 != 0 ) {
+              for ( int i = 0; i < 4; i++ ) Q[i + 12] = -Q[i + 12] ;
+            }
+            // W(:,w:w+3) = W(:,w:w+3) * Q
+            for ( int i = 2*l; i < n; i++ ) {
+              R row[4] ;
+              for ( int c = 0; c < 4; c++ ) {
+                row[c] = 0 ;
+                for ( int r = 0; r < 4; r++ ) row[c] += W[i + n*(w+r)] *
+                                                        Q[r + 4*c] ;
+              }
+              for ( int c = 0; c < 4; c++ ) W[i + n*(w+c)] = row[c] ;
+            }
+            blocks[k] = Q ;
+            k++ ;
+          }
+        }
+        // absorb the remaining Z-rotation on the last qubit in the last gate
+        {
+          auto& Q = blocks.back() ;
+          const R c = W[(n-2) + n*(n-2)] ;
+          const R s = W[(n-1) + n*(n-2)] ;
+          // Q(:,2:3) = Q(:,2:3) * [c -s; s c]^T
+          for ( int i = 0; i < 4; i++ ) {
+            const R x = Q[i + 8] ;
+            const R y = Q[i + 12] ;
+            Q[i + 8]  =  c * x - s * y ;
+            Q[i + 12] =  s * x + c * y ;
+          }
+        }
+        // gates with single-particle matrices Q^T
+        k = 0 ;
+        for ( int l = 0; l < N-1; l++ ) {
+          for ( int q = N-2; q >= l; q-- ) {
+            std::array< R , 16 >  Qt ;
+            for ( int i = 0; i < 4; i++ ) {
+              for ( int j = 0; j < 4; j++ ) Qt[i + 4*j] = blocks[k][j + 4*i] ;
+            }
+            T a , b , c , d ;
+            tfxyValues< T >( Qt , a , b , c , d ) ;
+            triangle[k] = std::make_unique< G >( q , q+1 , a , b , c , d ) ;
+            k++ ;
+          }
+        }
+      }
+      return triangle ;
+    }
+
+  } // namespace freeFermion
+
+} // namespace f3c
+
+#endif
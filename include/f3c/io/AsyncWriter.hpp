@@ -0,0 +1,150 @@
+//  (C) Copyright Roel Van Beeumen and Daan Camps 2021.
+
+#ifndef f3c_io_AsyncWriter_hpp
+#define f3c_io_AsyncWriter_hpp
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace f3c {
+
+  namespace io {
+
+    /**
+     * \class AsyncWriter
+     * \brief Output stage that runs write tasks on background writer threads.
+     *
+     * Tasks are queued in a bounded queue that is consumed by the writer
+     * threads in FIFO order. `push` blocks while the queue is full, such that
+     * a producer that is faster than the writers is slowed down instead of
+     * accumulating an unbounded number of snapshots in memory. Tasks must
+     * only capture immutable data, e.g., a copy of the circuit snapshot, as
+     * they run concurrently with the producer. An asynchronous writer
+     * without writer threads runs every task synchronously in `push`.
+     *
+     * The OpenMP regions of tasks on writer threads, e.g., of `renderQASM`,
+     * run on a single thread, such that the writers do not oversubscribe the
+     * cores used by the producer.
+     */
+    class AsyncWriter
+    {
+
+      public:
+        /// Type of the write tasks.
+        using task_type = std::function< void() > ;
+
+        /**
+         * \brief Constructs an asynchronous writer with `nbThreads` writer
+         *        threads and a queue of at most `capacity` tasks.
+         */
+        AsyncWriter( const int nbThreads = 1 , const size_t capacity = 4 )
+        : capacity_( capacity > 0 ? capacity : 1 )
+        , done_( false )
+        {
+          for ( int i = 0; i < nbThreads; i++ ) {
+            threads_.emplace_back( [this]{ run() ; } ) ;
+          }
+        } // AsyncWriter(nbThreads,capacity)
+
+        AsyncWriter( const AsyncWriter& ) = delete ;
+        AsyncWriter& operator=( const AsyncWriter& ) = delete ;
+
+        /// Destructor, waits for all queued tasks to finish.
+        ~AsyncWriter() { join() ; }
+
+        /// Returns the number of writer threads of this asynchronous writer.
+        int nbThreads() const { return threads_.size() ; }
+
+        /**
+         * \brief Queues the write task `task`, blocks while the queue is
+         *        full. Without writer threads, `task` runs immediately.
+         */
+        void push( task_type task ) {
+          if ( threads_.empty() ) {
+            task() ;
+            return ;
+          }
+          std::unique_lock< std::mutex > lock( mutex_ ) ;
+          notFull_.wait( lock , [this]{ return queue_.size() < capacity_ ; } );
+          queue_.push_back( std::move( task ) ) ;
+          lock.unlock() ;
+          notEmpty_.notify_one() ;
+        }
+
+        /**
+         * \brief Waits for all queued tasks to finish and stops the writer
+         *        threads. Rethrows the first exception thrown by a task.
+         */
+        void finish() {
+          join() ;
+          if ( error_ ) std::rethrow_exception( std::exchange( error_ ,
+                                                               nullptr ) ) ;
+        }
+
+      private:
+        /// Consumes tasks until the queue is empty and the writer is done.
+        void run() {
+#ifdef _OPENMP
+          omp_set_num_threads( 1 ) ;
+#endif
+          while ( true ) {
+            std::unique_lock< std::mutex > lock( mutex_ ) ;
+            notEmpty_.wait( lock , [this]{ return done_ || !queue_.empty() ; });
+            if ( queue_.empty() ) return ;
+            task_type task = std::move( queue_.front() ) ;
+            queue_.pop_front() ;
+            lock.unlock() ;
+            notFull_.notify_one() ;
+            try {
+              task() ;
+            } catch ( ... ) {
+              std::lock_guard< std::mutex > guard( mutex_ ) ;
+              if ( !error_ ) error_ = std::current_exception() ;
+            }
+          }
+        }
+
+        /// Drains the queue and joins the writer threads.
+        void join() {
+          {
+            std::lock_guard< std::mutex > guard( mutex_ ) ;
+            done_ = true ;
+          }
+          notEmpty_.notify_all() ;
+          for ( auto& thread : threads_ ) thread.join() ;
+          threads_.clear() ;
+        }
+
+        /// Maximum number of queued tasks.
+        size_t                    capacity_ ;
+        /// Queued tasks.
+        std::deque< task_type >   queue_ ;
+        /// Mutex that guards the queue.
+        std::mutex                mutex_ ;
+        /// Signals that the queue is not empty or the writer is done.
+        std::condition_variable   notEmpty_ ;
+        /// Signals that the queue is not full.
+        std::condition_variable   notFull_ ;
+        /// Flag that stops the writer threads once the queue is empty.
+        bool                      done_ ;
+        /// First exception thrown by a task.
+        std::exception_ptr        error_ ;
+        /// Writer threads.
+        std::vector< std::thread >  threads_ ;
+
+    } ; // class AsyncWriter
+
+  } // namespace io
+
+} // namespace f3c
+
+#endif
@@ -0,0 +1,350 @@
+//  (C) Copyright Roel Van Beeumen and Daan Camps 2021.
+
+#ifndef f3c_io_QASMArchive_hpp
+#define f3c_io_QASMArchive_hpp
+
+#include "f3c/io/QASMBuffer.hpp"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define F3C_QASM_ARCHIVE_MMAP
+#endif
+
+namespace f3c {
+
+  namespace io {
+
+    /**
+     * \brief Appends the header of a QASM file with the comment `comment` and
+     *        a register of `nbQubits` qubits to `buffer`.
+     */
+    inline void qasmHeader( QASMBuffer& buffer ,
+                            const std::string_view comment ,
+                            const int nbQubits ) {
+      buffer.append( "// Generated by f3c++\n"
+                     "// https://github.com/QuantumComputingLab/f3cpp\n\n"
+                     "// " )
+            .append( comment )
+            .append( "\n\n"
+                     "OPENQASM 2.0;\n"
+                     "include \"qelib1.inc\";\n\n"
+                     "qreg q[" ).append( nbQubits ).append( "];\n" ) ;
+    }
+
+    /**
+     * \brief Layout of a QASM archive.
+     *
+     * A QASM archive stores the QASM of many circuit snapshots in a single
+     * file that is written sequentially:
+     *
+     *    header | record 0 | record 1 | ... | offset table | footer
+     *
+     * The header holds the magic bytes and the format version, every record
+     * holds the timestep, the number of qubits, the comment, and the QASM
+     * gates of one snapshot, the offset table holds the offset and the
+     * timestep of every record, and the footer holds the offset of the
+     * table, the number of records, and the magic bytes. All integers are
+     * stored in the native byte order.
+     */
+    struct QASMArchiveFormat {
+      /// Magic bytes of the header and the footer.
+      static constexpr char magic[8] = { 'F','3','C','Q','A','S','M','\0' } ;
+      /// Format version.
+      static constexpr uint32_t version = 1 ;
+      /// Size of the header: magic, version, and flags.
+      static constexpr size_t headerSize = 16 ;
+      /// Size of a record header: timestep, qubits, comment and QASM size.
+      static constexpr size_t recordSize = 24 ;
+      /// Size of a table entry: offset and timestep.
+      static constexpr size_t entrySize = 16 ;
+      /// Size of the footer: table offset, number of records, and magic.
+      static constexpr size_t footerSize = 24 ;
+    } ;
+
+    /**
+     * \class QASMArchiveWriter
+     * \brief Appends circuit snapshots to a QASM archive.
+     *
+     * Records are appended sequentially to a single buffered stream, the
+     * offset table and the footer are written by `close`. Appending is
+     * thread-safe, such that snapshots can be appended by concurrent writer
+     * threads in any order.
+     */
+    class QASMArchiveWriter
+    {
+
+      public:
+        /// Creates the QASM archive `filename`.
+        QASMArchiveWriter( const std::string& filename )
+        : stream_( filename , std::ios::binary | std::ios::trunc )
+        , offset_( 0 )
+        {
+          if ( !stream_ ) {
+            throw std::runtime_error( "cannot create \"" + filename + "\"" ) ;
+          }
+          char header[ QASMArchiveFormat::headerSize ] = {} ;
+          std::memcpy( header , QASMArchiveFormat::magic , 8 ) ;
+          std::memcpy( header + 8 , &QASMArchiveFormat::version , 4 ) ;
+          write( header , sizeof( header ) ) ;
+        } // QASMArchiveWriter(filename)
+
+        QASMArchiveWriter( const QASMArchiveWriter& ) = delete ;
+        QASMArchiveWriter& operator=( const QASMArchiveWriter& ) = delete ;
+
+        /// Destructor, closes this QASM archive.
+        ~QASMArchiveWriter() {
+          try { close() ; } catch ( ... ) { }
+        }
+
+        /// Returns the number of records of this QASM archive.
+        size_t nbRecords() const {
+          std::lock_guard< std::mutex > guard( mutex_ ) ;
+          return table_.size() / 2 ;
+        }
+
+        /**
+         * \brief Appends the snapshot at timestep `timestep` on `nbQubits`
+         *        qubits with comment `comment` and QASM gates `qasm`.
+         */
+        void append( const uint64_t timestep , const uint32_t nbQubits ,
+                     const std::string_view comment ,
+                     const std::string_view qasm ) {
+          char record[ QASMArchiveFormat::recordSize ] ;
+          const uint32_t commentSize = comment.size() ;
+          const uint64_t qasmSize = qasm.size() ;
+          std::memcpy( record      , &timestep    , 8 ) ;
+          std::memcpy( record + 8  , &nbQubits    , 4 ) ;
+          std::memcpy( record + 12 , &commentSize , 4 ) ;
+          std::memcpy( record + 16 , &qasmSize    , 8 ) ;
+          std::lock_guard< std::mutex > guard( mutex_ ) ;
+          table_.push_back( offset_ ) ;
+          table_.push_back( timestep ) ;
+          write( record , sizeof( record ) ) ;
+          write( comment.data() , comment.size() ) ;
+          write( qasm.data() , qasm.size() ) ;
+        }
+
+        /// Writes the offset table and the footer, and closes this archive.
+        void close() {
+          std::lock_guard< std::mutex > guard( mutex_ ) ;
+          if ( !stream_.is_open() ) return ;
+          const uint64_t tableOffset = offset_ ;
+          const uint64_t nbRecords = table_.size() / 2 ;
+          write( reinterpret_cast< const char* >( table_.data() ) ,
+                 table_.size() * sizeof( uint64_t ) ) ;
+          char footer[ QASMArchiveFormat::footerSize ] ;
+          std::memcpy( footer      , &tableOffset , 8 ) ;
+          std::memcpy( footer + 8  , &nbRecords   , 8 ) ;
+          std::memcpy( footer + 16 , QASMArchiveFormat::magic , 8 ) ;
+          write( footer , sizeof( footer ) ) ;
+          stream_.close() ;
+          if ( !stream_ ) throw std::runtime_error( "cannot write archive" ) ;
+        }
+
+      private:
+        /// Writes `size` bytes of `data` to the archive.
+        void write( const char* data , const size_t size ) {
+          stream_.write( data , size ) ;
+          offset_ += size ;
+        }
+
+        /// Output stream of this QASM archive.
+        std::ofstream            stream_ ;
+        /// Offset of the end of this QASM archive.
+        uint64_t                 offset_ ;
+        /// Offset table: offset and timestep of every record.
+        std::vector< uint64_t >  table_ ;
+        /// Mutex that guards the stream and the table.
+        mutable std::mutex       mutex_ ;
+
+    } ; // class QASMArchiveWriter
+
+    /**
+     * \class QASMArchiveReader
+     * \brief Reads the records of a QASM archive.
+     *
+     * The archive is memory mapped where available and read into memory
+     * otherwise, records are returned as views into the archive.
+     */
+    class QASMArchiveReader
+    {
+
+      public:
+        /// Record of a QASM archive.
+        struct Record {
+          /// Timestep of the snapshot.
+          uint64_t          timestep ;
+          /// Number of qubits of the snapshot.
+          uint32_t          nbQubits ;
+          /// Comment of the snapshot.
+          std::string_view  comment ;
+          /// QASM gates of the snapshot.
+          std::string_view  qasm ;
+        } ;
+
+        /// Opens the QASM archive `filename`.
+        QASMArchiveReader( const std::string& filename ) {
+#ifdef F3C_QASM_ARCHIVE_MMAP
+          const int fd = ::open( filename.c_str() , O_RDONLY ) ;
+          if ( fd < 0 ) {
+            throw std::runtime_error( "cannot open \"" + filename + "\"" ) ;
+          }
+          struct stat info ;
+          if ( ::fstat( fd , &info ) == 0 && info.st_size > 0 ) {
+            size_ = info.st_size ;
+            void* map = ::mmap( nullptr , size_ , PROT_READ , MAP_PRIVATE ,
+                                fd , 0 ) ;
+            if ( map != MAP_FAILED ) data_ = static_cast< const char* >( map );
+          }
+          ::close( fd ) ;
+          if ( !data_ ) {
+            throw std::runtime_error( "cannot map \"" + filename + "\"" ) ;
+          }
+#else
+          std::ifstream stream( filename , std::ios::binary ) ;
+          if ( !stream ) {
+            throw std::runtime_error( "cannot open \"" + filename + "\"" ) ;
+          }
+          buffer_.assign( std::istreambuf_iterator< char >( stream ) ,
+                          std::istreambuf_iterator< char >() ) ;
+          data_ = buffer_.data() ;
+          size_ = buffer_.size() ;
+#endif
+          try {
+            validate( filename ) ;
+          } catch ( ... ) {
+            unmap() ;
+            throw ;
+          }
+        } // QASMArchiveReader(filename)
+
+        QASMArchiveReader( const QASMArchiveReader& ) = delete ;
+        QASMArchiveReader& operator=( const QASMArchiveReader& ) = delete ;
+
+        /// Destructor, unmaps the QASM archive.
+        ~QASMArchiveReader() { unmap() ; }
+
+        /// Returns the number of records of this QASM archive.
+        size_t nbRecords() const { return nbRecords_ ; }
+
+        /// Returns record `k` of this QASM archive.
+        Record record( const size_t k ) const {
+          if ( k >= nbRecords_ ) throw std::out_of_range( "record" ) ;
+          const uint64_t offset = load< uint64_t >( table_ + 16*k ) ;
+          if ( offset < QASMArchiveFormat::headerSize ||
+               offset + QASMArchiveFormat::recordSize > tableOffset_ ) {
+            throw std::runtime_error( "corrupt QASM archive record" ) ;
+          }
+          const char* ptr = data_ + offset ;
+          Record record ;
+          record.timestep = load< uint64_t >( ptr ) ;
+          record.nbQubits = load< uint32_t >( ptr + 8 ) ;
+          const uint32_t commentSize = load< uint32_t >( ptr + 12 ) ;
+          const uint64_t qasmSize = load< uint64_t >( ptr + 16 ) ;
+          const uint64_t available = tableOffset_ - offset -
+                                     QASMArchiveFormat::recordSize ;
+          if ( commentSize > available ||
+               qasmSize > available - commentSize ) {
+            throw std::runtime_error( "corrupt QASM archive record" ) ;
+          }
+          ptr += QASMArchiveFormat::recordSize ;
+          record.comment = std::string_view( ptr , commentSize ) ;
+          record.qasm = std::string_view( ptr + commentSize , qasmSize ) ;
+          return record ;
+        }
+
+        /**
+         * \brief Returns the index of the record of timestep `timestep`, or
+         *        the number of records if there is no such record.
+         */
+        size_t find( const uint64_t timestep ) const {
+          for ( size_t k = 0; k < nbRecords_; k++ ) {
+            if ( load< uint64_t >( table_ + 16*k + 8 ) == timestep ) return k ;
+          }
+          return nbRecords_ ;
+        }
+
+        /// Appends the QASM file of record `k` to `buffer`.
+        void qasm( const size_t k , QASMBuffer& buffer ) const {
+          const Record rec = record( k ) ;
+          qasmHeader( buffer , rec.comment , rec.nbQubits ) ;
+          buffer.append( rec.qasm ) ;
+        }
+
+      private:
+        /// Loads a value of type V from the unaligned address `ptr`.
+        template <typename V>
+        static V load( const char* ptr ) {
+          V value ;
+          std::memcpy( &value , ptr , sizeof( V ) ) ;
+          return value ;
+        }
+
+        /// Unmaps this QASM archive.
+        void unmap() {
+#ifdef F3C_QASM_ARCHIVE_MMAP
+          if ( data_ ) ::munmap( const_cast< char* >( data_ ) , size_ ) ;
+#endif
+          data_ = nullptr ;
+        }
+
+        /// Validates the header, the footer, and the offset table.
+        void validate( const std::string& filename ) {
+          const std::string error = "\"" + filename + "\" is not a valid "
+                                    "QASM archive" ;
+          if ( size_ < QASMArchiveFormat::headerSize +
+                       QASMArchiveFormat::footerSize ||
+               std::memcmp( data_ , QASMArchiveFormat::magic , 8 ) != 0 ||
+               load< uint32_t >( data_ + 8 ) != QASMArchiveFormat::version ) {
+            throw std::runtime_error( error ) ;
+          }
+          const char* footer = data_ + size_ - QASMArchiveFormat::footerSize ;
+          if ( std::memcmp( footer + 16 , QASMArchiveFormat::magic , 8 ) ) {
+            throw std::runtime_error( error + " (not closed)" ) ;
+          }
+          tableOffset_ = load< uint64_t >( footer ) ;
+          nbRecords_ = load< uint64_t >( footer + 8 ) ;
+          const size_t tableEnd = size_ - QASMArchiveFormat::footerSize ;
+          if ( tableOffset_ < QASMArchiveFormat::headerSize ||
+               tableOffset_ > tableEnd ||
+               nbRecords_ != ( tableEnd - tableOffset_ ) /
+                             QASMArchiveFormat::entrySize ||
+               ( tableEnd - tableOffset_ ) % QASMArchiveFormat::entrySize ) {
+            throw std::runtime_error( error ) ;
+          }
+          table_ = data_ + tableOffset_ ;
+        }
+
+        /// Bytes of this QASM archive.
+        const char*          data_ = nullptr ;
+        /// Size of this QASM archive.
+        size_t               size_ = 0 ;
+        /// Offset table of this QASM archive.
+        const char*          table_ = nullptr ;
+        /// Offset of the offset table.
+        uint64_t             tableOffset_ = 0 ;
+        /// Number of records of this QASM archive.
+        size_t               nbRecords_ = 0 ;
+#ifndef F3C_QASM_ARCHIVE_MMAP
+        /// Bytes of this QASM archive if it is not memory mapped.
+        std::vector< char >  buffer_ ;
+#endif
+
+    } ; // class QASMArchiveReader
+
+  } // namespace io
+
+} // namespace f3c
+
+#endif
@@ -0,0 +1,211 @@
+//  (C) Copyright Roel Van Beeumen and Daan Camps 2021.
+
+#ifndef f3c_io_QASMBuffer_hpp
+#define f3c_io_QASMBuffer_hpp
+
+#include <algorithm>
+#include <charconv>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace f3c {
+
+  namespace io {
+
+    /**
+     * \brief Symbolic QASM angle, appended as the input parameter
+     *        `t<index>` of a parameterized QASM circuit.
+     */
+    struct QASMParameter {
+      /// Index of this QASM parameter.
+      size_t index ;
+    } ;
+
+    /// Real type of the constant angles emitted next to angles of type `T`.
+    template <typename T>
+    struct qasm_real_helper { using type = T ; } ;
+
+    /// Constant angles next to symbolic angles are emitted in double.
+    template <>
+    struct qasm_real_helper< QASMParameter > { using type = double ; } ;
+
+    /// Real type of the constant angles emitted next to angles of type `T`.
+    template <typename T>
+    using qasm_real_t = typename qasm_real_helper< T >::type ;
+
+    /**
+     * \class QASMBuffer
+     * \brief Reusable, growable byte buffer for emitting QASM code.
+     *
+     * Angles are formatted with `std::to_chars` in their shortest
+     * representation that round-trips to the same floating point value, and
+     * qubit indices with `std::to_chars` as integers. The buffer keeps its
+     * capacity after `clear`, such that emitting many circuits does not
+     * allocate once the buffer has grown to the size of the largest circuit.
+     */
+    class QASMBuffer
+    {
+
+      public:
+        /// Constructs an empty QASM buffer with the given `capacity`.
+        QASMBuffer( const size_t capacity = 1 << 16 )
+        : buffer_( std::max( capacity , size_t( 64 ) ) )
+        , size_( 0 )
+        { } // QASMBuffer(capacity)
+
+        /// Clears this QASM buffer and keeps its capacity.
+        void clear() { size_ = 0 ; }
+
+        /// Returns the number of bytes in this QASM buffer.
+        size_t size() const { return size_ ; }
+
+        /// Returns the capacity of this QASM buffer.
+        size_t capacity() const { return buffer_.size() ; }
+
+        /// Returns a pointer to the bytes of this QASM buffer.
+        const char* data() const { return buffer_.data() ; }
+
+        /// Returns a view of the bytes of this QASM buffer.
+        std::string_view view() const {
+          return std::string_view( buffer_.data() , size_ ) ;
+        }
+
+        /// Converts this QASM buffer to std::string.
+        std::string str() const { return std::string( view() ) ; }
+
+        /// Writes this QASM buffer to `stream` with a single write.
+        void write( std::ostream& stream ) const {
+          stream.write( buffer_.data() , size_ ) ;
+        }
+
+        /// Appends the string `text` to this QASM buffer.
+        QASMBuffer& append( const std::string_view text ) {
+          char* ptr = reserve( text.size() ) ;
+          std::copy( text.begin() , text.end() , ptr ) ;
+          size_ += text.size() ;
+          return *this ;
+        }
+
+        /// Appends the integer or floating point number `value`.
+        template <typename T,
+                  typename = std::enable_if_t< std::is_arithmetic_v< T > >>
+        QASMBuffer& append( const T value ) {
+          char* ptr = reserve( 32 ) ;
+          const auto result = std::to_chars( ptr , ptr + 32 , value ) ;
+          size_ += result.ptr - ptr ;
+          return *this ;
+        }
+
+        /// Appends the symbolic angle `parameter`.
+        QASMBuffer& append( const QASMParameter parameter ) {
+          return append( "t" ).append( parameter.index ) ;
+        }
+
+        /// Appends a single-qubit gate `name` with angle `theta`.
+        template <typename T>
+        QASMBuffer& gate1( const std::string_view name , const int qubit ,
+                           const T theta ) {
+          append( name ).append( "(" ).append( theta ) ;
+          return append( ") q[" ).append( qubit ).append( "];\n" ) ;
+        }
+
+        /// Appends a rotation about the X-axis on `qubit` with angle `theta`.
+        template <typename T>
+        QASMBuffer& rx( const int qubit , const T theta ) {
+          return gate1( "rx" , qubit , theta ) ;
+        }
+
+        /// Appends a rotation about the Y-axis on `qubit` with angle `theta`.
+        template <typename T>
+        QASMBuffer& ry( const int qubit , const T theta ) {
+          return gate1( "ry" , qubit , theta ) ;
+        }
+
+        /// Appends a rotation about the Z-axis on `qubit` with angle `theta`.
+        template <typename T>
+        QASMBuffer& rz( const int qubit , const T theta ) {
+          return gate1( "rz" , qubit , theta ) ;
+        }
+
+        /// Appends a CNOT gate with qubits `control` and `target`.
+        QASMBuffer& cx( const int control , const int target ) {
+          append( "cx q[" ).append( control ) ;
+          return append( "], q[" ).append( target ).append( "];\n" ) ;
+        }
+
+      private:
+        /// Grows this QASM buffer for `n` more bytes, returns the end.
+        char* reserve( const size_t n ) {
+          if ( size_ + n > buffer_.size() ) {
+            buffer_.resize( std::max( 2 * buffer_.size() , size_ + n ) ) ;
+          }
+          return buffer_.data() + size_ ;
+        }
+
+        /// Bytes of this QASM buffer, its size is the capacity.
+        std::vector< char >  buffer_ ;
+        /// Number of bytes in use.
+        size_t               size_ ;
+
+    } ; // class QASMBuffer
+
+    /// Returns the range buffers of `renderQASM` of the calling thread.
+    inline std::vector< QASMBuffer >& renderBuffers() {
+      static thread_local std::vector< QASMBuffer >  buffers ;
+      return buffers ;
+    }
+
+    /// Returns the number of threads of `renderQASM` on the calling thread.
+    inline int renderThreads() {
+#ifdef _OPENMP
+      return omp_get_max_threads() ;
+#else
+      return 1 ;
+#endif
+    }
+
+    /**
+     * \brief Appends the QASM code of `nbItems` items to `buffer` in order,
+     *        where `render( part , k )` appends the QASM code of item `k` to
+     *        the QASM buffer `part`.
+     *
+     * Disjoint ranges of `grain` items are rendered in parallel into range
+     * buffers that are concatenated in order, such that the result equals
+     * the sequential rendering. The range buffers are reused by subsequent
+     * calls on the same thread. Without OpenMP parallelism, e.g., on the
+     * writer threads of an AsyncWriter, the items are rendered directly into
+     * `buffer`.
+     */
+    template <typename Render>
+    void renderQASM( QASMBuffer& buffer , const size_t nbItems ,
+                     Render render , const size_t grain = 4096 ) {
+      if ( nbItems <= grain || renderThreads() == 1 ) {
+        for ( size_t k = 0; k < nbItems; k++ ) render( buffer , k ) ;
+        return ;
+      }
+      const size_t nbRanges = ( nbItems + grain - 1 ) / grain ;
+      auto& parts = renderBuffers() ;
+      if ( parts.size() < nbRanges ) {
+        parts.resize( nbRanges , QASMBuffer( 0 ) ) ;
+      }
+      #pragma omp parallel for schedule(dynamic)
+      for ( size_t r = 0; r < nbRanges; r++ ) {
+        QASMBuffer& part = parts[r] ;
+        part.clear() ;
+        const size_t last = std::min( ( r + 1 ) * grain , nbItems ) ;
+        for ( size_t k = r * grain; k < last; k++ ) render( part , k ) ;
+      }
+      for ( size_t r = 0; r < nbRanges; r++ ) buffer.append( parts[r].view() ) ;
+    }
+
+  } // namespace io
+
+} // namespace f3c
+
+#endif
@@ -0,0 +1,264 @@
+//  (C) Copyright Roel Van Beeumen and Daan Camps 2021.
+
+#ifndef f3c_io_QASMTemplate_hpp
+#define f3c_io_QASMTemplate_hpp
+
+#include "f3c/io/QASMBuffer.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace f3c {
+
+  namespace io {
+
+    /**
+     * \brief Appends the header of a parameterized OpenQASM 3 file with the
+     *        comment `comment`, `nbParameters` input angles, and a register
+     *        of `nbQubits` qubits to `buffer`.
+     */
+    inline void qasmTemplateHeader( QASMBuffer& buffer ,
+                                    const std::string_view comment ,
+                                    const int nbQubits ,
+                                    const size_t nbParameters ) {
+      buffer.append( "// Generated by f3c++\n"
+                     "// https://github.com/QuantumComputingLab/f3cpp\n\n"
+                     "// " )
+            .append( comment )
+            .append( "\n\n"
+                     "OPENQASM 3.0;\n"
+                     "include \"stdgates.inc\";\n\n" ) ;
+      for ( size_t p = 0; p < nbParameters; p++ ) {
+        buffer.append( "input angle " ).append( QASMParameter{ p } )
+              .append( ";\n" ) ;
+      }
+      buffer.append( "\nqubit[" ).append( nbQubits ).append( "] q;\n" ) ;
+    }
+
+    /**
+     * \brief Appends the gates of `circuit` with symbolic angles to `buffer`.
+     *
+     * Angle `j` of gate `k` of the circuit is the input parameter
+     * `t<k*F::nbAngles + j>`, such that binding the angles of `qasmAngles`
+     * to the parameters reproduces `F::toQASM( circuit , buffer )`.
+     */
+    template <typename F, typename C>
+    void qasmTemplate( const C& circuit , QASMBuffer& buffer ) {
+      constexpr int n = F::nbAngles ;
+      const int offset = circuit.offset() ;
+      renderQASM( buffer , circuit.nbGates() ,
+                  [&]( QASMBuffer& part , const size_t k ) {
+        std::array< QASMParameter , n >  theta ;
+        for ( int j = 0; j < n; j++ ) theta[j] = QASMParameter{ k*n + j } ;
+        F::toQASM( *circuit[k] , theta , offset , part ) ;
+      } ) ;
+    }
+
+    /**
+     * \brief Stores the `circuit.nbGates() * F::nbAngles` angles of the
+     *        gates of `circuit` in `angles`, in the order of the input
+     *        parameters of `qasmTemplate`.
+     */
+    template <typename F, typename C, typename R>
+    void qasmAngles( const C& circuit , R* angles ) {
+      constexpr int n = F::nbAngles ;
+      const int nbGates = circuit.nbGates() ;
+      #pragma omp parallel for
+      for ( int k = 0; k < nbGates; k++ ) {
+        const auto theta = F::angles( *circuit[k] ) ;
+        for ( int j = 0; j < n; j++ ) angles[ k*n + j ] = theta[j] ;
+      }
+    }
+
+    /**
+     * \brief Layout of an angle table.
+     *
+     * An angle table stores the input angles of a parameterized QASM circuit
+     * for many circuit snapshots as a dense binary matrix:
+     *
+     *    header | row 0 | row 1 | ...
+     *
+     * The header holds the magic bytes, the format version, and the number
+     * of parameters P, every row holds the timestep of a snapshot as 64-bit
+     * unsigned integer followed by its P angles as 64-bit floating point
+     * numbers. Rows are appended in the order in which the snapshots are
+     * written. All numbers are stored in the native byte order.
+     */
+    struct AngleTableFormat {
+      /// Magic bytes of the header.
+      static constexpr char magic[8] = { 'F','3','C','A','N','G','L','\0' } ;
+      /// Format version.
+      static constexpr uint32_t version = 1 ;
+      /// Size of the header: magic, version, flags, and parameters.
+      static constexpr size_t headerSize = 24 ;
+
+      /// Returns the size of a row of `nbParameters` angles.
+      static constexpr size_t rowSize( const uint64_t nbParameters ) {
+        return 8 * ( nbParameters + 1 ) ;
+      }
+    } ;
+
+    /**
+     * \class AngleTableWriter
+     * \brief Appends rows of angles to an angle table.
+     *
+     * Appending is thread-safe, such that rows can be appended by concurrent
+     * writer threads in any order.
+     */
+    class AngleTableWriter
+    {
+
+      public:
+        /// Creates the angle table `filename` with `nbParameters` angles.
+        AngleTableWriter( const std::string& filename ,
+                          const uint64_t nbParameters )
+        : stream_( filename , std::ios::binary | std::ios::trunc )
+        , nbParameters_( nbParameters )
+        , nbRows_( 0 )
+        {
+          if ( !stream_ ) {
+            throw std::runtime_error( "cannot create \"" + filename + "\"" ) ;
+          }
+          char header[ AngleTableFormat::headerSize ] = {} ;
+          std::memcpy( header , AngleTableFormat::magic , 8 ) ;
+          std::memcpy( header + 8 , &AngleTableFormat::version , 4 ) ;
+          std::memcpy( header + 16 , &nbParameters_ , 8 ) ;
+          stream_.write( header , sizeof( header ) ) ;
+        } // AngleTableWriter(filename,nbParameters)
+
+        AngleTableWriter( const AngleTableWriter& ) = delete ;
+        AngleTableWriter& operator=( const AngleTableWriter& ) = delete ;
+
+        /// Destructor, closes this angle table.
+        ~AngleTableWriter() {
+          try { close() ; } catch ( ... ) { }
+        }
+
+        /// Returns the number of parameters of this angle table.
+        uint64_t nbParameters() const { return nbParameters_ ; }
+
+        /// Returns the number of rows of this angle table.
+        size_t nbRows() const {
+          std::lock_guard< std::mutex > guard( mutex_ ) ;
+          return nbRows_ ;
+        }
+
+        /// Appends the `nbParameters()` angles of timestep `timestep`.
+        void append( const uint64_t timestep , const double* angles ) {
+          std::lock_guard< std::mutex > guard( mutex_ ) ;
+          stream_.write( reinterpret_cast< const char* >( &timestep ) , 8 ) ;
+          stream_.write( reinterpret_cast< const char* >( angles ) ,
+                         8 * nbParameters_ ) ;
+          nbRows_++ ;
+        }
+
+        /// Closes this angle table.
+        void close() {
+          std::lock_guard< std::mutex > guard( mutex_ ) ;
+          if ( !stream_.is_open() ) return ;
+          stream_.close() ;
+          if ( !stream_ ) throw std::runtime_error( "cannot write table" ) ;
+        }
+
+      private:
+        /// Output stream of this angle table.
+        std::ofstream       stream_ ;
+        /// Number of parameters of this angle table.
+        uint64_t            nbParameters_ ;
+        /// Number of rows of this angle table.
+        size_t              nbRows_ ;
+        /// Mutex that guards the stream.
+        mutable std::mutex  mutex_ ;
+
+    } ; // class AngleTableWriter
+
+    /**
+     * \class AngleTableReader
+     * \brief Reads the rows of an angle table.
+     */
+    class AngleTableReader
+    {
+
+      public:
+        /// Reads the angle table `filename`.
+        AngleTableReader( const std::string& filename ) {
+          std::ifstream stream( filename , std::ios::binary ) ;
+          if ( !stream ) {
+            throw std::runtime_error( "cannot open \"" + filename + "\"" ) ;
+          }
+          buffer_.assign( std::istreambuf_iterator< char >( stream ) ,
+                          std::istreambuf_iterator< char >() ) ;
+          const std::string error = "\"" + filename + "\" is not a valid "
+                                    "angle table" ;
+          if ( buffer_.size() < AngleTableFormat::headerSize ||
+               std::memcmp( buffer_.data() , AngleTableFormat::magic , 8 ) ||
+               load< uint32_t >( 8 ) != AngleTableFormat::version ) {
+            throw std::runtime_error( error ) ;
+          }
+          nbParameters_ = load< uint64_t >( 16 ) ;
+          if ( nbParameters_ > buffer_.size() / 8 ) {
+            throw std::runtime_error( error ) ;
+          }
+          const size_t size = buffer_.size() - AngleTableFormat::headerSize ;
+          const size_t row = AngleTableFormat::rowSize( nbParameters_ ) ;
+          if ( size % row ) throw std::runtime_error( error ) ;
+          nbRows_ = size / row ;
+        } // AngleTableReader(filename)
+
+        /// Returns the number of parameters of this angle table.
+        uint64_t nbParameters() const { return nbParameters_ ; }
+
+        /// Returns the number of rows of this angle table.
+        size_t nbRows() const { return nbRows_ ; }
+
+        /// Returns the timestep of row `r`.
+        uint64_t timestep( const size_t r ) const {
+          if ( r >= nbRows_ ) throw std::out_of_range( "row" ) ;
+          return load< uint64_t >( offset( r ) ) ;
+        }
+
+        /// Returns the angles of row `r`.
+        std::vector< double > angles( const size_t r ) const {
+          if ( r >= nbRows_ ) throw std::out_of_range( "row" ) ;
+          std::vector< double > angles( nbParameters_ ) ;
+          std::memcpy( angles.data() , buffer_.data() + offset( r ) + 8 ,
+                       8 * nbParameters_ ) ;
+          return angles ;
+        }
+
+      private:
+        /// Returns the offset of row `r`.
+        size_t offset( const size_t r ) const {
+          return AngleTableFormat::headerSize +
+                 r * AngleTableFormat::rowSize( nbParameters_ ) ;
+        }
+
+        /// Loads a value of type V at offset `offset`.
+        template <typename V>
+        V load( const size_t offset ) const {
+          V value ;
+          std::memcpy( &value , buffer_.data() + offset , sizeof( V ) ) ;
+          return value ;
+        }
+
+        /// Bytes of this angle table.
+        std::vector< char >  buffer_ ;
+        /// Number of parameters of this angle table.
+        uint64_t             nbParameters_ = 0 ;
+        /// Number of rows of this angle table.
+        size_t               nbRows_ = 0 ;
+
+    } ; // class AngleTableReader
+
+  } // namespace io
+
+} // namespace f3c
+
+#endif
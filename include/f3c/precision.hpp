@@ -0,0 +1,152 @@
+//  (C) Copyright Roel Van Beeumen and Daan Camps 2021.
+
+#ifndef f3c_precision_hpp
+#define f3c_precision_hpp
+
+#include "f3c/concepts.hpp"
+#include "f3c/TriangleCircuit.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+namespace f3c {
+
+  /**
+   * \brief Normalizes the quantum rotation `rot` such that
+   *        \f$\cos^2 + \sin^2 = 1\f$ and returns the defect
+   *        \f$|\cos^2 + \sin^2 - 1|\f$ before normalization.
+   */
+  template <typename R>
+  inline R normalize( qclab::QRotation< R >& rot ) {
+    const R c = rot.cos() ;
+    const R s = rot.sin() ;
+    const R nrm2 = c * c + s * s ;
+    const R r = std::sqrt( nrm2 ) ;
+    rot = qclab::QRotation< R >( c / r , s / r ) ;
+    return std::abs( nrm2 - 1 ) ;
+  }
+
+  /**
+   * \brief Normalizes the complex pair (`x`,`y`) such that
+   *        \f$|x|^2 + |y|^2 = 1\f$ and returns the defect
+   *        \f$||x|^2 + |y|^2 - 1|\f$ before normalization.
+   */
+  template <typename T>
+  inline qclab::real_t< T > normalize( T& x , T& y ) {
+    using R = qclab::real_t< T > ;
+    const R nrm2 = std::norm( x ) + std::norm( y ) ;
+    const R r = std::sqrt( nrm2 ) ;
+    x /= r ;
+    y /= r ;
+    return std::abs( nrm2 - 1 ) ;
+  }
+
+  /**
+   * \brief Re-unitarizes the gate `gate` and returns its unitarity defect
+   *        before normalization.
+   *
+   * Rounding errors of the turnovers drift the numerical values of a gate
+   * away from the unitary manifold. TFXY-rotation matrix gates are projected
+   * back onto \f$|a|^2 + |d|^2 = 1\f$ and \f$|b|^2 + |c|^2 = 1\f$,
+   * TFXY-U(1)-rotation gates onto \f$|a| = 1\f$ and
+   * \f$|b|^2 + |c|^2 = 1\f$, and rotation gates onto
+   * \f$\cos^2 + \sin^2 = 1\f$. The defect is the largest violation of these
+   * constraints. Rotation gates stay unitary by construction, so their
+   * defect does not capture rounding errors of the rotation angles.
+   */
+  template <typename G>
+  qclab::real_t< typename G::value_type > normalize( G& gate ) {
+    using T = typename G::value_type ;
+    using R = qclab::real_t< T > ;
+    if constexpr ( f3c::is_TFXY_matrix_v< G > ) {
+      T a = gate.a() ; T b = gate.b() ; T c = gate.c() ; T d = gate.d() ;
+      const R defect = std::max( normalize( a , d ) , normalize( b , c ) ) ;
+      gate.update( a , b , c , d ) ;
+      return defect ;
+    } else if constexpr ( f3c::is_TFXY_U1_matrix_v< G > ) {
+      T a = gate.a() ; T b = gate.b() ; T c = gate.c() ;
+      T zero = 0 ;
+      const R defect = std::max( normalize( a , zero ) , normalize( b , c ) ) ;
+      gate.update( a , b , c ) ;
+      return defect ;
+    } else if constexpr ( f3c::is_two_axes_v< G > ) {
+      typename G::rotation_type rot0 = std::get< 0 >( gate.rotations() ) ;
+      typename G::rotation_type rot1 = std::get< 1 >( gate.rotations() ) ;
+      const R defect = std::max( normalize( rot0 ) , normalize( rot1 ) ) ;
+      gate.update( rot0 , rot1 ) ;
+      return defect ;
+    } else {
+      static_assert( f3c::is_one_axis_v< G > || f3c::is_TFIM_v< G > ) ;
+      qclab::QRotation< R > rot = gate.rotation() ;
+      const R defect = normalize( rot ) ;
+      gate.update( rot ) ;
+      return defect ;
+    }
+  }
+
+  /**
+   * \brief Re-unitarizes all gates of the triangle quantum circuit `triangle`
+   *        and returns the largest unitarity defect before normalization.
+   */
+  template <typename T, typename G>
+  qclab::real_t< T > normalize( TriangleCircuit< T , G >& triangle ) {
+    using R = qclab::real_t< T > ;
+    const int nbGates = triangle.nbGates() ;
+    R defect = 0 ;
+    #pragma omp parallel for reduction(max:defect)
+    for ( int k = 0; k < nbGates; k++ ) {
+      defect = std::max( defect , normalize( *triangle[k] ) ) ;
+    }
+    return defect ;
+  }
+
+  /**
+   * \brief Converts the gate `gate` to the gate type `G2` with a different
+   *        precision.
+   */
+  template <typename G2, typename G1>
+  G2 convert( const G1& gate ) {
+    using T2 = typename G2::value_type ;
+    using R2 = qclab::real_t< T2 > ;
+    using rotation_type = qclab::QRotation< R2 > ;
+    auto rotation = []( const auto& rot ) {
+      return rotation_type( R2( rot.cos() ) , R2( rot.sin() ) ) ;
+    } ;
+    const auto q = f3c::qubitPair( gate ) ;
+    if constexpr ( f3c::is_TFXY_matrix_v< G1 > ) {
+      return G2( q[0] , q[1] , T2( gate.a() ) , T2( gate.b() ) ,
+                               T2( gate.c() ) , T2( gate.d() ) ) ;
+    } else if constexpr ( f3c::is_TFXY_U1_matrix_v< G1 > ) {
+      return G2( q[0] , q[1] , T2( gate.a() ) , T2( gate.b() ) ,
+                               T2( gate.c() ) ) ;
+    } else if constexpr ( f3c::is_two_axes_v< G1 > ) {
+      const auto [ rot0 , rot1 ] = gate.rotations() ;
+      return G2( q[0] , q[1] , rotation( rot0 ) , rotation( rot1 ) ) ;
+    } else {
+      static_assert( f3c::is_TFIM_v< G1 > ) ;
+      return G2( q[0] , q[1] , rotation( gate.rotation() ) ) ;
+    }
+  }
+
+  /**
+   * \brief Converts the triangle quantum circuit `triangle` to a triangle
+   *        quantum circuit of gates of type `G2` with a different precision.
+   *
+   * The gates keep their positions in the triangle, such that the
+   * compression can continue in the new precision.
+   */
+  template <typename T2, typename G2, typename T1, typename G1>
+  TriangleCircuit< T2 , G2 > convert(
+                                  const TriangleCircuit< T1 , G1 >& triangle ) {
+    TriangleCircuit< T2 , G2 >  result( triangle.nbQubits() ) ;
+    const int nbGates = triangle.nbGates() ;
+    #pragma omp parallel for
+    for ( int k = 0; k < nbGates; k++ ) {
+      result[k] = std::make_unique< G2 >( convert< G2 >( *triangle[k] ) ) ;
+    }
+    return result ;
+  }
+
+} // namespace f3c
+
+#endif
@@ -4,6 +4,7 @@
 #define f3c_qasm_hpp
 
 #include "qclab/qasm.hpp"
+#include "f3c/io/QASMBuffer.hpp"
 
 namespace f3c {
 
@@ -27,6 +28,19 @@ namespace f3c {
     return stream.str() ;
   }
 
+  /**
+   * \brief Returns a qasm string for a Rotation XX gate on the given qubits
+   *        `qubit0` and `qubit1`, and with angle `theta`.
+   */
+  template <typename T>
+  inline auto qasmRxx( const int qubit0 , const int qubit1 , const T theta ) {
+    std::stringstream stream ;
+    stream << qclab::qasmCX( qubit0 , qubit1 )
+           << qclab::qasmRx( qubit0 , theta )
+           << qclab::qasmCX( qubit0 , qubit1 ) ;
+    return stream.str() ;
+  }
+
   /**
    * \brief Returns a qasm string for a Rotation XZ gate on the given qubits
    *        `qubit0` and `qubit1`, and with angles `theta0` and `theta1`.
@@ -136,6 +150,123 @@ namespace f3c {
     return stream.str() ;
   }
 
+  /**
+   * \brief Appends the qasm code for a Rotation XY gate on the given qubits
+   *        `qubit0` and `qubit1`, and with angles `theta0` and `theta1` to
+   *        `buffer`.
+   */
+  template <typename T>
+  inline void qasmRxy( io::QASMBuffer& buffer ,
+                       const int qubit0 , const int qubit1 ,
+                       const T theta0 , const T theta1 ) {
+    const io::qasm_real_t< T > pi2 = 2 * std::atan(1) ;
+    buffer.rx( qubit0 , pi2 ).rx( qubit1 , pi2 )
+          .cx( qubit0 , qubit1 )
+          .rx( qubit0 , theta0 ).rz( qubit1 , theta1 )
+          .cx( qubit0 , qubit1 )
+          .rx( qubit0 , -pi2 ).rx( qubit1 , -pi2 ) ;
+  }
+
+  /**
+   * \brief Appends the qasm code for a Rotation XX gate on the given qubits
+   *        `qubit0` and `qubit1`, and with angle `theta` to `buffer`.
+   */
+  template <typename T>
+  inline void qasmRxx( io::QASMBuffer& buffer ,
+                       const int qubit0 , const int qubit1 , const T theta ) {
+    buffer.cx( qubit0 , qubit1 )
+          .rx( qubit0 , theta )
+          .cx( qubit0 , qubit1 ) ;
+  }
+
+  /**
+   * \brief Appends the qasm code for a Rotation XZ gate on the given qubits
+   *        `qubit0` and `qubit1`, and with angles `theta0` and `theta1` to
+   *        `buffer`.
+   */
+  template <typename T>
+  inline void qasmRxz( io::QASMBuffer& buffer ,
+                       const int qubit0 , const int qubit1 ,
+                       const T theta0 , const T theta1 ) {
+    buffer.cx( qubit0 , qubit1 )
+          .rx( qubit0 , theta0 ).rz( qubit1 , theta1 )
+          .cx( qubit0 , qubit1 ) ;
+  }
+
+  /**
+   * \brief Appends the qasm code for a Rotation YZ gate on the given qubits
+   *        `qubit0` and `qubit1`, and with angles `theta0` and `theta1` to
+   *        `buffer`.
+   */
+  template <typename T>
+  inline void qasmRyz( io::QASMBuffer& buffer ,
+                       const int qubit0 , const int qubit1 ,
+                       const T theta0 , const T theta1 ) {
+    const io::qasm_real_t< T > pi2 = 2 * std::atan(1) ;
+    buffer.rz( qubit0 , pi2 ).rz( qubit1 , pi2 )
+          .cx( qubit0 , qubit1 )
+          .rx( qubit0 , theta0 ).rz( qubit1 , theta1 )
+          .cx( qubit0 , qubit1 )
+          .rz( qubit0 , -pi2 ).rz( qubit1 , -pi2 ) ;
+  }
+
+  /**
+   * \brief Appends the qasm code for a Rotation TFXY gate on the given qubits
+   *        `qubit0` and `qubit1`, and with angles `theta0`, `theta1`,
+   *        `theta2`, `theta3`, `theta4`, and `theta5` to `buffer`.
+   */
+  template <typename T>
+  inline void qasmTFRxy( io::QASMBuffer& buffer ,
+                         const int qubit0 , const int qubit1 ,
+                         const T theta0 , const T theta1 , const T theta2 ,
+                         const T theta3 , const T theta4 , const T theta5 ) {
+    const io::qasm_real_t< T > pi2 = 2 * std::atan(1) ;
+    buffer.rz( qubit0 , theta0 ).rz( qubit1 , theta1 )
+          .rx( qubit0 , pi2 ).rx( qubit1 , pi2 )
+          .cx( qubit0 , qubit1 )
+          .rx( qubit0 , theta2 ).rz( qubit1 , theta3 )
+          .cx( qubit0 , qubit1 )
+          .rx( qubit0 , -pi2 ).rx( qubit1 , -pi2 )
+          .rz( qubit0 , theta4 ).rz( qubit1 , theta5 ) ;
+  }
+
+  /**
+   * \brief Appends the qasm code for a Rotation TFXZ gate on the given qubits
+   *        `qubit0` and `qubit1`, and with angles `theta0`, `theta1`,
+   *        `theta2`, `theta3`, `theta4`, and `theta5` to `buffer`.
+   */
+  template <typename T>
+  inline void qasmTFRxz( io::QASMBuffer& buffer ,
+                         const int qubit0 , const int qubit1 ,
+                         const T theta0 , const T theta1 , const T theta2 ,
+                         const T theta3 , const T theta4 , const T theta5 ) {
+    buffer.ry( qubit0 , theta0 ).ry( qubit1 , theta1 )
+          .cx( qubit0 , qubit1 )
+          .rx( qubit0 , theta2 ).rz( qubit1 , theta3 )
+          .cx( qubit0 , qubit1 )
+          .ry( qubit0 , theta4 ).ry( qubit1 , theta5 ) ;
+  }
+
+  /**
+   * \brief Appends the qasm code for a Rotation TFYZ gate on the given qubits
+   *        `qubit0` and `qubit1`, and with angles `theta0`, `theta1`,
+   *        `theta2`, `theta3`, `theta4`, and `theta5` to `buffer`.
+   */
+  template <typename T>
+  inline void qasmTFRyz( io::QASMBuffer& buffer ,
+                         const int qubit0 , const int qubit1 ,
+                         const T theta0 , const T theta1 , const T theta2 ,
+                         const T theta3 , const T theta4 , const T theta5 ) {
+    const io::qasm_real_t< T > pi2 = 2 * std::atan(1) ;
+    buffer.rx( qubit0 , theta0 ).rx( qubit1 , theta1 )
+          .rz( qubit0 , pi2 ).rz( qubit1 , pi2 )
+          .cx( qubit0 , qubit1 )
+          .rx( qubit0 , theta2 ).rz( qubit1 , theta3 )
+          .cx( qubit0 , qubit1 )
+          .rz( qubit0 , -pi2 ).rz( qubit1 , -pi2 )
+          .rx( qubit0 , theta4 ).rx( qubit1 , theta5 ) ;
+  }
+
 } // namespace f3c
 
 #endif
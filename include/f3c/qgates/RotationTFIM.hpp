@@ -0,0 +1,229 @@
+//  (C) Copyright Roel Van Beeumen and Daan Camps 2021.
+
+#ifndef f3c_qgates_RotationTFIM_hpp
+#define f3c_qgates_RotationTFIM_hpp
+
+#include "qclab/qgates/QGate2.hpp"
+#include "qclab/QRotation.hpp"
+#include "qclab/dense/SquareMatrix.hpp"
+#include "f3c/qasm.hpp"
+#include <array>
+
+namespace f3c {
+
+  namespace qgates {
+
+    /**
+     * \class RotationTFIM
+     * \brief Rotation gate of the transverse field Ising model on 2
+     *        neighboring Majorana modes.
+     *
+     * The Hamiltonian terms of the TFIM,
+     *    \f$Z_q = -i \gamma_{2q} \gamma_{2q+1}\f$ and
+     *    \f$X_q X_{q+1} = -i \gamma_{2q+1} \gamma_{2q+2}\f$,
+     * couple neighboring Majorana modes of a chain of 2N modes. A TFIM-rotation
+     * gate on the modes `mode` and `mode+1` is a Z-rotation on qubit
+     * `mode/2` for even `mode` and an XX-rotation on qubits `(mode-1)/2` and
+     * `(mode+1)/2` for odd `mode`. Its single-particle matrix is a Givens
+     * rotation with angle \f$\theta\f$ on the 2 modes.
+     *
+     * Circuits of TFIM-rotation gates act on the 2N Majorana modes instead of
+     * the N qubits, i.e., the "qubits" of the gate are its modes. Gates on
+     * neighboring modes anticommute and form SU(2), such that turnovers are
+     * real SU(2) turnovers of a single rotation.
+     */
+    template <typename T>
+    class RotationTFIM : public qclab::qgates::QGate2< T >
+    {
+
+      public:
+        /// Real value type of this TFIM-rotation gate.
+        using real_type = qclab::real_t< T > ;
+        /// Quantum rotation type of this TFIM-rotation gate.
+        using rotation_type = qclab::QRotation< real_type > ;
+
+        /**
+         * \brief Default constructor. Constructs a TFIM-rotation gate on
+         *        modes 0 and 1 with parameter \f$\theta = 0\f$.
+         */
+        RotationTFIM()
+        : modes_( { 0 , 1 } )
+        , rotation_()
+        { } // RotationTFIM()
+
+        /**
+         * \brief Constructs a TFIM-rotation gate on the given modes `mode0`
+         *        and `mode1` with quantum rotation `rot` = \f$\theta\f$.
+         */
+        RotationTFIM( const int mode0 , const int mode1 ,
+                      const rotation_type& rot )
+        : rotation_( rot )
+        {
+          const int modes[2] = { mode0 , mode1 } ;
+          setQubits( &modes[0] ) ;
+        } // RotationTFIM(mode0,mode1,rot)
+
+        /**
+         * \brief Constructs a TFIM-rotation gate on the given modes `mode0`
+         *        and `mode1` with value `theta` = \f$\theta\f$.
+         */
+        RotationTFIM( const int mode0 , const int mode1 ,
+                      const real_type theta )
+        : rotation_( theta )
+        {
+          const int modes[2] = { mode0 , mode1 } ;
+          setQubits( &modes[0] ) ;
+        } // RotationTFIM(mode0,mode1,theta)
+
+        // nbQubits
+
+        /// Checks if this TFIM-rotation gate is fixed.
+        inline bool fixed() const override { return false ; }
+
+        /// Checks if this TFIM-rotation gate is controlled.
+        inline bool controlled() const override { return false ; }
+
+        /// Returns the first mode of this TFIM-rotation gate.
+        inline int qubit() const override { return modes_[0] ; }
+
+        // setQubit
+
+        /// Returns the modes of this TFIM-rotation gate in ascending order.
+        std::vector< int > qubits() const override {
+          return std::vector< int >( { modes_[0] , modes_[1] } ) ;
+        }
+
+        /**
+         * \brief Returns the modes of this TFIM-rotation gate in ascending
+         *        order without allocating a vector.
+         */
+        inline const std::array< int , 2 >& qubitPair() const {
+          return modes_ ;
+        }
+
+        /// Sets the modes of this TFIM-rotation gate.
+        inline void setQubits( const int* modes ) override {
+          assert( modes[0] >= 0 ) ; assert( modes[1] >= 0 ) ;
+          assert( std::abs( modes[0] - modes[1] ) == 1 ) ;
+          modes_[0] = std::min( modes[0] , modes[1] ) ;
+          modes_[1] = std::max( modes[0] , modes[1] ) ;
+        }
+
+        /// Checks if this TFIM-rotation gate is an XX-rotation.
+        inline bool isXX() const { return modes_[0] % 2 != 0 ; }
+
+        /**
+         * \brief Returns the unitary matrix of this TFIM-rotation gate on the
+         *        qubits \f$q\f$ and \f$q+1\f$, with \f$q\f$ = `mode0/2`.
+         */
+        qclab::dense::SquareMatrix< T > matrix() const override {
+          const real_type c = rotation_.cos() ;
+          const real_type s = rotation_.sin() ;
+          if ( isXX() ) {
+            const T is( 0 , -s ) ;
+            return qclab::dense::SquareMatrix< T >(  c ,  0 ,  0 , is ,
+                                                     0 ,  c , is ,  0 ,
+                                                     0 , is ,  c ,  0 ,
+                                                    is ,  0 ,  0 ,  c ) ;
+          }
+          const T zm( c , -s ) ;
+          const T zp( c ,  s ) ;
+          return qclab::dense::SquareMatrix< T >( zm ,  0 ,  0 ,  0 ,
+                                                   0 , zm ,  0 ,  0 ,
+                                                   0 ,  0 , zp ,  0 ,
+                                                   0 ,  0 ,  0 , zp ) ;
+        }
+
+        // apply
+
+        // print
+
+        /**
+         * \brief Writes the QASM code of this TFIM-rotation gate to the given
+         *        `stream`, on the qubits of its modes.
+         */
+        int toQASM( std::ostream& stream ,
+                    const int offset = 0 ) const override {
+          const int q = modes_[0] / 2 + offset ;
+          if ( isXX() ) {
+            stream << qasmRxx( q , q + 1 , theta() ) ;
+          } else {
+            stream << qclab::qasmRz( q , theta() ) ;
+          }
+          return 0 ;
+        }
+
+        /**
+         * \brief Appends the QASM code of this TFIM-rotation gate to the given
+         *        `buffer`.
+         */
+        void toQASM( io::QASMBuffer& buffer , const int offset = 0 ) const {
+          const int q = modes_[0] / 2 + offset ;
+          if ( isXX() ) {
+            qasmRxx( buffer , q , q + 1 , theta() ) ;
+          } else {
+            buffer.rz( q , theta() ) ;
+          }
+        }
+
+        // operator==
+
+        // operator!=
+
+        /// Checks if `other` equals this TFIM-rotation gate.
+        inline bool equals( const qclab::QObject< T >& other ) const override {
+          using TFIM = RotationTFIM< T > ;
+          if ( const TFIM* p = dynamic_cast< const TFIM* >( &other ) ) {
+            return ( p->qubitPair() == modes_ ) &&
+                   ( p->rotation() == rotation_ ) ;
+          }
+          return false ;
+        }
+
+        /// Returns the quantum rotation of this TFIM-rotation gate.
+        inline const rotation_type& rotation() const { return rotation_ ; }
+
+        /// Returns the value \f$\theta\f$ of this TFIM-rotation gate.
+        inline real_type theta() const { return rotation_.theta() ; }
+
+        /**
+         * \brief Updates this TFIM-rotation gate with the given quantum
+         *        rotation `rot` = \f$\theta\f$.
+         */
+        inline void update( const rotation_type& rot ) { rotation_ = rot ; }
+
+        /**
+         * \brief Updates this TFIM-rotation gate with the given value
+         *        `theta` = \f$\theta\f$.
+         */
+        inline void update( const real_type theta ) {
+          rotation_.update( theta ) ;
+        }
+
+        /// Multiplies `rhs` to this TFIM-rotation gate.
+        inline RotationTFIM< T >& operator*=( const RotationTFIM< T >& rhs ) {
+          assert( modes_ == rhs.qubitPair() ) ;
+          rotation_ *= rhs.rotation() ;
+          return *this ;
+        }
+
+        /// Multiplies `lhs` and `rhs`.
+        friend RotationTFIM< T > operator*( RotationTFIM< T > lhs ,
+                                            const RotationTFIM< T >& rhs ) {
+          lhs *= rhs ;
+          return lhs ;
+        }
+
+      protected:
+        /// Majorana modes of this TFIM-rotation gate.
+        std::array< int , 2 >  modes_ ;
+        /// Quantum rotation of this TFIM-rotation gate.
+        rotation_type          rotation_ ;
+
+    } ; // class RotationTFIM
+
+  } // namespace qgates
+
+} // namespace f3c
+
+#endif
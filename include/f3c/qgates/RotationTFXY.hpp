@@ -154,6 +154,18 @@ namespace f3c {
           return 0 ;
         }
 
+        /**
+         * \brief Appends the QASM code of this TFXY-rotation gate to the given
+         *        `buffer`.
+         */
+        void toQASM( io::QASMBuffer& buffer , const int offset = 0 ) const {
+          qasmTFRxy( buffer , this->qubits_[0] + offset ,
+                             this->qubits_[1] + offset ,
+                             this->theta0() , this->theta1() ,
+                             this->theta2() , this->theta3() ,
+                             this->theta4() , this->theta5() ) ;
+        }
+
         // operator==
 
         // operator!=
@@ -191,8 +203,8 @@ namespace f3c {
 
         /// Multiplies `rhs` to this 2-qubit TFXY-rotation gate.
         inline RotationTFXY< T >& operator*=( const RotationTFXY< T >& rhs ) {
-          assert( this->qubits()[0] == rhs.qubits()[0] ) ;
-          assert( this->qubits()[1] == rhs.qubits()[1] ) ;
+          assert( this->qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( this->qubitPair()[1] == rhs.qubitPair()[1] ) ;
           using TFXYMatrix = RotationTFXYMatrix< T > ;
           // fuse
           RotationTFXYMatrix< T > matrix( *this ) ;
@@ -211,8 +223,8 @@ namespace f3c {
         /// Multiplies `lhs` and `rhs`.
         friend RotationTFXY< T > operator*( RotationTFXY< T > lhs ,
                                             const RotationTFXY< T >& rhs ) {
-          assert( lhs.qubits()[0] == rhs.qubits()[0] ) ;
-          assert( lhs.qubits()[1] == rhs.qubits()[1] ) ;
+          assert( lhs.qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( lhs.qubitPair()[1] == rhs.qubitPair()[1] ) ;
           lhs *= rhs ;
           return lhs ;
         }
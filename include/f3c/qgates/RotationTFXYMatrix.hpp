@@ -4,6 +4,7 @@
 #define f3c_qgates_RotationTFXYMatrix_hpp
 
 #include "qclab/qgates/QGate2.hpp"
+#include "f3c/qasm.hpp"
 #include <array>
 
 namespace f3c {
@@ -88,7 +89,7 @@ namespace f3c {
          */
         RotationTFXYMatrix( const RotationTFXY< T >& gate )
         {
-          setQubits( &(gate.qubits()[0]) ) ;
+          setQubits( gate.qubitPair().data() ) ;
           update( gate.a() , gate.b() , gate.c() , gate.d() ) ;
         } // RotationTFXYMatrix(gate)
 
@@ -98,7 +99,7 @@ namespace f3c {
          */
         RotationTFXYMatrix( const RotationTFXZ< T >& gate )
         {
-          setQubits( &(gate.qubits()[0]) ) ;
+          setQubits( gate.qubitPair().data() ) ;
           update( gate.a() , gate.b() , gate.c() , gate.d() ) ;
         } // RotationTFXYMatrix(gate)
 
@@ -108,7 +109,7 @@ namespace f3c {
          */
         RotationTFXYMatrix( const RotationTFYZ< T >& gate )
         {
-          setQubits( &(gate.qubits()[0]) ) ;
+          setQubits( gate.qubitPair().data() ) ;
           update( gate.a() , gate.b() , gate.c() , gate.d() ) ;
         } // RotationTFXYMatrix(gate)
 
@@ -130,6 +131,14 @@ namespace f3c {
           return std::vector< int >( { qubits_[0] , qubits_[1] } ) ;
         }
 
+        /**
+         * \brief Returns the qubits of this TFXY-rotation gate in ascending
+         *        order without allocating a vector.
+         */
+        inline const std::array< int , 2 >& qubitPair() const {
+          return qubits_ ;
+        }
+
         /// Sets the qubits of this TFXY-rotation gate.
         inline void setQubits( const int* qubits ) override {
           assert( qubits[0] >= 0 ) ; assert( qubits[1] >= 0 ) ;
@@ -157,8 +166,22 @@ namespace f3c {
          */
         int toQASM( std::ostream& stream ,
                     const int offset = 0 ) const override {
-          f3c::qgates::RotationTFXY< T >  tmp( *this ) ;
-          return tmp.toQASM( stream , offset ) ;
+          const auto theta = thetas() ;
+          stream << qasmTFRxy( qubits_[0] + offset , qubits_[1] + offset ,
+                               theta[0] , theta[1] , theta[2] ,
+                               theta[3] , theta[4] , theta[5] ) ;
+          return 0 ;
+        }
+
+        /**
+         * \brief Appends the QASM code of this TFXY-rotation gate to the given
+         *        `buffer`.
+         */
+        void toQASM( io::QASMBuffer& buffer , const int offset = 0 ) const {
+          const auto theta = thetas() ;
+          qasmTFRxy( buffer , qubits_[0] + offset , qubits_[1] + offset ,
+                     theta[0] , theta[1] , theta[2] ,
+                     theta[3] , theta[4] , theta[5] ) ;
         }
 
         // operator==
@@ -190,6 +213,37 @@ namespace f3c {
         /// Returns the numerical values of this TFXY-rotation gate.
         inline const std::array< T , 4 >& values() const { return v_ ; }
 
+        /**
+         * \brief Returns the values \f$\theta_0, \ldots, \theta_5\f$ of the
+         *        transverse field 2-axes rotation gate with the same matrix as
+         *        this TFXY-rotation gate.
+         *
+         * The values are computed directly from \f$a\f$, \f$b\f$, \f$c\f$,
+         * and \f$d\f$, and lie in \f$(-2\pi,2\pi]\f$, the range of the values
+         * of quantum rotations.
+         */
+        std::array< real_type , 6 > thetas() const {
+          using R = real_type ;
+          const R arga = std::arg( v_[0] ) ;
+          const R argb = std::arg( v_[1] ) ;
+          const R argc = std::arg( v_[2] ) ;
+          const R argd = std::arg( v_[3] ) ;
+          const R pi = 4 * std::atan(1) ;
+          const R theta1 = std::atan2( std::abs( v_[2] ) , std::abs( v_[1] ) ) ;
+          const R theta2 = std::atan2( std::abs( v_[3] ) , std::abs( v_[0] ) ) ;
+          std::array< R , 6 >  theta = {
+            ( -arga - argb - argc - argd - pi ) / 2 ,
+            ( -arga + argb + argc - argd      ) / 2 ,
+            theta1 + theta2 ,
+            theta1 - theta2 ,
+            ( -arga - argb + argc + argd + pi ) / 2 ,
+            ( -arga + argb - argc + argd      ) / 2 } ;
+          for ( auto& t : theta ) {
+            t -= 4 * pi * std::ceil( t / ( 4 * pi ) - R(0.5) ) ;
+          }
+          return theta ;
+        }
+
         /// Updates this TFXY-rotation gate with the given parameters.
         inline void update( const T a , const T b , const T c , const T d ) {
           //const real_type eps = std::numeric_limits< real_type >::epsilon() ;
@@ -206,8 +260,8 @@ namespace f3c {
         /// Multiplies `rhs` to this 2-qubit TFXY-rotation gate.
         inline RotationTFXYMatrix< T >& operator*=(
                                           const RotationTFXYMatrix< T >& rhs ) {
-          assert( this->qubits()[0] == rhs.qubits()[0] ) ;
-          assert( this->qubits()[1] == rhs.qubits()[1] ) ;
+          assert( this->qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( this->qubitPair()[1] == rhs.qubitPair()[1] ) ;
           update( rhs.a() * a() - std::conj( rhs.d() ) * d() ,
                   rhs.b() * b() - std::conj( rhs.c() ) * c() ,
                   rhs.c() * b() + std::conj( rhs.b() ) * c() ,
@@ -218,8 +272,8 @@ namespace f3c {
         /// Multiplies `lhs` and `rhs`.
         friend RotationTFXYMatrix< T > operator*( RotationTFXYMatrix< T > lhs ,
                                           const RotationTFXYMatrix< T >& rhs ) {
-          assert( lhs.qubits()[0] == rhs.qubits()[0] ) ;
-          assert( lhs.qubits()[1] == rhs.qubits()[1] ) ;
+          assert( lhs.qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( lhs.qubitPair()[1] == rhs.qubitPair()[1] ) ;
           lhs *= rhs ;
           return lhs ;
         }
@@ -0,0 +1,252 @@
+//  (C) Copyright Roel Van Beeumen and Daan Camps 2021.
+
+#ifndef f3c_qgates_RotationTFXYU1Matrix_hpp
+#define f3c_qgates_RotationTFXYU1Matrix_hpp
+
+#include "qclab/qgates/QGate2.hpp"
+#include "f3c/qgates/RotationTFXY.hpp"
+#include "f3c/qgates/RotationTFXYMatrix.hpp"
+#include "f3c/qasm.hpp"
+#include <array>
+
+namespace f3c {
+
+  namespace qgates {
+
+    /**
+     * \class RotationTFXYU1Matrix
+     * \brief 2-qubit particle number conserving transverse field rotation gate
+     *        about XY.
+     *
+     * This is the subfamily of TFXY-rotation matrix gates with \f$d = 0\f$,
+     * i.e., the gates of the TFXY model with \f$J_x = J_y\f$. The subfamily is
+     * closed under products and turnovers, hence only the numerical values
+     * \f$a\f$, \f$b\f$, and \f$c\f$ are stored.
+     */
+    template <typename T>
+    class RotationTFXYU1Matrix : public qclab::qgates::QGate2< T >
+    {
+
+      public:
+        /// Real value type of this TFXY-U(1)-rotation gate.
+        using real_type = qclab::real_t< T > ;
+
+        /**
+         * \brief Default constructor. Constructs a TFXY-U(1)-rotation gate on
+         *        qubits 0 and 1 with parameters \f$a = b = 1\f$ and
+         *        \f$c = 0\f$.
+         */
+        RotationTFXYU1Matrix()
+        : qubits_( { 0 , 1 } )
+        , v_( { 1 , 1 , 0 } )
+        { } // RotationTFXYU1Matrix()
+
+        /**
+         * \brief Constructs a TFXY-U(1)-rotation gate on qubits 0 and 1 with
+         *        the given numerical values `a`, `b`, and `c`.
+         */
+        RotationTFXYU1Matrix( const T a , const T b , const T c )
+        : qubits_( { 0 , 1 } )
+        {
+          update( a , b , c ) ;
+        } // RotationTFXYU1Matrix(a,b,c)
+
+        /**
+         * \brief Constructs a TFXY-U(1)-rotation gate on the given qubits
+         *        `qubit0` and `qubit1` with numerical values `a`, `b`, and `c`.
+         */
+        RotationTFXYU1Matrix( const int qubit0 , const int qubit1 ,
+                              const T a , const T b , const T c )
+        {
+          const int qubits[2] = { qubit0 , qubit1 } ;
+          setQubits( &qubits[0] ) ;
+          update( a , b , c ) ;
+        } // RotationTFXYU1Matrix(qubit0,qubit1,a,b,c)
+
+        /**
+         * \brief Constructs a TFXY-U(1)-rotation gate on the given qubits
+         *        `qubit0` and `qubit1` with values
+         *          `theta0` = \f$\theta_0\f$, `theta1` = \f$\theta_1\f$,
+         *          `theta2` = \f$\theta_2\f$, `theta3` = \f$\theta_3\f$,
+         *          `theta4` = \f$\theta_4\f$, `theta5` = \f$\theta_5\f$.
+         *
+         * The XX and YY angles `theta2` and `theta3` must be equal.
+         */
+        RotationTFXYU1Matrix( const int qubit0 , const int qubit1 ,
+                              const real_type theta0 , const real_type theta1 ,
+                              const real_type theta2 , const real_type theta3 ,
+                              const real_type theta4 , const real_type theta5 )
+        {
+          assert( theta2 == theta3 ) ;
+          const int qubits[2] = { qubit0 , qubit1 } ;
+          setQubits( &qubits[0] ) ;
+          const RotationTFXY< T > tmp( theta0 , theta1 , theta2 ,
+                                       theta3 , theta4 , theta5 ) ;
+          update( tmp.a() , tmp.b() , tmp.c() ) ;
+        } // RotationTFXYU1Matrix(qubit0,qubit1,theta0,theta1,theta2,theta3,theta4,theta5)
+
+        /**
+         * \brief Constructs a TFXY-U(1)-rotation gate from the given
+         *        TFXY-rotation matrix gate `gate` with \f$d = 0\f$.
+         */
+        RotationTFXYU1Matrix( const RotationTFXYMatrix< T >& gate )
+        {
+          assert( gate.d() == T(0) ) ;
+          setQubits( gate.qubitPair().data() ) ;
+          update( gate.a() , gate.b() , gate.c() ) ;
+        } // RotationTFXYU1Matrix(gate)
+
+        // nbQubits
+
+        /// Checks if this TFXY-U(1)-rotation gate is fixed.
+        inline bool fixed() const override { return false ; }
+
+        /// Checks if this TFXY-U(1)-rotation gate is controlled.
+        inline bool controlled() const override { return false ; }
+
+        /// Returns the first qubit of this TFXY-U(1)-rotation gate.
+        inline int qubit() const override { return qubits_[0] ; }
+
+        // setQubit
+
+        /// Returns the qubits of this TFXY-U(1)-rotation gate in order.
+        std::vector< int > qubits() const override {
+          return std::vector< int >( { qubits_[0] , qubits_[1] } ) ;
+        }
+
+        /**
+         * \brief Returns the qubits of this TFXY-U(1)-rotation gate in
+         *        ascending order without allocating a vector.
+         */
+        inline const std::array< int , 2 >& qubitPair() const {
+          return qubits_ ;
+        }
+
+        /// Sets the qubits of this TFXY-U(1)-rotation gate.
+        inline void setQubits( const int* qubits ) override {
+          assert( qubits[0] >= 0 ) ; assert( qubits[1] >= 0 ) ;
+          assert( qubits[0] != qubits[1] ) ;
+          qubits_[0] = std::min( qubits[0] , qubits[1] ) ;
+          qubits_[1] = std::max( qubits[0] , qubits[1] ) ;
+        }
+
+        /**
+         * \brief Returns the unitary matrix corresponding to this
+         *        TFXY-U(1)-rotation gate.
+         */
+        qclab::dense::SquareMatrix< T > matrix() const override {
+          using M = qclab::dense::SquareMatrix< T > ;
+          return M( v_[0] ,   0   ,          0          ,         0          ,
+                      0   , v_[1] , -std::conj( v_[2] ) ,         0          ,
+                      0   , v_[2] ,  std::conj( v_[1] ) ,         0          ,
+                      0   ,   0   ,          0          , std::conj( v_[0] ) );
+        }
+
+        // apply
+
+        // print
+
+        /**
+         * \brief Writes the QASM code of this TFXY-U(1)-rotation gate to the
+         *        given `stream`.
+         */
+        int toQASM( std::ostream& stream ,
+                    const int offset = 0 ) const override {
+          const auto theta = thetas() ;
+          stream << qasmTFRxy( qubits_[0] + offset , qubits_[1] + offset ,
+                               theta[0] , theta[1] , theta[2] ,
+                               theta[3] , theta[4] , theta[5] ) ;
+          return 0 ;
+        }
+
+        /**
+         * \brief Appends the QASM code of this TFXY-U(1)-rotation gate to the
+         *        given `buffer`.
+         */
+        void toQASM( io::QASMBuffer& buffer , const int offset = 0 ) const {
+          const auto theta = thetas() ;
+          qasmTFRxy( buffer , qubits_[0] + offset , qubits_[1] + offset ,
+                     theta[0] , theta[1] , theta[2] ,
+                     theta[3] , theta[4] , theta[5] ) ;
+        }
+
+        // operator==
+
+        // operator!=
+
+        /// Checks if `other` equals this TFXY-U(1)-rotation gate.
+        inline bool equals( const qclab::QObject< T >& other ) const override {
+          using TFXYU1 = RotationTFXYU1Matrix< T > ;
+          if ( const TFXYU1* p = dynamic_cast< const TFXYU1* >( &other ) ) {
+            return ( p->a() == this->a() ) && ( p->b() == this->b() ) &&
+                   ( p->c() == this->c() ) ;
+          }
+          return false ;
+        }
+
+        /// Returns the numerical value \f$a\f$ of this TFXY-U(1)-rotation gate.
+        inline T a() const { return v_[0] ; }
+
+        /// Returns the numerical value \f$b\f$ of this TFXY-U(1)-rotation gate.
+        inline T b() const { return v_[1] ; }
+
+        /// Returns the numerical value \f$c\f$ of this TFXY-U(1)-rotation gate.
+        inline T c() const { return v_[2] ; }
+
+        /// Returns the numerical value \f$d = 0\f$ of this TFXY-U(1)-rotation
+        /// gate.
+        inline T d() const { return 0 ; }
+
+        /// Returns the numerical values of this TFXY-U(1)-rotation gate.
+        inline const std::array< T , 3 >& values() const { return v_ ; }
+
+        /**
+         * \brief Returns the values \f$\theta_0, \ldots, \theta_5\f$ of the
+         *        transverse field 2-axes rotation gate with the same matrix as
+         *        this TFXY-U(1)-rotation gate, see RotationTFXYMatrix::thetas.
+         */
+        std::array< real_type , 6 > thetas() const {
+          return RotationTFXYMatrix< T >( v_[0] , v_[1] , v_[2] , 0 ).thetas();
+        }
+
+        /// Updates this TFXY-U(1)-rotation gate with the given parameters.
+        inline void update( const T a , const T b , const T c ) {
+          v_[0] = a ;
+          v_[1] = b ;
+          v_[2] = c ;
+        }
+
+        /// Multiplies `rhs` to this 2-qubit TFXY-U(1)-rotation gate.
+        inline RotationTFXYU1Matrix< T >& operator*=(
+                                        const RotationTFXYU1Matrix< T >& rhs ) {
+          assert( this->qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( this->qubitPair()[1] == rhs.qubitPair()[1] ) ;
+          update( rhs.a() * a() ,
+                  rhs.b() * b() - std::conj( rhs.c() ) * c() ,
+                  rhs.c() * b() + std::conj( rhs.b() ) * c() ) ;
+          return *this ;
+        }
+
+        /// Multiplies `lhs` and `rhs`.
+        friend RotationTFXYU1Matrix< T > operator*(
+                                        RotationTFXYU1Matrix< T > lhs ,
+                                        const RotationTFXYU1Matrix< T >& rhs ) {
+          assert( lhs.qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( lhs.qubitPair()[1] == rhs.qubitPair()[1] ) ;
+          lhs *= rhs ;
+          return lhs ;
+        }
+
+      protected:
+        /// Qubits of this TFXY-U(1)-rotation gate.
+        std::array< int , 2 >  qubits_ ;
+        /// Complex values a, b, c of this TFXY-U(1)-rotation gate.
+        std::array< T , 3 >    v_ ;
+
+    } ; // class RotationTFXYU1Matrix
+
+  } // namespace qgates
+
+} // namespace f3c
+
+#endif
@@ -164,6 +164,18 @@ namespace f3c {
           return 0 ;
         }
 
+        /**
+         * \brief Appends the QASM code of this TFXZ-rotation gate to the given
+         *        `buffer`.
+         */
+        void toQASM( io::QASMBuffer& buffer , const int offset = 0 ) const {
+          qasmTFRxz( buffer , this->qubits_[0] + offset ,
+                             this->qubits_[1] + offset ,
+                             this->theta0() , this->theta1() ,
+                             this->theta2() , this->theta3() ,
+                             this->theta4() , this->theta5() ) ;
+        }
+
         // operator==
 
         // operator!=
@@ -201,8 +213,8 @@ namespace f3c {
 
         /// Multiplies `rhs` to this 2-qubit TFXZ-rotation gate.
         inline RotationTFXZ< T >& operator*=( const RotationTFXZ< T >& rhs ) {
-          assert( this->qubits()[0] == rhs.qubits()[0] ) ;
-          assert( this->qubits()[1] == rhs.qubits()[1] ) ;
+          assert( this->qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( this->qubitPair()[1] == rhs.qubitPair()[1] ) ;
           using TFXYMatrix = RotationTFXYMatrix< T > ;
           // fuse
           RotationTFXYMatrix< T > matrix( *this ) ;
@@ -221,8 +233,8 @@ namespace f3c {
         /// Multiplies `lhs` and `rhs`.
         friend RotationTFXZ< T > operator*( RotationTFXZ< T > lhs ,
                                             const RotationTFXZ< T >& rhs ) {
-          assert( lhs.qubits()[0] == rhs.qubits()[0] ) ;
-          assert( lhs.qubits()[1] == rhs.qubits()[1] ) ;
+          assert( lhs.qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( lhs.qubitPair()[1] == rhs.qubitPair()[1] ) ;
           lhs *= rhs ;
           return lhs ;
         }
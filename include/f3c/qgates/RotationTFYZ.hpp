@@ -174,6 +174,18 @@ namespace f3c {
           return 0 ;
         }
 
+        /**
+         * \brief Appends the QASM code of this TFYZ-rotation gate to the given
+         *        `buffer`.
+         */
+        void toQASM( io::QASMBuffer& buffer , const int offset = 0 ) const {
+          qasmTFRyz( buffer , this->qubits_[0] + offset ,
+                             this->qubits_[1] + offset ,
+                             this->theta0() , this->theta1() ,
+                             this->theta2() , this->theta3() ,
+                             this->theta4() , this->theta5() ) ;
+        }
+
         // operator==
 
         // operator!=
@@ -211,8 +223,8 @@ namespace f3c {
 
         /// Multiplies `rhs` to this 2-qubit TFYZ-rotation gate.
         inline RotationTFYZ< T >& operator*=( const RotationTFYZ< T >& rhs ) {
-          assert( this->qubits()[0] == rhs.qubits()[0] ) ;
-          assert( this->qubits()[1] == rhs.qubits()[1] ) ;
+          assert( this->qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( this->qubitPair()[1] == rhs.qubitPair()[1] ) ;
           using TFXYMatrix = RotationTFXYMatrix< T > ;
           // fuse
           RotationTFXYMatrix< T > matrix( *this ) ;
@@ -231,8 +243,8 @@ namespace f3c {
         /// Multiplies `lhs` and `rhs`.
         friend RotationTFYZ< T > operator*( RotationTFYZ< T > lhs ,
                                             const RotationTFYZ< T >& rhs ) {
-          assert( lhs.qubits()[0] == rhs.qubits()[0] ) ;
-          assert( lhs.qubits()[1] == rhs.qubits()[1] ) ;
+          assert( lhs.qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( lhs.qubitPair()[1] == rhs.qubitPair()[1] ) ;
           lhs *= rhs ;
           return lhs ;
         }
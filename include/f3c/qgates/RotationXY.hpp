@@ -108,13 +108,24 @@ namespace f3c {
         /// Writes the QASM code of this XY-rotation gate to the given `stream`.
         int toQASM( std::ostream& stream ,
                     const int offset = 0 ) const override {
-          auto qubits = this->qubits() ;
+          const auto& qubits = this->qubitPair() ;
           auto [ theta0 , theta1 ] = this->thetas() ;
           stream << qasmRxy( qubits[0] + offset , qubits[1] + offset ,
                              theta0 , theta1 ) ;
           return 0 ;
         }
 
+        /**
+         * \brief Appends the QASM code of this XY-rotation gate to the given
+         *        `buffer`.
+         */
+        void toQASM( io::QASMBuffer& buffer , const int offset = 0 ) const {
+          const auto& qubits = this->qubitPair() ;
+          auto [ theta0 , theta1 ] = this->thetas() ;
+          qasmRxy( buffer , qubits[0] + offset , qubits[1] + offset ,
+                   theta0 , theta1 ) ;
+        }
+
         // operator==
 
         // operator!=
@@ -140,8 +151,8 @@ namespace f3c {
 
         /// Multiplies `rhs` to this 2-qubit XY-rotation gate.
         inline RotationXY< T >& operator*=( const RotationXY< T >& rhs ) {
-          assert( this->qubits()[0] == rhs.qubits()[0] ) ;
-          assert( this->qubits()[1] == rhs.qubits()[1] ) ;
+          assert( this->qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( this->qubitPair()[1] == rhs.qubitPair()[1] ) ;
           this->rotations_[0] *= rhs.rotations_[0] ;
           this->rotations_[1] *= rhs.rotations_[1] ;
           return *this ;
@@ -149,8 +160,8 @@ namespace f3c {
 
         /// Multiplies the inverse of `rhs` to this 2-qubit XY-rotation gate.
         inline RotationXY< T >& operator/=( const RotationXY< T >& rhs ) {
-          assert( this->qubits()[0] == rhs.qubits()[0] ) ;
-          assert( this->qubits()[1] == rhs.qubits()[1] ) ;
+          assert( this->qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( this->qubitPair()[1] == rhs.qubitPair()[1] ) ;
           this->rotations_[0] /= rhs.rotations_[0] ;
           this->rotations_[1] /= rhs.rotations_[1] ;
           return *this ;
@@ -159,8 +170,8 @@ namespace f3c {
         /// Multiplies `lhs` and `rhs`.
         friend RotationXY< T > operator*( RotationXY< T > lhs ,
                                           const RotationXY< T >& rhs ) {
-          assert( lhs.qubits()[0] == rhs.qubits()[0] ) ;
-          assert( lhs.qubits()[1] == rhs.qubits()[1] ) ;
+          assert( lhs.qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( lhs.qubitPair()[1] == rhs.qubitPair()[1] ) ;
           lhs *= rhs ;
           return lhs ;
         }
@@ -168,8 +179,8 @@ namespace f3c {
         /// Multiplies `lhs` and the inverse of `rhs`.
         friend RotationXY< T > operator/( RotationXY< T > lhs ,
                                           const RotationXY< T >& rhs ) {
-          assert( lhs.qubits()[0] == rhs.qubits()[0] ) ;
-          assert( lhs.qubits()[1] == rhs.qubits()[1] ) ;
+          assert( lhs.qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( lhs.qubitPair()[1] == rhs.qubitPair()[1] ) ;
           lhs /= rhs ;
           return lhs ;
         }
@@ -104,13 +104,24 @@ namespace f3c {
         /// Writes the QASM code of this YZ-rotation gate to the given `stream`.
         int toQASM( std::ostream& stream ,
                     const int offset = 0 ) const override {
-          auto qubits = this->qubits() ;
+          const auto& qubits = this->qubitPair() ;
           auto [ theta0 , theta1 ] = this->thetas() ;
           stream << qasmRyz( qubits[0] + offset , qubits[1] + offset ,
                              theta0 , theta1 ) ;
           return 0 ;
         }
 
+        /**
+         * \brief Appends the QASM code of this YZ-rotation gate to the given
+         *        `buffer`.
+         */
+        void toQASM( io::QASMBuffer& buffer , const int offset = 0 ) const {
+          const auto& qubits = this->qubitPair() ;
+          auto [ theta0 , theta1 ] = this->thetas() ;
+          qasmRyz( buffer , qubits[0] + offset , qubits[1] + offset ,
+                   theta0 , theta1 ) ;
+        }
+
         // operator==
 
         // operator!=
@@ -136,8 +147,8 @@ namespace f3c {
 
         /// Multiplies `rhs` to this 2-qubit YZ-rotation gate.
         inline RotationYZ< T >& operator*=( const RotationYZ< T >& rhs ) {
-          assert( this->qubits()[0] == rhs.qubits()[0] ) ;
-          assert( this->qubits()[1] == rhs.qubits()[1] ) ;
+          assert( this->qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( this->qubitPair()[1] == rhs.qubitPair()[1] ) ;
           this->rotations_[0] *= rhs.rotations_[0] ;
           this->rotations_[1] *= rhs.rotations_[1] ;
           return *this ;
@@ -145,8 +156,8 @@ namespace f3c {
 
         /// Multiplies the inverse of `rhs` to this 2-qubit YZ-rotation gate.
         inline RotationYZ< T >& operator/=( const RotationYZ< T >& rhs ) {
-          assert( this->qubits()[0] == rhs.qubits()[0] ) ;
-          assert( this->qubits()[1] == rhs.qubits()[1] ) ;
+          assert( this->qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( this->qubitPair()[1] == rhs.qubitPair()[1] ) ;
           this->rotations_[0] /= rhs.rotations_[0] ;
           this->rotations_[1] /= rhs.rotations_[1] ;
           return *this ;
@@ -155,8 +166,8 @@ namespace f3c {
         /// Multiplies `lhs` and `rhs`.
         friend RotationYZ< T > operator*( RotationYZ< T > lhs ,
                                           const RotationYZ< T >& rhs ) {
-          assert( lhs.qubits()[0] == rhs.qubits()[0] ) ;
-          assert( lhs.qubits()[1] == rhs.qubits()[1] ) ;
+          assert( lhs.qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( lhs.qubitPair()[1] == rhs.qubitPair()[1] ) ;
           lhs *= rhs ;
           return lhs ;
         }
@@ -164,8 +175,8 @@ namespace f3c {
         /// Multiplies `lhs` and the inverse of `rhs`.
         friend RotationYZ< T > operator/( RotationYZ< T > lhs ,
                                           const RotationYZ< T >& rhs ) {
-          assert( lhs.qubits()[0] == rhs.qubits()[0] ) ;
-          assert( lhs.qubits()[1] == rhs.qubits()[1] ) ;
+          assert( lhs.qubitPair()[0] == rhs.qubitPair()[0] ) ;
+          assert( lhs.qubitPair()[1] == rhs.qubitPair()[1] ) ;
           lhs /= rhs ;
           return lhs ;
         }
@@ -88,26 +88,12 @@ namespace f3c {
         TFTwoAxesQRotationGate2( const RotationTFXYMatrix< T >& gate )
         {
           // qubits
-          setQubits( &(gate.qubits()[0]) ) ;
+          setQubits( gate.qubitPair().data() ) ;
           // rotations
-          const T a = gate.a() ;
-          const T b = gate.b() ;
-          const T c = gate.c() ;
-          const T d = gate.d() ;
-          using R = real_type ;
-          const R arga = std::arg( a ) ;
-          const R argb = std::arg( b ) ;
-          const R argc = std::arg( c ) ;
-          const R argd = std::arg( d ) ;
-          const R pi = 4 * std::atan(1) ;
-          const R theta1 = std::atan2( std::abs(c) , std::abs(b) ) ;
-          const R theta2 = std::atan2( std::abs(d) , std::abs(a) ) ;
-          rot_[0] = rotation_type( ( -arga - argb - argc - argd - pi ) / 2 ) ;
-          rot_[1] = rotation_type( ( -arga + argb + argc - argd      ) / 2 ) ;
-          rot_[2] = rotation_type( theta1 + theta2 ) ;
-          rot_[3] = rotation_type( theta1 - theta2 ) ;
-          rot_[4] = rotation_type( ( -arga - argb + argc + argd + pi ) / 2 ) ;
-          rot_[5] = rotation_type( ( -arga + argb - argc + argd      ) / 2 ) ;
+          const auto theta = gate.thetas() ;
+          for ( int i = 0; i < 6; i++ ) {
+            rot_[i] = rotation_type( theta[i] ) ;
+          }
         } // TFTwoAxesQRotationGate2(gate)
 
         // nbQubits
@@ -134,6 +120,14 @@ namespace f3c {
           return std::vector< int >( { qubits_[0] , qubits_[1] } ) ;
         }
 
+        /**
+         * \brief Returns the qubits of this transverse field 2-axes rotation
+         *        gate in ascending order without allocating a vector.
+         */
+        inline const std::array< int , 2 >& qubitPair() const {
+          return qubits_ ;
+        }
+
         /// Sets the qubits of this transverse field 2-axes rotation gate.
         inline void setQubits( const int* qubits ) override {
           assert( qubits[0] >= 0 ) ; assert( qubits[1] >= 0 ) ;
@@ -79,6 +79,14 @@ namespace f3c {
           return std::vector< int >( { qubits_[0] , qubits_[1] } ) ;
         }
 
+        /**
+         * \brief Returns the qubits of this 2-axes rotation gate in ascending
+         *        order without allocating a vector.
+         */
+        inline const std::array< int , 2 >& qubitPair() const {
+          return qubits_ ;
+        }
+
         /// Sets the qubits of this 2-axes rotation gate.
         inline void setQubits( const int* qubits ) override {
           assert( qubits[0] >= 0 ) ; assert( qubits[1] >= 0 ) ;
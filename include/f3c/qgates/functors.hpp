@@ -10,15 +10,64 @@
 #include "f3c/qgates/RotationTFXZ.hpp"
 #include "f3c/qgates/RotationTFYZ.hpp"
 #include "f3c/qgates/RotationTFXYMatrix.hpp"
+#include "f3c/qgates/RotationTFXYU1Matrix.hpp"
+#include "f3c/qgates/RotationTFIM.hpp"
+#include "f3c/qasm.hpp"
 #include <memory>
+#include <ostream>
+#include <array>
+#include <tuple>
 
 namespace f3c {
 
   namespace qgates {
 
+    /**
+     * \brief Base of the functors F that composes the QASM of a circuit from
+     *        the QASM of its gates.
+     *
+     * The functor F provides the number of QASM angles of a gate `nbAngles`
+     * and the QASM of a gate with given angles,
+     * `toQASM( gate , theta , offset , buffer )`, and brings the `toQASM` of
+     * this base into its scope.
+     */
+    template <typename F>
+    struct QASMfunctor {
+
+      /// Writes the QASM of the gates of the circuit `circuit` to `stream`.
+      template <typename C>
+      static void toQASM( const C& circuit , std::ostream& stream ) {
+        circuit.toQASM( stream ) ;
+      }
+
+      /// Appends the QASM of the circuit `circuit` to `buffer`.
+      template <typename C>
+      static void toQASM( const C& circuit , io::QASMBuffer& buffer ) {
+        const int offset = circuit.offset() ;
+        io::renderQASM( buffer , circuit.nbGates() ,
+                        [&]( io::QASMBuffer& part , const size_t k ) {
+          const auto& gate = *circuit[k] ;
+          F::toQASM( gate , F::angles( gate ) , offset , part ) ;
+        } ) ;
+      }
+
+      /// Returns the `F::nbAngles` QASM angles of the gate `gate`.
+      template <typename G>
+      static auto angles( const G& gate ) {
+        if constexpr ( F::nbAngles == 1 ) {
+          return std::array{ gate.theta() } ;
+        } else {
+          return std::apply( []( const auto... theta ) {
+            return std::array{ theta... } ;
+          } , gate.thetas() ) ;
+        }
+      }
+
+    } ; // QASMfunctor
+
     /// XY functor.
     template <typename T>
-    struct XYfunctor {
+    struct XYfunctor : QASMfunctor< XYfunctor< T > > {
 
       /// Value type of this XY functor.
       using value_type = T ;
@@ -59,11 +108,45 @@ namespace f3c {
         }
       }
 
+      /**
+       * \brief Returns the coefficients { h , J_0 , J_1 } of the XY frame
+       *        Hamiltonian \f$h Z + J_0 XX + J_1 YY\f$ of a timestep.
+       *
+       * The XY Hamiltonian \f$J_x XX + J_y YY\f$ is in the XY frame and has
+       * no field.
+       */
+      template <typename R>
+      static std::array< R , 3 > coefficients( const R , const R ,
+                                               const R , const R Jx ,
+                                               const R Jy , const R ) {
+        return { 0 , Jx , Jy } ;
+      }
+
+      /// QASM of the XY circuits, see QASMfunctor.
+      using QASMfunctor< XYfunctor >::toQASM ;
+
+      /// Number of QASM angles of a XY gate.
+      static constexpr int nbAngles = 2 ;
+
+      /**
+       * \brief Appends the QASM of the XY gate `gate` with the angles
+       *        `theta` to `buffer`. The angles are either real or symbolic,
+       *        see io::QASMParameter.
+       */
+      template <typename G, typename A>
+      static void toQASM( const G& gate ,
+                          const std::array< A , nbAngles >& theta ,
+                          const int offset , io::QASMBuffer& buffer ) {
+        const auto& qubits = gate.qubitPair() ;
+        qasmRxy( buffer , qubits[0] + offset , qubits[1] + offset ,
+                 theta[0] , theta[1] ) ;
+      }
+
     } ; // XYfunctor
 
     /// XZ functor.
     template <typename T>
-    struct XZfunctor {
+    struct XZfunctor : QASMfunctor< XZfunctor< T > > {
 
       /// Value type of this XZ functor.
       using value_type = T ;
@@ -104,11 +187,46 @@ namespace f3c {
         }
       }
 
+      /**
+       * \brief Returns the coefficients { h , J_0 , J_1 } of the XZ
+       *        Hamiltonian \f$J_x XX + J_z ZZ\f$ of a timestep in the XY
+       *        frame.
+       *
+       * The XZ gates use the Jordan-Wigner string Y, such that Z takes the
+       * role of Y and \f$J_z\f$ is the YY coupling of the XY frame.
+       */
+      template <typename R>
+      static std::array< R , 3 > coefficients( const R , const R ,
+                                               const R , const R Jx ,
+                                               const R , const R Jz ) {
+        return { 0 , Jx , Jz } ;
+      }
+
+      /// QASM of the XZ circuits, see QASMfunctor.
+      using QASMfunctor< XZfunctor >::toQASM ;
+
+      /// Number of QASM angles of a XZ gate.
+      static constexpr int nbAngles = 2 ;
+
+      /**
+       * \brief Appends the QASM of the XZ gate `gate` with the angles
+       *        `theta` to `buffer`. The angles are either real or symbolic,
+       *        see io::QASMParameter.
+       */
+      template <typename G, typename A>
+      static void toQASM( const G& gate ,
+                          const std::array< A , nbAngles >& theta ,
+                          const int offset , io::QASMBuffer& buffer ) {
+        const auto& qubits = gate.qubitPair() ;
+        qasmRxz( buffer , qubits[0] + offset , qubits[1] + offset ,
+                 theta[0] , theta[1] ) ;
+      }
+
     } ; // XZfunctor
 
     /// YZ functor.
     template <typename T>
-    struct YZfunctor {
+    struct YZfunctor : QASMfunctor< YZfunctor< T > > {
 
       /// Value type of this YZ functor.
       using value_type = T ;
@@ -149,12 +267,48 @@ namespace f3c {
         }
       }
 
+      /**
+       * \brief Returns the coefficients { h , J_0 , J_1 } of the YZ
+       *        Hamiltonian \f$J_y YY + J_z ZZ\f$ of a timestep in the XY
+       *        frame.
+       *
+       * The YZ gates use the Jordan-Wigner string X, such that Y and Z take
+       * the roles of X and Y, and \f$J_y\f$ and \f$J_z\f$ are the XX and YY
+       * couplings of the XY frame.
+       */
+      template <typename R>
+      static std::array< R , 3 > coefficients( const R , const R ,
+                                               const R , const R ,
+                                               const R Jy , const R Jz ) {
+        return { 0 , Jy , Jz } ;
+      }
+
+      /// QASM of the YZ circuits, see QASMfunctor.
+      using QASMfunctor< YZfunctor >::toQASM ;
+
+      /// Number of QASM angles of a YZ gate.
+      static constexpr int nbAngles = 2 ;
+
+      /**
+       * \brief Appends the QASM of the YZ gate `gate` with the angles
+       *        `theta` to `buffer`. The angles are either real or symbolic,
+       *        see io::QASMParameter.
+       */
+      template <typename G, typename A>
+      static void toQASM( const G& gate ,
+                          const std::array< A , nbAngles >& theta ,
+                          const int offset , io::QASMBuffer& buffer ) {
+        const auto& qubits = gate.qubitPair() ;
+        qasmRyz( buffer , qubits[0] + offset , qubits[1] + offset ,
+                 theta[0] , theta[1] ) ;
+      }
+
     } ; // YZfunctor
 
 
     /// TFXY functor.
     template <typename T>
-    struct TFXYfunctor {
+    struct TFXYfunctor : QASMfunctor< TFXYfunctor< T > > {
 
       /// Value type of this TFXY functor.
       using value_type = T ;
@@ -215,11 +369,232 @@ namespace f3c {
         }
       }
 
+      /**
+       * \brief Returns the coefficients { h , J_0 , J_1 } of the TFXY
+       *        Hamiltonian \f$h_z Z + J_x XX + J_y YY\f$ of a timestep.
+       *
+       * The TFXY Hamiltonian is the Hamiltonian of the XY frame.
+       */
+      template <typename R>
+      static std::array< R , 3 > coefficients( const R , const R ,
+                                               const R hz , const R Jx ,
+                                               const R Jy , const R ) {
+        return { hz , Jx , Jy } ;
+      }
+
+      /// QASM of the TFXY circuits, see QASMfunctor.
+      using QASMfunctor< TFXYfunctor >::toQASM ;
+
+      /// Number of QASM angles of a TFXY gate.
+      static constexpr int nbAngles = 6 ;
+
+      /**
+       * \brief Appends the QASM of the TFXY gate `gate` with the angles
+       *        `theta` to `buffer`. The angles are either real or symbolic,
+       *        see io::QASMParameter.
+       */
+      template <typename G, typename A>
+      static void toQASM( const G& gate ,
+                          const std::array< A , nbAngles >& theta ,
+                          const int offset , io::QASMBuffer& buffer ) {
+        const auto& qubits = gate.qubitPair() ;
+        qasmTFRxy( buffer , qubits[0] + offset , qubits[1] + offset ,
+                  theta[0] , theta[1] , theta[2] ,
+                  theta[3] , theta[4] , theta[5] ) ;
+      }
+
     } ; // TFXYfunctor
 
+    /**
+     * \brief TFXY functor for the particle number conserving TFXY model with
+     *        \f$J_x = J_y\f$.
+     */
+    template <typename T>
+    struct TFXYU1functor : QASMfunctor< TFXYU1functor< T > > {
+
+      /// Value type of this TFXY-U(1) functor.
+      using value_type = T ;
+      /// Gate type of this TFXY-U(1) functor.
+      using gate_type = f3c::qgates::RotationTFXYU1Matrix< T > ;
+      /// QASM gate type of this TFXY-U(1) functor.
+      using qasm_gate_type = gate_type ;
+
+      /// Returns a unique pointer to a random TFXY-U(1) matrix gate.
+      template <typename D, typename G>
+      constexpr static inline
+      std::unique_ptr< gate_type > init( const int q , D& dis , G& gen ) {
+        const auto r1 = dis( gen ) ;
+        const auto r2 = std::sqrt( 1 - r1*r1 ) ;
+        const auto theta0 = dis( gen ) ;
+        const auto theta1 = dis( gen ) ;
+        const auto theta2 = dis( gen ) ;
+        const T a( std::cos( theta0 ) , std::sin( theta0 ) ) ;
+        const T b( r1 * std::cos( theta1 ) , r1 * std::sin( theta1 ) ) ;
+        const T c( r2 * std::cos( theta2 ) , r2 * std::sin( theta2 ) ) ;
+        return std::make_unique< gate_type >( q , q+1 , a , b , c ) ;
+      }
+
+      /// Constructs 1 timestep with the given parameters.
+      template <typename R, typename C>
+      static void timestep( const R dt , const R hx , const R hy , const R hz ,
+                            const R Jx , const R Jy , const R Jz , C& circuit ){
+        assert( dt > 0 ) ;  assert( Jz == 0 ) ;
+        assert( hx == 0 ) ; assert( hy == 0 ) ; assert( Jx == Jy ) ;
+        const int n = circuit.nbQubits() ;
+        assert( circuit.nbGates() == size_t( n - 1 ) ) ;
+        // angles
+        const auto tJ  = 2*dt*Jx ;
+        const auto thz = 2*dt*hz ;
+        // 1st layer
+        #pragma omp parallel for
+        for ( int i = 0; i < n/2; i++ ) {
+          const int q = 2*i ;
+          circuit[i] = std::make_unique< gate_type >( q , q+1 ,
+                                               thz , thz , tJ  , tJ  , 0 , 0 ) ;
+        }
+        // 2nd layer
+        #pragma omp parallel for
+        for ( int i = 0; i < n/2-1; i++ ) {
+          const int q = 2*i + 1 ;
+          circuit[n/2+i] = std::make_unique< gate_type >( q , q+1 ,
+                                               0   , 0   , tJ  , tJ  , 0 , 0 ) ;
+        }
+        if ( n % 2 == 1 ) {
+          const int q = n - 2 ;
+          circuit[n - 2] = std::make_unique< gate_type >( q , q+1 ,
+                                               0   , thz , tJ  , tJ  , 0 , 0 ) ;
+        }
+      }
+
+      /**
+       * \brief Returns the coefficients { h , J_0 , J_1 } of the particle
+       *        number conserving TFXY Hamiltonian
+       *        \f$h_z Z + J_x ( XX + YY )\f$ of a timestep.
+       *
+       * This is the Hamiltonian of the XY frame with equal couplings
+       * \f$J_x = J_y\f$.
+       */
+      template <typename R>
+      static std::array< R , 3 > coefficients( const R , const R ,
+                                               const R hz , const R Jx ,
+                                               const R Jy , const R ) {
+        return { hz , Jx , Jy } ;
+      }
+
+      /// QASM of the TFXY-U(1) circuits, see QASMfunctor.
+      using QASMfunctor< TFXYU1functor >::toQASM ;
+
+      /// Number of QASM angles of a TFXY-U(1) gate.
+      static constexpr int nbAngles = 6 ;
+
+      /**
+       * \brief Appends the QASM of the TFXY-U(1) gate `gate` with the angles
+       *        `theta` to `buffer`. The angles are either real or symbolic,
+       *        see io::QASMParameter.
+       */
+      template <typename G, typename A>
+      static void toQASM( const G& gate ,
+                          const std::array< A , nbAngles >& theta ,
+                          const int offset , io::QASMBuffer& buffer ) {
+        const auto& qubits = gate.qubitPair() ;
+        qasmTFRxy( buffer , qubits[0] + offset , qubits[1] + offset ,
+                  theta[0] , theta[1] , theta[2] ,
+                  theta[3] , theta[4] , theta[5] ) ;
+      }
+
+    } ; // TFXYU1functor
+
+    /**
+     * \brief TFIM functor.
+     *
+     * The circuits of this functor act on the 2N Majorana modes of N qubits,
+     * see RotationTFIM. A timestep is the same brickwork of 2N-1 gates as for
+     * the other functors, on the modes instead of the qubits.
+     */
+    template <typename T>
+    struct TFIMfunctor : QASMfunctor< TFIMfunctor< T > > {
+
+      /// Value type of this TFIM functor.
+      using value_type = T ;
+      /// Gate type of this TFIM functor.
+      using gate_type = f3c::qgates::RotationTFIM< T > ;
+      /// QASM gate type of this TFIM functor.
+      using qasm_gate_type = gate_type ;
+
+      /// Returns a unique pointer to a random TFIM-rotation gate.
+      template <typename D, typename G>
+      constexpr static inline
+      std::unique_ptr< gate_type > init( const int q , D& dis , G& gen ) {
+        return std::make_unique< gate_type >( q , q+1 , dis(gen) ) ;
+      }
+
+      /// Constructs 1 timestep with the given parameters.
+      template <typename R, typename C>
+      static void timestep( const R dt , const R hx , const R hy , const R hz ,
+                            const R Jx , const R Jy , const R Jz , C& circuit ){
+        assert( dt > 0 ) ;  assert( Jy == 0 ) ; assert( Jz == 0 ) ;
+        assert( hx == 0 ) ; assert( hy == 0 ) ;
+        const int n = circuit.nbQubits() ;
+        assert( n % 2 == 0 ) ;
+        assert( circuit.nbGates() == size_t( n - 1 ) ) ;
+        // angles
+        const auto tJx = 2*dt*Jx ;
+        const auto thz = 2*dt*hz ;
+        // 1st layer: Z-rotations
+        #pragma omp parallel for
+        for ( int i = 0; i < n/2; i++ ) {
+          const int q = 2*i ;
+          circuit[i] = std::make_unique< gate_type >( q , q+1 , thz ) ;
+        }
+        // 2nd layer: XX-rotations
+        #pragma omp parallel for
+        for ( int i = 0; i < n/2-1; i++ ) {
+          const int q = 2*i + 1 ;
+          circuit[n/2+i] = std::make_unique< gate_type >( q , q+1 , tJx ) ;
+        }
+      }
+
+      /**
+       * \brief Returns the coefficients { h , J_0 , J_1 } of the TFIM
+       *        Hamiltonian \f$h_z Z + J_x XX\f$ of a timestep.
+       *
+       * This is the Hamiltonian of the XY frame without YY coupling.
+       */
+      template <typename R>
+      static std::array< R , 3 > coefficients( const R , const R ,
+                                               const R hz , const R Jx ,
+                                               const R , const R ) {
+        return { hz , Jx , 0 } ;
+      }
+
+      /// QASM of the TFIM circuits, see QASMfunctor.
+      using QASMfunctor< TFIMfunctor >::toQASM ;
+
+      /// Number of QASM angles of a TFIM gate.
+      static constexpr int nbAngles = 1 ;
+
+      /**
+       * \brief Appends the QASM of the TFIM gate `gate` with the angles
+       *        `theta` to `buffer`. The angles are either real or symbolic,
+       *        see io::QASMParameter.
+       */
+      template <typename G, typename A>
+      static void toQASM( const G& gate ,
+                          const std::array< A , nbAngles >& theta ,
+                          const int offset , io::QASMBuffer& buffer ) {
+        const int q = gate.qubitPair()[0] / 2 + offset ;
+        if ( gate.isXX() ) {
+          qasmRxx( buffer , q , q + 1 , theta[0] ) ;
+        } else {
+          buffer.rz( q , theta[0] ) ;
+        }
+      }
+
+    } ; // TFIMfunctor
+
     /// TFXZ functor.
     template <typename T>
-    struct TFXZfunctor {
+    struct TFXZfunctor : QASMfunctor< TFXZfunctor< T > > {
 
       /// Value type of this TFXZ functor.
       using value_type = T ;
@@ -280,11 +655,70 @@ namespace f3c {
         }
       }
 
+      /**
+       * \brief Returns the coefficients { h , J_0 , J_1 } of the TFXZ
+       *        Hamiltonian \f$h_y Y + J_x XX + J_z ZZ\f$ of a timestep in
+       *        the XY frame.
+       *
+       * The TFXZ circuit is a TFXY circuit in the basis where Y and Z are
+       * swapped, such that \f$h_y\f$ is the field and \f$J_z\f$ the YY
+       * coupling of the XY frame.
+       */
+      template <typename R>
+      static std::array< R , 3 > coefficients( const R , const R hy ,
+                                               const R , const R Jx ,
+                                               const R , const R Jz ) {
+        return { hy , Jx , Jz } ;
+      }
+
+      /// QASM of the TFXZ circuits, see QASMfunctor.
+      using QASMfunctor< TFXZfunctor >::toQASM ;
+
+      /**
+       * \brief Writes the QASM of the TFXY matrix circuit `circuit` to
+       *        `stream` as TFXZ-rotation gates.
+       *
+       * The angles are computed from the matrix gates at emission time,
+       * without constructing intermediate TFXZ-rotation gates.
+       */
+      template <typename C>
+      static void toQASM( const C& circuit , std::ostream& stream ) {
+        const int offset = circuit.offset() ;
+        for ( auto it = circuit.begin(); it != circuit.end(); ++it ) {
+          const auto& qubits = (*it)->qubitPair() ;
+          const auto theta = (*it)->thetas() ;
+          stream << qasmTFRxz( qubits[0] + offset , qubits[1] + offset ,
+                               theta[0] , theta[1] , theta[2] ,
+                               theta[3] , theta[4] , theta[5] ) ;
+        }
+      }
+
+      /// Number of QASM angles of a TFXZ gate.
+      static constexpr int nbAngles = 6 ;
+
+      /**
+       * \brief Appends the QASM of the TFXZ gate `gate` with the angles
+       *        `theta` to `buffer`. The angles are either real or symbolic,
+       *        see io::QASMParameter.
+       *
+       * The TFXY matrix gate `gate` is emitted as TFXZ-rotation gate with the
+       * basis changes of qasmTFRxz.
+       */
+      template <typename G, typename A>
+      static void toQASM( const G& gate ,
+                          const std::array< A , nbAngles >& theta ,
+                          const int offset , io::QASMBuffer& buffer ) {
+        const auto& qubits = gate.qubitPair() ;
+        qasmTFRxz( buffer , qubits[0] + offset , qubits[1] + offset ,
+                  theta[0] , theta[1] , theta[2] ,
+                  theta[3] , theta[4] , theta[5] ) ;
+      }
+
     } ; // TFXZfunctor
 
     /// TFYZ functor.
     template <typename T>
-    struct TFYZfunctor {
+    struct TFYZfunctor : QASMfunctor< TFYZfunctor< T > > {
 
       /// Value type of this TFYZ functor.
       using value_type = T ;
@@ -345,6 +779,65 @@ namespace f3c {
         }
       }
 
+      /**
+       * \brief Returns the coefficients { h , J_0 , J_1 } of the TFYZ
+       *        Hamiltonian \f$h_x X + J_y YY + J_z ZZ\f$ of a timestep in
+       *        the XY frame.
+       *
+       * The TFYZ circuit is a TFXY circuit in the basis where X, Y and Z
+       * take the roles of Z, X and Y, such that \f$h_x\f$ is the field and
+       * \f$J_y\f$ and \f$J_z\f$ are the XX and YY couplings of the XY frame.
+       */
+      template <typename R>
+      static std::array< R , 3 > coefficients( const R hx , const R ,
+                                               const R , const R ,
+                                               const R Jy , const R Jz ) {
+        return { hx , Jy , Jz } ;
+      }
+
+      /// QASM of the TFYZ circuits, see QASMfunctor.
+      using QASMfunctor< TFYZfunctor >::toQASM ;
+
+      /**
+       * \brief Writes the QASM of the TFXY matrix circuit `circuit` to
+       *        `stream` as TFYZ-rotation gates.
+       *
+       * The angles are computed from the matrix gates at emission time,
+       * without constructing intermediate TFYZ-rotation gates.
+       */
+      template <typename C>
+      static void toQASM( const C& circuit , std::ostream& stream ) {
+        const int offset = circuit.offset() ;
+        for ( auto it = circuit.begin(); it != circuit.end(); ++it ) {
+          const auto& qubits = (*it)->qubitPair() ;
+          const auto theta = (*it)->thetas() ;
+          stream << qasmTFRyz( qubits[0] + offset , qubits[1] + offset ,
+                               theta[0] , theta[1] , theta[2] ,
+                               theta[3] , theta[4] , theta[5] ) ;
+        }
+      }
+
+      /// Number of QASM angles of a TFYZ gate.
+      static constexpr int nbAngles = 6 ;
+
+      /**
+       * \brief Appends the QASM of the TFYZ gate `gate` with the angles
+       *        `theta` to `buffer`. The angles are either real or symbolic,
+       *        see io::QASMParameter.
+       *
+       * The TFXY matrix gate `gate` is emitted as TFYZ-rotation gate with the
+       * basis changes of qasmTFRyz.
+       */
+      template <typename G, typename A>
+      static void toQASM( const G& gate ,
+                          const std::array< A , nbAngles >& theta ,
+                          const int offset , io::QASMBuffer& buffer ) {
+        const auto& qubits = gate.qubitPair() ;
+        qasmTFRyz( buffer , qubits[0] + offset , qubits[1] + offset ,
+                  theta[0] , theta[1] , theta[2] ,
+                  theta[3] , theta[4] , theta[5] ) ;
+      }
+
     } ; // TFYZfunctor
 
   } // namespace qgates
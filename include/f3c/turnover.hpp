@@ -7,6 +7,8 @@
 #include "f3c/concepts.hpp"
 #include "f3c/turnoverSU2.hpp"
 #include "f3c/qgates/RotationTFXYMatrix.hpp"
+#include "f3c/qgates/RotationTFXYU1Matrix.hpp"
+#include "f3c/qgates/RotationTFIM.hpp"
 
 namespace f3c {
 
@@ -21,9 +23,9 @@ namespace f3c {
   void turnover( const G1& gate1 ,
                  const G2& gate2 ,
                  const G1& gate3 ,
-                 std::unique_ptr< G2 >& gateA ,
-                 std::unique_ptr< G1 >& gateB ,
-                 std::unique_ptr< G2 >& gateC ) {
+                 G2& gateA ,
+                 G1& gateB ,
+                 G2& gateC ) {
 
     // checks
     const auto q = gate1.qubit() ;
@@ -36,9 +38,9 @@ namespace f3c {
                                                      gate3.rotation() ) ;
 
     // new gates
-    gateA = std::make_unique< G2 >( q , rotA ) ;
-    gateB = std::make_unique< G1 >( q , rotB ) ;
-    gateC = std::make_unique< G2 >( q , rotC ) ;
+    gateA = G2( q , rotA ) ;
+    gateB = G1( q , rotB ) ;
+    gateC = G2( q , rotC ) ;
 
   }
 
@@ -53,13 +55,13 @@ namespace f3c {
   void turnover( const G1& gate1 ,
                  const G2& gate2 ,
                  const G1& gate3 ,
-                 std::unique_ptr< G2 >& gateA ,
-                 std::unique_ptr< G1 >& gateB ,
-                 std::unique_ptr< G2 >& gateC ) {
+                 G2& gateA ,
+                 G1& gateB ,
+                 G2& gateC ) {
 
     // checks
     const auto q1 = gate1.qubit() ;
-    const auto q2 = gate2.qubits() ;
+    const auto q2 = f3c::qubitPair( gate2 ) ;
     assert( ( q1 == q2[0] ) || ( q1 == q2[1] ) ) ;
 
     // SU(2) turnover
@@ -68,9 +70,9 @@ namespace f3c {
                                                      gate3.rotation() ) ;
 
     // new gates
-    gateA = std::make_unique< G2 >( q2[0] , q2[1] , rotA ) ;
-    gateB = std::make_unique< G1 >( q1 , rotB ) ;
-    gateC = std::make_unique< G2 >( q2[0] , q2[1] , rotC ) ;
+    gateA = G2( q2[0] , q2[1] , rotA ) ;
+    gateB = G1( q1 , rotB ) ;
+    gateC = G2( q2[0] , q2[1] , rotC ) ;
 
   }
 
@@ -85,12 +87,12 @@ namespace f3c {
   void turnover( const G1& gate1 ,
                  const G2& gate2 ,
                  const G1& gate3 ,
-                 std::unique_ptr< G2 >& gateA ,
-                 std::unique_ptr< G1 >& gateB ,
-                 std::unique_ptr< G2 >& gateC ) {
+                 G2& gateA ,
+                 G1& gateB ,
+                 G2& gateC ) {
 
     // checks
-    const auto q1 = gate1.qubits() ;
+    const auto q1 = f3c::qubitPair( gate1 ) ;
     const auto q2 = gate2.qubit() ;
     assert( ( q1[0] == q2 ) || ( q1[1] == q2 ) ) ;
 
@@ -100,9 +102,9 @@ namespace f3c {
                                                      gate3.rotation() ) ;
 
     // new gates
-    gateA = std::make_unique< G2 >( q2 , rotA ) ;
-    gateB = std::make_unique< G1 >( q1[0] , q1[1] , rotB ) ;
-    gateC = std::make_unique< G2 >( q2 , rotC ) ;
+    gateA = G2( q2 , rotA ) ;
+    gateB = G1( q1[0] , q1[1] , rotB ) ;
+    gateC = G2( q2 , rotC ) ;
 
   }
 
@@ -117,15 +119,15 @@ namespace f3c {
   void turnover( const G1& gate1 ,
                  const G2& gate2 ,
                  const G1& gate3 ,
-                 std::unique_ptr< G2 >& gateA ,
-                 std::unique_ptr< G1 >& gateB ,
-                 std::unique_ptr< G2 >& gateC ) {
+                 G2& gateA ,
+                 G1& gateB ,
+                 G2& gateC ) {
 
     // checks
-    const auto q1 = gate1.qubits() ;
-    const auto q2 = gate2.qubits() ;
-    assert( q1[0] == gate3.qubits()[0] ) ;
-    assert( q1[1] == gate3.qubits()[1] ) ;
+    const auto q1 = f3c::qubitPair( gate1 ) ;
+    const auto q2 = f3c::qubitPair( gate2 ) ;
+    assert( q1[0] == f3c::qubitPair( gate3 )[0] ) ;
+    assert( q1[1] == f3c::qubitPair( gate3 )[1] ) ;
     assert( ( q2[0] == q1[1] ) || ( q2[1] == q1[0] ) ) ;
 
     // SU(2) turnover
@@ -134,9 +136,9 @@ namespace f3c {
                                                      gate3.rotation() ) ;
 
     // new gates
-    gateA = std::make_unique< G2 >( q2[0] , q2[1] , rotA ) ;
-    gateB = std::make_unique< G1 >( q1[0] , q1[1] , rotB ) ;
-    gateC = std::make_unique< G2 >( q2[0] , q2[1] , rotC ) ;
+    gateA = G2( q2[0] , q2[1] , rotA ) ;
+    gateB = G1( q1[0] , q1[1] , rotB ) ;
+    gateC = G2( q2[0] , q2[1] , rotC ) ;
 
   }
 
@@ -146,15 +148,15 @@ namespace f3c {
   void turnover( const G& gate1 ,
                  const G& gate2 ,
                  const G& gate3 ,
-                 std::unique_ptr< G >& gateA ,
-                 std::unique_ptr< G >& gateB ,
-                 std::unique_ptr< G >& gateC ) {
+                 G& gateA ,
+                 G& gateB ,
+                 G& gateC ) {
 
     // checks
-    const auto q1 = gate1.qubits() ;
-    const auto q2 = gate2.qubits() ;
-    assert( q1[0] == gate3.qubits()[0] ) ;
-    assert( q1[1] == gate3.qubits()[1] ) ;
+    const auto q1 = f3c::qubitPair( gate1 ) ;
+    const auto q2 = f3c::qubitPair( gate2 ) ;
+    assert( q1[0] == f3c::qubitPair( gate3 )[0] ) ;
+    assert( q1[1] == f3c::qubitPair( gate3 )[1] ) ;
     assert( ( q2[0] == q1[1] ) || ( q2[1] == q1[0] ) ) ;
 
     // 2 SU(2) turnovers
@@ -165,45 +167,26 @@ namespace f3c {
     const auto [ rotA1 , rotB1 , rotC1 ] = turnoverSU2( rot11 , rot20 , rot31 );
 
     // new gates
-    gateA = std::make_unique< G >( q2[0] , q2[1] , rotA1 , rotA0 ) ;
-    gateB = std::make_unique< G >( q1[0] , q1[1] , rotB0 , rotB1 ) ;
-    gateC = std::make_unique< G >( q2[0] , q2[1] , rotC1 , rotC0 ) ;
+    gateA = G( q2[0] , q2[1] , rotA1 , rotA0 ) ;
+    gateB = G( q1[0] , q1[1] , rotB0 , rotB1 ) ;
+    gateC = G( q2[0] , q2[1] , rotC1 , rotC0 ) ;
 
   }
 
-  /// Computes the turnover operation of 3 TFXY-rotation matrix gates.
-  template <typename T>
-  void turnover( const f3c::qgates::RotationTFXYMatrix< T >& gate1 ,
-                 const f3c::qgates::RotationTFXYMatrix< T >& gate2 ,
-                 const f3c::qgates::RotationTFXYMatrix< T >& gate3 ,
-              std::unique_ptr< f3c::qgates::RotationTFXYMatrix< T > >& gateA ,
-              std::unique_ptr< f3c::qgates::RotationTFXYMatrix< T > >& gateB ,
-              std::unique_ptr< f3c::qgates::RotationTFXYMatrix< T > >& gateC ) {
-
-    // checks
-    const auto q1 = gate1.qubits() ;
-    const auto q2 = gate2.qubits() ;
-    assert( q1[0] == gate3.qubits()[0] ) ;
-    assert( q1[1] == gate3.qubits()[1] ) ;
-    assert( ( q2[0] == q1[1] ) || ( q2[1] == q1[0] ) ) ;
-
-    // work arrays
-    std::array< T , 4 >  Q1 ;
-    std::array< T , 4 >  Q2 ;
-    std::array< T , 4 >  U ;
-    std::array< T , 4 >  V ;
-    std::array< T , 4 >  Y ;
-    std::array< T , 4 >  Z ;
-    std::array< T , 4 >  W ;
-    T* v ;
-
-    // gate values
-    const auto& v1 = gate1.values() ;
-    const auto& v2 = gate2.values() ;
-    const auto& v3 = gate3.values() ;
+  /**
+   * \brief Computes the matrix blocks `Q1` and `Q2` of the product of 3
+   *        TFXY-rotation matrix gates with values `v1`, `v2`, and `v3`.
+   *
+   * The flag `vee` is true if the gates form a vee, i.e., if the second gate
+   * acts on the qubits below the first and third gate, and false if they form
+   * a hat. It is a template parameter such that each orientation is compiled
+   * into its own branch-free kernel.
+   */
+  template <bool vee, typename T>
+  inline void blocksTFXY( const T* v1 , const T* v2 , const T* v3 ,
+                          T* Q1 , T* Q2 ) {
 
-    // matrix blocks
-    if ( q2[0] > q1[0] ) {
+    if constexpr ( vee ) {
       Q1[0] =  v3[0] * v2[0]            * v1[0] - std::conj(v3[3]) * std::conj(v2[1]) * v1[3] ;
       Q1[1] =  v3[1] * v2[3]            * v1[0] + std::conj(v3[2]) * std::conj(v2[2]) * v1[3] ;
       Q1[2] = -v3[0] * std::conj(v2[3]) * v1[1] - std::conj(v3[3]) * v2[2]            * v1[2] ;
@@ -225,9 +208,49 @@ namespace f3c {
       Q2[3] = -v3[3]            * std::conj(v2[3]) * std::conj(v1[1]) + std::conj(v3[0]) * std::conj(v2[2]) * std::conj(v1[2]) ;
     }
 
+  }
+
+  /**
+   * \brief Computes the matrix blocks `Q1` and `Q2` of the product of 3
+   *        TFXY-rotation matrix gates with values `v1`, `v2`, and `v3`, for
+   *        the orientation `vee` given at runtime.
+   */
+  template <typename T>
+  inline void blocksTFXY( const bool vee ,
+                          const T* v1 , const T* v2 , const T* v3 ,
+                          T* Q1 , T* Q2 ) {
+    if ( vee ) {
+      blocksTFXY< true >( v1 , v2 , v3 , Q1 , Q2 ) ;
+    } else {
+      blocksTFXY< false >( v1 , v2 , v3 , Q1 , Q2 ) ;
+    }
+  }
+
+  /**
+   * \brief Computes the values `vA`, `vB`, and `vC` of the turnover of 3
+   *        TFXY-rotation matrix gates with values `v1`, `v2`, and `v3`, given
+   *        their matrix blocks `Q1` and `Q2` computed by blocksTFXY.
+   *
+   * The matrix blocks `Q1` and `Q2` are overwritten. The outputs are only
+   * written after all inputs have been read, hence they can alias the inputs.
+   * The orientation `vee` is a template parameter, see blocksTFXY.
+   */
+  template <bool vee, typename T>
+  void turnoverTFXY( const T* v1 , const T* v2 , const T* v3 ,
+                     T* Q1 , T* Q2 ,
+                     T* vA , T* vB , T* vC ) {
+
+    // work arrays
+    std::array< T , 4 >  U ;
+    std::array< T , 4 >  V ;
+    std::array< T , 4 >  Y ;
+    std::array< T , 4 >  Z ;
+    std::array< T , 4 >  W ;
+    T* v ;
+
     // turnover
     const auto eps = std::numeric_limits< qclab::real_t< T > >::epsilon() ;
-    if ( ( norm22( Q1.data() ) - norm22( Q2.data() ) < 100*eps ) ||
+    if ( ( norm22( Q1 ) - norm22( Q2 ) < 100*eps ) ||
          ( std::abs(Q2[1]) + std::abs(Q2[2]) == 0 ) ) {
       //
       // diagonalize, anti-diagonalize, diagonalize, anti-diagonalize
@@ -238,7 +261,7 @@ namespace f3c {
       Z[1] = -std::conj(Q1[2]) ;
       Z[2] = -std::conj(Q1[1]) ;
       Z[3] =  std::conj(Q1[0]) ;
-      diagonalize22( Q1.data() , Z.data() , U.data() , Y.data() ) ;
+      diagonalize22Direct( Q1 , Z.data() , U.data() , Y.data() ) ;
 
       // (2) compute V to anti-diagonalize (Q41,Q23)
       Z[0] =  std::conj(Q2[3]) ;
@@ -246,7 +269,7 @@ namespace f3c {
       Z[2] = -std::conj(Q2[1]) ;
       Z[3] =  std::conj(Q2[0]) ;
       gemm22(  Z.data() , Y.data() , W.data() ) ;  // AD23
-      gemm22( Q2.data() , Y.data() , Z.data() ) ;  // AD41
+      gemm22( Q2 , Y.data() , Z.data() ) ;        // AD41
       if ( std::abs(Z[1]) + std::abs(Z[3]) > std::abs(W[1]) + std::abs(W[3]) ) {
         // use AD41
         if ( std::abs( Z[3] ) > std::abs( Z[1] ) ) {
@@ -272,7 +295,7 @@ namespace f3c {
       Q1[2] = V[0] * Z[2] + V[2] * Z[3] ;
 
       // (3) compute Z to diagonalize (Q22,Q44)
-      if ( q2[0] > q1[0] ) {
+      if constexpr ( vee ) {
         Q2[0] =  v3[0] * v2[1]            * v1[0] - std::conj(v3[3]) * std::conj(v2[0]) * v1[3] ;
         Q2[1] =  v3[1] * v2[2]            * v1[0] + std::conj(v3[2]) * std::conj(v2[3]) * v1[3] ;
         Q2[2] = -v3[0] * std::conj(v2[2]) * v1[1] - std::conj(v3[3]) * v2[3]            * v1[2] ;
@@ -291,7 +314,7 @@ namespace f3c {
       // free Y
       U[1] = Y[0] ;
       U[3] = Y[2] ;
-      gemm22( V.data() , Q2.data() , Y.data() ) ;
+      gemm22( V.data() , Q2 , Y.data() ) ;
       if ( ( std::abs( Q1[0] - ( Y[0]*W[0] + Y[2]*W[1] ) ) +
              std::abs( Q1[3] - ( Y[1]*W[2] + Y[3]*W[3] ) ) ) <
            ( std::abs( Q1[0] - ( Y[0]*Z[0] + Y[2]*Z[1] ) ) +
@@ -316,7 +339,7 @@ namespace f3c {
       Z[3] = -std::conj(Q2[0]) ;
       Q2[1] = -Q2[1] ;
       Q2[3] = -Q2[3] ;
-      diagonalize22( Z.data() , Q2.data() , V.data() , Y.data() ) ;
+      diagonalize22Direct( Z.data() , Q2 , V.data() , Y.data() ) ;
       Q2[1] = Q2[0] ;
       Q2[2] = Q2[3] ;
       // V = flipup(V)
@@ -327,7 +350,7 @@ namespace f3c {
       V[3] = -V[3] ;
 
       // (2) compute U to diagonalize (Q11,Q33)
-      gemm22( Q1.data() , Y.data() , Z.data() ) ;
+      gemm22( Q1 , Y.data() , Z.data() ) ;
       Q2[0] = -std::conj(Q1[2]) * Y[0] + std::conj(Q1[0]) * Y[1] ;
       if ( std::abs( Z[1] ) > std::abs( Q2[0] ) ) {
         rotateToZeroL( Z[0] , Z[1] , U.data() ) ;
@@ -340,7 +363,7 @@ namespace f3c {
       Q2[3] = U[1] * Z[2] + U[3] * Z[3] ;
 
       // (3) compute Z to anti-diagonalize (Q14,Q32)
-      if ( q2[0] > q1[0] ) {
+      if constexpr ( vee ) {
         Q1[0] =  v3[2] * v2[2]            * v1[0] - std::conj(v3[1]) * std::conj(v2[3]) * v1[3] ;
         Q1[1] =  v3[3] * v2[1]            * v1[0] + std::conj(v3[0]) * std::conj(v2[0]) * v1[3] ;
         Q1[2] =  v3[2] * std::conj(v2[1]) * v1[1] + std::conj(v3[1]) * v2[0]            * v1[2] ;
@@ -359,7 +382,7 @@ namespace f3c {
       // free Y
       V[1] = Y[0] ;
       V[3] = Y[2] ;
-      gemm22( U.data() , Q1.data() , Y.data() ) ;
+      gemm22( U.data() , Q1 , Y.data() ) ;
       if ( ( std::abs( Q2[1] - ( Y[1]*W[0] + Y[3]*W[1] ) ) +
              std::abs( Q2[2] - ( Y[0]*W[2] + Y[2]*W[3] ) ) ) <
            ( std::abs( Q2[1] - ( Y[1]*Z[0] + Y[3]*Z[1] ) ) +
@@ -374,31 +397,374 @@ namespace f3c {
 
     }
 
-    // new gates
-    using TFXY = f3c::qgates::RotationTFXYMatrix< T > ;
-    if ( q2[0] > q1[0] ) {
+    // new values
+    if constexpr ( vee ) {
       // vee --> hat
-      gateA = std::make_unique< TFXY >( q2[0] , q2[1] , std::conj( Y[0] ) ,
-                                                        std::conj( Z[0] ) ,
-                                                        std::conj( Z[2] ) ,
-                                                        std::conj( Y[2] ) ) ;
-      gateB = std::make_unique< TFXY >( q1[0] , q1[1] , v[0] , v[3] ,
-                                                        v[2] , v[1] ) ;
-      gateC = std::make_unique< TFXY >( q2[0] , q2[1] , std::conj( U[0] ) ,
-                                                        std::conj( V[0] ) ,
-                                                        std::conj( V[2] ) ,
-                                                        std::conj( U[2] ) ) ;
+      vA[0] = std::conj( Y[0] ) ; vA[1] = std::conj( Z[0] ) ;
+      vA[2] = std::conj( Z[2] ) ; vA[3] = std::conj( Y[2] ) ;
+      vB[0] = v[0] ; vB[1] = v[3] ; vB[2] = v[2] ; vB[3] = v[1] ;
+      vC[0] = std::conj( U[0] ) ; vC[1] = std::conj( V[0] ) ;
+      vC[2] = std::conj( V[2] ) ; vC[3] = std::conj( U[2] ) ;
     } else {
       // hat --> vee
-      gateA = std::make_unique< TFXY >( q2[0] , q2[1] , std::conj( Y[0] ) ,
-                                         Z[0] , -Z[2] , std::conj( Y[2] ) ) ;
-      gateB = std::make_unique< TFXY >( q1[0] , q1[1] , v[0] ,
-                                                        std::conj( v[3] ) ,
-                                                       -std::conj( v[2] ) ,
-                                                        v[1] ) ;
-      gateC = std::make_unique< TFXY >( q2[0] , q2[1] , std::conj( U[0] ) ,
-                                         V[0] , -V[2] , std::conj( U[2] ) ) ;
+      vA[0] = std::conj( Y[0] ) ; vA[1] = Z[0] ;
+      vA[2] = -Z[2]             ; vA[3] = std::conj( Y[2] ) ;
+      vB[0] = v[0] ; vB[1] = std::conj( v[3] ) ;
+      vB[2] = -std::conj( v[2] ) ; vB[3] = v[1] ;
+      vC[0] = std::conj( U[0] ) ; vC[1] = V[0] ;
+      vC[2] = -V[2]             ; vC[3] = std::conj( U[2] ) ;
+    }
+
+  }
+
+  /**
+   * \brief Computes the values `vA`, `vB`, and `vC` of the turnover of 3
+   *        TFXY-rotation matrix gates with values `v1`, `v2`, and `v3`, given
+   *        their matrix blocks `Q1` and `Q2`, for the orientation `vee` given
+   *        at runtime.
+   */
+  template <typename T>
+  inline void turnoverTFXY( const bool vee ,
+                            const T* v1 , const T* v2 , const T* v3 ,
+                            T* Q1 , T* Q2 ,
+                            T* vA , T* vB , T* vC ) {
+    if ( vee ) {
+      turnoverTFXY< true >( v1 , v2 , v3 , Q1 , Q2 , vA , vB , vC ) ;
+    } else {
+      turnoverTFXY< false >( v1 , v2 , v3 , Q1 , Q2 , vA , vB , vC ) ;
+    }
+  }
+
+  /// Checks if the TFXY-rotation matrix gate with values `v` is diagonal.
+  template <typename T>
+  inline bool isDiagonalTFXY( const T* v ) {
+    return ( v[2] == T(0) ) && ( v[3] == T(0) ) ;
+  }
+
+  /**
+   * \brief Splits the diagonal TFXY-rotation matrix gate with values `v` in
+   *        the phases `s` and `t` of its Z-rotations on the first and second
+   *        qubit, i.e., the product of the gates with values (s, s, 0, 0) and
+   *        (t, conj(t), 0, 0).
+   */
+  template <typename T>
+  inline void phasesTFXY( const T* v , T& s , T& t ) {
+    s = std::sqrt( v[0] * v[1] ) ;
+    t = v[0] * std::conj( s ) ;
+  }
+
+  /**
+   * \brief Computes the values `v` of the TFXY-rotation matrix gate `v1`
+   *        followed by the TFXY-rotation matrix gate `v2`.
+   */
+  template <typename T>
+  inline void mulTFXY( const T* v1 , const T* v2 , T* v ) {
+    const T a = v2[0] * v1[0] - std::conj( v2[3] ) * v1[3] ;
+    const T b = v2[1] * v1[1] - std::conj( v2[2] ) * v1[2] ;
+    const T c = v2[2] * v1[1] + std::conj( v2[1] ) * v1[2] ;
+    const T d = v2[3] * v1[0] + std::conj( v2[0] ) * v1[3] ;
+    v[0] = a ; v[1] = b ; v[2] = c ; v[3] = d ;
+  }
+
+  /**
+   * \brief Computes the values `v` of the TFXY-rotation matrix gate `v1`
+   *        followed by the diagonal gate with values (p, q, 0, 0).
+   */
+  template <typename T>
+  inline void mulDiagonalTFXY( const T* v1 , const T p , const T q , T* v ) {
+    v[0] = p * v1[0] ;
+    v[1] = q * v1[1] ;
+    v[2] = std::conj( q ) * v1[2] ;
+    v[3] = std::conj( p ) * v1[3] ;
+  }
+
+  /**
+   * \brief Computes the values `v` of the diagonal gate with values
+   *        (p, q, 0, 0) followed by the TFXY-rotation matrix gate `v2`.
+   */
+  template <typename T>
+  inline void diagonalMulTFXY( const T p , const T q , const T* v2 , T* v ) {
+    v[0] = v2[0] * p ;
+    v[1] = v2[1] * q ;
+    v[2] = v2[2] * q ;
+    v[3] = v2[3] * p ;
+  }
+
+  /**
+   * \brief Computes the values `vA`, `vB`, and `vC` of the turnover of 3
+   *        TFXY-rotation matrix gates with values `v1`, `v2`, and `v3` if one
+   *        of them is diagonal, and returns false otherwise.
+   *
+   * A diagonal gate is a product of Z-rotations on its 2 qubits. The
+   * Z-rotation on the qubit that is not shared commutes with the other 2
+   * gates, the one on the shared qubit is absorbed in a neighbouring gate.
+   * Hence, the turnover reduces to products of gates, without any
+   * factorization, and merging an identity or a pure field gate is exact.
+   * The outputs cannot alias the inputs.
+   */
+  template <bool vee, typename T>
+  inline bool turnoverDiagonalTFXY( const T* v1 , const T* v2 , const T* v3 ,
+                                    T* vA , T* vB , T* vC ) {
+    T s , t ;
+    if ( isDiagonalTFXY( v2 ) ) {
+      // A = Z-rotation on the other qubit, B = gate1 * Z-rotation * gate3
+      phasesTFXY( v2 , s , t ) ;
+      std::array< T , 4 >  W ;
+      if constexpr ( vee ) {
+        mulDiagonalTFXY( v1 , s , std::conj( s ) , W.data() ) ;
+        vA[0] = t ; vA[1] = std::conj( t ) ;
+      } else {
+        mulDiagonalTFXY( v1 , t , t , W.data() ) ;
+        vA[0] = s ; vA[1] = s ;
+      }
+      vA[2] = 0 ; vA[3] = 0 ;
+      mulTFXY( W.data() , v3 , vB ) ;
+      vC[0] = 1 ; vC[1] = 1 ; vC[2] = 0 ; vC[3] = 0 ;
+      return true ;
+    }
+    if ( isDiagonalTFXY( v1 ) ) {
+      // A = Z-rotation * gate2, B = Z-rotation * gate3, C = identity
+      phasesTFXY( v1 , s , t ) ;
+      if constexpr ( vee ) {
+        diagonalMulTFXY( t , t , v2 , vA ) ;
+        diagonalMulTFXY( s , s , v3 , vB ) ;
+      } else {
+        diagonalMulTFXY( s , std::conj( s ) , v2 , vA ) ;
+        diagonalMulTFXY( t , std::conj( t ) , v3 , vB ) ;
+      }
+      vC[0] = 1 ; vC[1] = 1 ; vC[2] = 0 ; vC[3] = 0 ;
+      return true ;
+    }
+    if ( isDiagonalTFXY( v3 ) ) {
+      // A = identity, B = gate1 * Z-rotation, C = gate2 * Z-rotation
+      phasesTFXY( v3 , s , t ) ;
+      vA[0] = 1 ; vA[1] = 1 ; vA[2] = 0 ; vA[3] = 0 ;
+      if constexpr ( vee ) {
+        mulDiagonalTFXY( v1 , s , s , vB ) ;
+        mulDiagonalTFXY( v2 , t , t , vC ) ;
+      } else {
+        mulDiagonalTFXY( v1 , t , std::conj( t ) , vB ) ;
+        mulDiagonalTFXY( v2 , s , std::conj( s ) , vC ) ;
+      }
+      return true ;
     }
+    return false ;
+  }
+
+  /**
+   * \brief Computes the values `vA`, `vB`, and `vC` of the turnover of 3
+   *        TFXY-rotation matrix gates with values `v1`, `v2`, and `v3`, for
+   *        the orientation `vee` given at compile time.
+   *
+   * Turnovers with a diagonal gate take the fast path turnoverDiagonalTFXY.
+   * The outputs cannot alias the inputs.
+   */
+  template <bool vee, typename T>
+  inline void turnoverTFXY( const T* v1 , const T* v2 , const T* v3 ,
+                            T* vA , T* vB , T* vC ) {
+    if ( turnoverDiagonalTFXY< vee >( v1 , v2 , v3 , vA , vB , vC ) ) return ;
+    std::array< T , 4 >  Q1 ;
+    std::array< T , 4 >  Q2 ;
+    blocksTFXY< vee >( v1 , v2 , v3 , Q1.data() , Q2.data() ) ;
+    turnoverTFXY< vee >( v1 , v2 , v3 , Q1.data() , Q2.data() ,
+                         vA , vB , vC ) ;
+  }
+
+  /**
+   * \brief Computes the values `vA`, `vB`, and `vC` of the turnover of 3
+   *        TFXY-rotation matrix gates with values `v1`, `v2`, and `v3`.
+   */
+  template <typename T>
+  inline void turnoverTFXY( const bool vee ,
+                            const T* v1 , const T* v2 , const T* v3 ,
+                            T* vA , T* vB , T* vC ) {
+    if ( vee ) {
+      turnoverTFXY< true >( v1 , v2 , v3 , vA , vB , vC ) ;
+    } else {
+      turnoverTFXY< false >( v1 , v2 , v3 , vA , vB , vC ) ;
+    }
+  }
+
+  /**
+   * \brief Computes the values `vA`, `vB`, and `vC` of the turnover of 3
+   *        TFXY-U(1)-rotation gates with values `v1`, `v2`, and `v3`, for the
+   *        orientation `vee` given at compile time.
+   *
+   * On the single-particle states, a gate with values (a, b, c) acts as the
+   * SU(2) matrix [b -conj(c); c conj(b)] on its 2 modes and as the phase `a`
+   * on the other modes. Hence, the turnover reduces to a 3 x 3 unitary
+   * matrix, factored again with 2 Givens rotations in SU(2). Gates B and C
+   * get phase 1, gate A gets the product of the phases. Only the first and
+   * last column of the 3 x 3 matrix are needed. A hat is mirrored to a vee
+   * by reversing the order of the modes, which maps (b, c) to
+   * (conj(b), -conj(c)). The outputs are only written after all inputs have
+   * been read, hence they can alias the inputs.
+   */
+  template <bool vee, typename T>
+  inline void turnoverTFXYU1( const T* v1 , const T* v2 , const T* v3 ,
+                              T* vA , T* vB , T* vC ) {
+
+    using R = qclab::real_t< T > ;
+    auto mirror = []( const T b , const T c , T& mb , T& mc ) {
+      if constexpr ( vee ) {
+        mb = b ; mc = c ;
+      } else {
+        mb = std::conj( b ) ; mc = -std::conj( c ) ;
+      }
+    } ;
+    const T a1 = v1[0] ;
+    const T a2 = v2[0] ;
+    const T a3 = v3[0] ;
+    T b1 , c1 , b2 , c2 , b3 , c3 ;
+    mirror( v1[1] , v1[2] , b1 , c1 ) ;
+    mirror( v2[1] , v2[2] , b2 , c2 ) ;
+    mirror( v3[1] , v3[2] , b3 , c3 ) ;
+    const T a = a1 * a2 * a3 ;
+
+    // first and last column of M = G3(1:2,1:2) * G2(0:1,0:1) * G1(1:2,1:2)
+    const T M00 = a1 * a3 * b2 ;
+    const T M10 = a1 * b3 * c2 ;
+    const T M20 = a1 * c3 * c2 ;
+    const T x1 = -std::conj( b2 * c1 ) ;
+    const T x2 = a2 * std::conj( b1 ) ;
+    const T M02 = a3 * std::conj( c1 * c2 ) ;
+    const T M12 = b3 * x1 - std::conj( c3 ) * x2 ;
+    const T M22 = c3 * x1 + std::conj( b3 ) * x2 ;
+
+    // C(0:1,0:1) zeroes M(0,2)
+    const R r = std::sqrt( std::norm( M02 ) + std::norm( M12 ) ) ;
+    const T bC = ( r > 0 ) ?  std::conj( M12 ) / r : T(1) ;
+    const T cC = ( r > 0 ) ? -std::conj( M02 ) / r : T(0) ;
+    const T W00 = std::conj( bC ) * M00 + std::conj( cC ) * M10 ;
+    const T W10 = bC * M10 - cC * M00 ;
+
+    // B(1:2,1:2) maps the last column of C^H M to a e_2, A is the remainder
+    const R rB = std::sqrt( std::norm( M22 ) + r * r ) ;
+    const T bB = a * std::conj( M22 ) / rB ;
+    const T cB = -a * r / rB ;
+    T bA = W00 ;
+    T cA = std::conj( a ) * ( M22 * W10 - r * M20 ) / rB ;
+    const R rA = std::sqrt( std::norm( bA ) + std::norm( cA ) ) ;
+    bA /= rA ; cA /= rA ;
+
+    // new values
+    vA[0] = a ; mirror( bA , cA , vA[1] , vA[2] ) ;
+    vB[0] = 1 ; mirror( bB , cB , vB[1] , vB[2] ) ;
+    vC[0] = 1 ; mirror( bC , cC , vC[1] , vC[2] ) ;
+
+  }
+
+  /**
+   * \brief Computes the values `vA`, `vB`, and `vC` of the turnover of 3
+   *        TFXY-U(1)-rotation gates with values `v1`, `v2`, and `v3`, for the
+   *        orientation `vee` given at runtime.
+   */
+  template <typename T>
+  inline void turnoverTFXYU1( const bool vee ,
+                              const T* v1 , const T* v2 , const T* v3 ,
+                              T* vA , T* vB , T* vC ) {
+    if ( vee ) {
+      turnoverTFXYU1< true >( v1 , v2 , v3 , vA , vB , vC ) ;
+    } else {
+      turnoverTFXYU1< false >( v1 , v2 , v3 , vA , vB , vC ) ;
+    }
+  }
+
+  /// Computes the turnover operation of 3 TFXY-rotation matrix gates.
+  template <typename T>
+  void turnover( const f3c::qgates::RotationTFXYMatrix< T >& gate1 ,
+                 const f3c::qgates::RotationTFXYMatrix< T >& gate2 ,
+                 const f3c::qgates::RotationTFXYMatrix< T >& gate3 ,
+                 f3c::qgates::RotationTFXYMatrix< T >& gateA ,
+                 f3c::qgates::RotationTFXYMatrix< T >& gateB ,
+                 f3c::qgates::RotationTFXYMatrix< T >& gateC ) {
+
+    // checks
+    const auto q1 = f3c::qubitPair( gate1 ) ;
+    const auto q2 = f3c::qubitPair( gate2 ) ;
+    assert( q1[0] == f3c::qubitPair( gate3 )[0] ) ;
+    assert( q1[1] == f3c::qubitPair( gate3 )[1] ) ;
+    assert( ( q2[0] == q1[1] ) || ( q2[1] == q1[0] ) ) ;
+
+    // turnover
+    std::array< T , 4 >  vA ;
+    std::array< T , 4 >  vB ;
+    std::array< T , 4 >  vC ;
+    turnoverTFXY( q2[0] > q1[0] , gate1.values().data() ,
+                  gate2.values().data() , gate3.values().data() ,
+                  vA.data() , vB.data() , vC.data() ) ;
+
+    // new gates
+    using TFXY = f3c::qgates::RotationTFXYMatrix< T > ;
+    gateA = TFXY( q2[0] , q2[1] , vA[0] , vA[1] , vA[2] , vA[3] ) ;
+    gateB = TFXY( q1[0] , q1[1] , vB[0] , vB[1] , vB[2] , vB[3] ) ;
+    gateC = TFXY( q2[0] , q2[1] , vC[0] , vC[1] , vC[2] , vC[3] ) ;
+
+  }
+
+  /// Computes the turnover operation of 3 TFXY-U(1)-rotation gates.
+  template <typename T>
+  void turnover( const f3c::qgates::RotationTFXYU1Matrix< T >& gate1 ,
+                 const f3c::qgates::RotationTFXYU1Matrix< T >& gate2 ,
+                 const f3c::qgates::RotationTFXYU1Matrix< T >& gate3 ,
+                 f3c::qgates::RotationTFXYU1Matrix< T >& gateA ,
+                 f3c::qgates::RotationTFXYU1Matrix< T >& gateB ,
+                 f3c::qgates::RotationTFXYU1Matrix< T >& gateC ) {
+
+    // checks
+    const auto q1 = f3c::qubitPair( gate1 ) ;
+    const auto q2 = f3c::qubitPair( gate2 ) ;
+    assert( q1[0] == f3c::qubitPair( gate3 )[0] ) ;
+    assert( q1[1] == f3c::qubitPair( gate3 )[1] ) ;
+    assert( ( q2[0] == q1[1] ) || ( q2[1] == q1[0] ) ) ;
+
+    // turnover
+    std::array< T , 3 >  vA ;
+    std::array< T , 3 >  vB ;
+    std::array< T , 3 >  vC ;
+    turnoverTFXYU1( q2[0] > q1[0] , gate1.values().data() ,
+                    gate2.values().data() , gate3.values().data() ,
+                    vA.data() , vB.data() , vC.data() ) ;
+
+    // new gates
+    using TFXYU1 = f3c::qgates::RotationTFXYU1Matrix< T > ;
+    gateA = TFXYU1( q2[0] , q2[1] , vA[0] , vA[1] , vA[2] ) ;
+    gateB = TFXYU1( q1[0] , q1[1] , vB[0] , vB[1] , vB[2] ) ;
+    gateC = TFXYU1( q2[0] , q2[1] , vC[0] , vC[1] , vC[2] ) ;
+
+  }
+
+  /**
+   * \brief Computes the turnover operation of 3 TFIM-rotation gates.
+   *
+   * The gates on neighboring Majorana modes form SU(2), see RotationTFIM,
+   * hence this is a single real SU(2) turnover for both orientations.
+   */
+  template <typename T>
+  void turnover( const f3c::qgates::RotationTFIM< T >& gate1 ,
+                 const f3c::qgates::RotationTFIM< T >& gate2 ,
+                 const f3c::qgates::RotationTFIM< T >& gate3 ,
+                 f3c::qgates::RotationTFIM< T >& gateA ,
+                 f3c::qgates::RotationTFIM< T >& gateB ,
+                 f3c::qgates::RotationTFIM< T >& gateC ) {
+
+    // checks
+    const auto q1 = f3c::qubitPair( gate1 ) ;
+    const auto q2 = f3c::qubitPair( gate2 ) ;
+    assert( q1[0] == f3c::qubitPair( gate3 )[0] ) ;
+    assert( q1[1] == f3c::qubitPair( gate3 )[1] ) ;
+    assert( ( q2[0] == q1[1] ) || ( q2[1] == q1[0] ) ) ;
+
+    // SU(2) turnover
+    const auto [ rotA , rotB , rotC ] = turnoverSU2( gate1.rotation() ,
+                                                     gate2.rotation() ,
+                                                     gate3.rotation() ) ;
+
+    // new gates
+    using TFIM = f3c::qgates::RotationTFIM< T > ;
+    gateA = TFIM( q2[0] , q2[1] , rotA ) ;
+    gateB = TFIM( q1[0] , q1[1] , rotB ) ;
+    gateC = TFIM( q2[0] , q2[1] , rotC ) ;
 
   }
 
@@ -408,24 +774,150 @@ namespace f3c {
   void turnover( const G& gate1 ,
                  const G& gate2 ,
                  const G& gate3 ,
-                 std::unique_ptr< G >& gateA ,
-                 std::unique_ptr< G >& gateB ,
-                 std::unique_ptr< G >& gateC ) {
+                 G& gateA ,
+                 G& gateB ,
+                 G& gateC ) {
     using T = typename G::value_type ;
     using TFXY = f3c::qgates::RotationTFXYMatrix< T > ;
     // convert to rotation TFXY matrix gates
     const auto g1 = TFXY( gate1 ) ;
     const auto g2 = TFXY( gate2 ) ;
     const auto g3 = TFXY( gate3 ) ;
-    std::unique_ptr< TFXY >  gA ;
-    std::unique_ptr< TFXY >  gB ;
-    std::unique_ptr< TFXY >  gC ;
+    TFXY  gA ;
+    TFXY  gB ;
+    TFXY  gC ;
     // turnover
     turnover( g1 , g2 , g3 , gA , gB , gC ) ;
     // convert back to type G
-    gateA = std::make_unique< G >( *gA ) ;
-    gateB = std::make_unique< G >( *gB ) ;
-    gateC = std::make_unique< G >( *gC ) ;
+    gateA = G( gA ) ;
+    gateB = G( gB ) ;
+    gateC = G( gC ) ;
+  }
+
+  /**
+   * \brief Computes the turnover operation of 3 gates and stores the result in
+   *        the newly allocated gates `gateA`, `gateB`, and `gateC`.
+   */
+  template <typename G1, typename G2>
+  void turnover( const G1& gate1 ,
+                 const G2& gate2 ,
+                 const G1& gate3 ,
+                 std::unique_ptr< G2 >& gateA ,
+                 std::unique_ptr< G1 >& gateB ,
+                 std::unique_ptr< G2 >& gateC ) {
+    G2  A ;
+    G1  B ;
+    G2  C ;
+    turnover( gate1 , gate2 , gate3 , A , B , C ) ;
+    gateA = std::make_unique< G2 >( A ) ;
+    gateB = std::make_unique< G1 >( B ) ;
+    gateC = std::make_unique< G2 >( C ) ;
+  }
+
+  /**
+   * \brief Computes the turnover operation of 3 gates of the same type, for
+   *        the orientation `vee` given at compile time.
+   *
+   * The orientation `vee` of the gates, i.e., whether `gate2` acts on the
+   * qubits below `gate1` and `gate3`, is given at compile time by callers that
+   * know it for a whole loop. The gates A, B, and C are only written after
+   * all inputs have been read, hence `gateA`, `gateB`, and `gateC` can alias
+   * any of the inputs. The qubits and parameters of the output gates are
+   * updated, no gates are allocated.
+   */
+  template <bool vee, typename G>
+  void turnover( const G& gate1 ,
+                 const G& gate2 ,
+                 const G& gate3 ,
+                 G& gateA ,
+                 G& gateB ,
+                 G& gateC ) {
+    const auto q1 = f3c::qubitPair( gate1 ) ;
+    const auto q2 = f3c::qubitPair( gate2 ) ;
+    assert( ( q2[0] > q1[0] ) == vee ) ;
+    if constexpr ( f3c::is_two_axes_v< G > ) {
+      // 2 SU(2) turnovers
+      const auto [ rot10 , rot11 ] = gate1.rotations() ;
+      const auto [ rot20 , rot21 ] = gate2.rotations() ;
+      const auto [ rot30 , rot31 ] = gate3.rotations() ;
+      const auto [ rotA0 , rotB0 , rotC0 ] = turnoverSU2( rot10 , rot21 ,
+                                                          rot30 ) ;
+      const auto [ rotA1 , rotB1 , rotC1 ] = turnoverSU2( rot11 , rot20 ,
+                                                          rot31 ) ;
+      gateA.setQubits( q2.data() ) ;  gateA.update( rotA1 , rotA0 ) ;
+      gateB.setQubits( q1.data() ) ;  gateB.update( rotB0 , rotB1 ) ;
+      gateC.setQubits( q2.data() ) ;  gateC.update( rotC1 , rotC0 ) ;
+    } else if constexpr ( std::is_same_v< G ,
+                    qgates::RotationTFXYMatrix< typename G::value_type > > ) {
+      using T = typename G::value_type ;
+      std::array< T , 4 >  vA ;
+      std::array< T , 4 >  vB ;
+      std::array< T , 4 >  vC ;
+      turnoverTFXY< vee >( gate1.values().data() , gate2.values().data() ,
+                           gate3.values().data() ,
+                           vA.data() , vB.data() , vC.data() ) ;
+      gateA.setQubits( q2.data() ) ;
+      gateA.update( vA[0] , vA[1] , vA[2] , vA[3] ) ;
+      gateB.setQubits( q1.data() ) ;
+      gateB.update( vB[0] , vB[1] , vB[2] , vB[3] ) ;
+      gateC.setQubits( q2.data() ) ;
+      gateC.update( vC[0] , vC[1] , vC[2] , vC[3] ) ;
+    } else if constexpr ( f3c::is_TFIM_v< G > ) {
+      const auto [ rotA , rotB , rotC ] = turnoverSU2( gate1.rotation() ,
+                                                       gate2.rotation() ,
+                                                       gate3.rotation() ) ;
+      gateA.setQubits( q2.data() ) ;  gateA.update( rotA ) ;
+      gateB.setQubits( q1.data() ) ;  gateB.update( rotB ) ;
+      gateC.setQubits( q2.data() ) ;  gateC.update( rotC ) ;
+    } else if constexpr ( f3c::is_TFXY_U1_matrix_v< G > ) {
+      using T = typename G::value_type ;
+      std::array< T , 3 >  vA ;
+      std::array< T , 3 >  vB ;
+      std::array< T , 3 >  vC ;
+      turnoverTFXYU1< vee >( gate1.values().data() , gate2.values().data() ,
+                             gate3.values().data() ,
+                             vA.data() , vB.data() , vC.data() ) ;
+      gateA.setQubits( q2.data() ) ;
+      gateA.update( vA[0] , vA[1] , vA[2] ) ;
+      gateB.setQubits( q1.data() ) ;
+      gateB.update( vB[0] , vB[1] , vB[2] ) ;
+      gateC.setQubits( q2.data() ) ;
+      gateC.update( vC[0] , vC[1] , vC[2] ) ;
+    } else {
+      G  A ;
+      G  B ;
+      G  C ;
+      turnover( gate1 , gate2 , gate3 , A , B , C ) ;
+      gateA = A ;
+      gateB = B ;
+      gateC = C ;
+    }
+  }
+
+  /**
+   * \brief Computes the turnover operation of 3 gates in place.
+   *
+   * On return, `gate1`, `gate2`, and `gate3` hold the gates A, B, and C of
+   * the turnover, i.e., `gate1` and `gate3` move to the qubits of `gate2` and
+   * vice versa. The qubits and parameters of the existing gates are updated,
+   * no gates are allocated. The orientation `vee` is given at compile time.
+   */
+  template <bool vee, typename G>
+  inline void turnoverInPlace( G& gate1 , G& gate2 , G& gate3 ) {
+    turnover< vee >( gate1 , gate2 , gate3 , gate1 , gate2 , gate3 ) ;
+  }
+
+  /**
+   * \brief Computes the turnover operation of 3 gates in place, for the
+   *        orientation of the gates determined at runtime.
+   */
+  template <typename G>
+  inline void turnoverInPlace( G& gate1 , G& gate2 , G& gate3 ) {
+    if ( f3c::qubitPair( gate2 )[0] > f3c::qubitPair( gate1 )[0] ) {
+      turnoverInPlace< true >( gate1 , gate2 , gate3 ) ;
+    } else {
+      turnoverInPlace< false >( gate1 , gate2 , gate3 ) ;
+    }
   }
 
   /// Computes the turnover operation of 3 gates.
@@ -433,11 +925,11 @@ namespace f3c {
   std::tuple< G2 , G1 , G2 > turnover( const G1& gate1 ,
                                        const G2& gate2 ,
                                        const G1& gate3 ) {
-    std::unique_ptr< G2 >  gateA ;
-    std::unique_ptr< G1 >  gateB ;
-    std::unique_ptr< G2 >  gateC ;
+    G2  gateA ;
+    G1  gateB ;
+    G2  gateC ;
     turnover( gate1 , gate2 , gate3 , gateA , gateB , gateC ) ;
-    return { *gateA , *gateB , *gateC } ;
+    return { gateA , gateB , gateC } ;
   }
 
 } // namespace f3c
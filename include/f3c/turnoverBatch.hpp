@@ -0,0 +1,958 @@
+//  (C) Copyright Roel Van Beeumen and Daan Camps 2021.
+
+#ifndef f3c_turnoverBatch_hpp
+#define f3c_turnoverBatch_hpp
+
+#include "f3c/turnover.hpp"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace f3c {
+
+  /**
+   * \class TFXYBatch
+   * \brief Structure-of-arrays buffer with the numerical values of a batch of
+   *        TFXY-rotation matrix gates.
+   *
+   * The real and imaginary parts of the values \f$a\f$, \f$b\f$, \f$c\f$, and
+   * \f$d\f$ of all gates are stored in 8 consecutive contiguous arrays of
+   * length size(), such that the same value of consecutive gates maps onto
+   * consecutive SIMD lanes.
+   */
+  template <typename R>
+  class TFXYBatch
+  {
+
+    public:
+      /// Real value type of this batch.
+      using real_type = R ;
+      /// Complex value type of this batch.
+      using value_type = std::complex< R > ;
+      /// Size type of this batch.
+      using size_type = std::size_t ;
+
+      /// Constructs a batch of `size` TFXY-rotation matrix gates.
+      TFXYBatch( const size_type size = 0 )
+      : size_( size )
+      , values_( 8 * size )
+      { } // TFXYBatch(size)
+
+      /// Returns the number of gates in this batch.
+      inline size_type size() const { return size_ ; }
+
+      /// Resizes this batch to `size` gates.
+      inline void resize( const size_type size ) {
+        if ( size == size_ ) return ;
+        std::vector< R >  values( 8 * size ) ;
+        const size_type m = std::min( size , size_ ) ;
+        for ( int k = 0; k < 8; k++ ) {
+          std::copy_n( values_.data() + k * size_ , m ,
+                       values.data() + k * size ) ;
+        }
+        values_.swap( values ) ;
+        size_ = size ;
+      }
+
+      /// Returns the real and imaginary parts of all values of all gates.
+      inline R* data() { return values_.data() ; }
+
+      /// Returns the real and imaginary parts of all values of all gates.
+      inline const R* data() const { return values_.data() ; }
+
+      /// Returns the real parts of the `k`-th value of all gates.
+      inline R* real( const int k ) { return data() + 2*k * size_ ; }
+
+      /// Returns the real parts of the `k`-th value of all gates (const).
+      inline const R* real( const int k ) const {
+        return data() + 2*k * size_ ;
+      }
+
+      /// Returns the imaginary parts of the `k`-th value of all gates.
+      inline R* imag( const int k ) { return data() + ( 2*k + 1 ) * size_ ; }
+
+      /// Returns the imaginary parts of the `k`-th value of all gates (const).
+      inline const R* imag( const int k ) const {
+        return data() + ( 2*k + 1 ) * size_ ;
+      }
+
+      /// Returns the numerical values of the `i`-th gate of this batch.
+      inline std::array< value_type , 4 > get( const size_type i ) const {
+        return { value_type( real(0)[i] , imag(0)[i] ) ,
+                 value_type( real(1)[i] , imag(1)[i] ) ,
+                 value_type( real(2)[i] , imag(2)[i] ) ,
+                 value_type( real(3)[i] , imag(3)[i] ) } ;
+      }
+
+      /// Sets the numerical values of the `i`-th gate of this batch.
+      inline void set( const size_type i , const value_type* v ) {
+        for ( int k = 0; k < 4; k++ ) {
+          real(k)[i] = std::real( v[k] ) ;
+          imag(k)[i] = std::imag( v[k] ) ;
+        }
+      }
+
+      /// Sets the numerical values of the `i`-th gate of this batch.
+      inline void set( const size_type i ,
+                const f3c::qgates::RotationTFXYMatrix< value_type >& gate ) {
+        set( i , gate.values().data() ) ;
+      }
+
+    protected:
+      /// Number of gates in this batch.
+      size_type          size_ ;
+      /// Real and imaginary parts of the values a, b, c, d.
+      std::vector< R >   values_ ;
+
+  } ; // class TFXYBatch
+
+
+  /**
+   * \brief Complex number in split real/imaginary form.
+   *
+   * The TFXY lane kernels compute with pairs of real numbers instead of
+   * std::complex, such that every operation maps onto SIMD instructions.
+   */
+  template <typename R>
+  struct SplitComplex {
+    /// Real part.
+    R re ;
+    /// Imaginary part.
+    R im ;
+
+    /// Returns the complex conjugate of this complex number.
+    F3C_ALWAYS_INLINE SplitComplex conj() const { return { re , -im } ; }
+
+    /// Returns the squared magnitude of this complex number.
+    F3C_ALWAYS_INLINE R norm() const { return re * re + im * im ; }
+
+    /// Returns the magnitude of this complex number, without scaling.
+    F3C_ALWAYS_INLINE R abs() const { return std::sqrt( norm() ) ; }
+  } ;
+
+  /// Returns the sum of the split complex numbers `x` and `y`.
+  template <typename R>
+  F3C_ALWAYS_INLINE SplitComplex< R > operator+( const SplitComplex< R >& x ,
+                                                 const SplitComplex< R >& y ) {
+    return { x.re + y.re , x.im + y.im } ;
+  }
+
+  /// Returns the difference of the split complex numbers `x` and `y`.
+  template <typename R>
+  F3C_ALWAYS_INLINE SplitComplex< R > operator-( const SplitComplex< R >& x ,
+                                                 const SplitComplex< R >& y ) {
+    return { x.re - y.re , x.im - y.im } ;
+  }
+
+  /// Returns the negation of the split complex number `x`.
+  template <typename R>
+  F3C_ALWAYS_INLINE SplitComplex< R > operator-( const SplitComplex< R >& x ) {
+    return { -x.re , -x.im } ;
+  }
+
+  /// Returns the product of the split complex numbers `x` and `y`.
+  template <typename R>
+  F3C_ALWAYS_INLINE SplitComplex< R > operator*( const SplitComplex< R >& x ,
+                                                 const SplitComplex< R >& y ) {
+    return { x.re * y.re - x.im * y.im , x.re * y.im + x.im * y.re } ;
+  }
+
+  /// Returns the product of the real number `a` and split complex number `x`.
+  template <typename R>
+  F3C_ALWAYS_INLINE SplitComplex< R > operator*( const R a ,
+                                                 const SplitComplex< R >& x ) {
+    return { a * x.re , a * x.im } ;
+  }
+
+  /// Returns `x` if `cond` is true and `y` otherwise.
+  template <typename R>
+  F3C_ALWAYS_INLINE SplitComplex< R > select( const bool cond ,
+                                              const SplitComplex< R >& x ,
+                                              const SplitComplex< R >& y ) {
+    return { cond ? x.re : y.re , cond ? x.im : y.im } ;
+  }
+
+  /**
+   * \brief Computes the rotation [`c`, `s`] of rotateToZero for the split
+   *        complex numbers `x` and `y`, without branches.
+   *
+   * The larger of `x` and `y` is the pivot and is scaled by its largest
+   * component, such that no intermediate result under- or overflows.
+   */
+  template <typename R>
+  F3C_ALWAYS_INLINE void rotateToZeroLane( const SplitComplex< R >& x ,
+                                           const SplitComplex< R >& y ,
+                                           SplitComplex< R >& c ,
+                                           SplitComplex< R >& s ) {
+    using C = SplitComplex< R > ;
+    // pivot p and other value q, i.e., t = q / p
+    const bool swap = x.norm() < y.norm() ;
+    const C p = select( swap , y , x ) ;
+    const C q = select( swap , x , y ) ;
+    const R m = std::max( std::max( std::abs( p.re ) , std::abs( p.im ) ) ,
+                          std::numeric_limits< R >::min() ) ;
+    const C ps = ( R(1) / m ) * p ;
+    const R np = std::max( ps.norm() , R(1) ) ;
+    const C theta = ( R(1) / std::sqrt( np ) ) * ps.conj() ;
+    const C t = ( R(1) / np ) * ( ( ( R(1) / m ) * q ) * ps.conj() ) ;
+    const R r = std::sqrt( R(1) + t.norm() ) ;
+    const C u = ( R(1) / r ) * theta ;
+    const C w = t.conj() * u ;
+    // x = y = 0
+    const bool zero = ( p.re == 0 ) & ( p.im == 0 ) ;
+    c = select( zero , C{ 1 , 0 } , select( swap , w , u ) ) ;
+    s = select( zero , C{ 0 , 0 } , select( swap , u , w ) ) ;
+  }
+
+  /// Computes the rotation `G` of rotateToZeroL for split complex numbers.
+  template <typename R>
+  F3C_ALWAYS_INLINE void rotateToZeroLLane( const SplitComplex< R >& x ,
+                                            const SplitComplex< R >& y ,
+                                            SplitComplex< R >* G ) {
+    SplitComplex< R >  c , s ;
+    rotateToZeroLane( x , y , c , s ) ;
+    G[0] = c ; G[1] = -s.conj() ; G[2] = s ; G[3] = c.conj() ;
+  }
+
+  /// Computes the rotation `G` of rotateToZeroR for split complex numbers.
+  template <typename R>
+  F3C_ALWAYS_INLINE void rotateToZeroRLane( const SplitComplex< R >& x ,
+                                            const SplitComplex< R >& y ,
+                                            SplitComplex< R >* G ) {
+    SplitComplex< R >  c , s ;
+    rotateToZeroLane( x , y , c , s ) ;
+    G[0] = c.conj() ; G[1] = -s.conj() ; G[2] = s ; G[3] = c ;
+  }
+
+  /**
+   * \brief Computes the closed-form diagonalization of the 2 x 2 pencil
+   *        (`A`, `B`) for split complex numbers, without branches.
+   *
+   * Returns false if the result is not diagonal to working precision. The
+   * caller then has to fall back to the iterative diagonalize22.
+   */
+  template <typename R>
+  F3C_ALWAYS_INLINE bool diagonalize22Lane( SplitComplex< R >* A ,
+                                            SplitComplex< R >* B ,
+                                            SplitComplex< R >* Q ,
+                                            SplitComplex< R >* Z ) {
+    using C = SplitComplex< R > ;
+    const auto eps = std::numeric_limits< R >::epsilon() ;
+
+    // A^H * A = [ h11 h12 ; conj(h12) h22 ]
+    const R h11 = A[0].norm() + A[1].norm() ;
+    const R h22 = A[2].norm() + A[3].norm() ;
+    const C h12 = A[0].conj() * A[2] + A[1].conj() * A[3] ;
+    const R a12 = h12.abs() ;
+
+    // Z = Jacobi rotation that diagonalizes A^H * A
+    const bool offdiag = ( a12 != 0 ) ;
+    const R a = offdiag ? a12 : R(1) ;
+    const R tau = ( h22 - h11 ) / ( 2 * a ) ;
+    const R t0 = ( tau >= 0 ? R(1) : R(-1) ) /
+                 ( std::abs( tau ) + std::sqrt( 1 + tau * tau ) ) ;
+    const R t = offdiag ? t0 : R(0) ;
+    const C c = { R(1) / std::sqrt( 1 + t * t ) , R(0) } ;
+    const C s = ( t * c.re / a ) * h12 ;
+    const bool swap = !( h11 - t * a12 <= h22 + t * a12 ) ;
+    // A^H * A = sigma^2 * I: Z = rotation that reduces A(2,:)
+    const R gap = std::sqrt( ( h11 - h22 ) * ( h11 - h22 ) + 4 * a12 * a12 ) ;
+    const bool degenerate = ( gap <= 4 * eps * ( h11 + h22 ) ) ;
+    C G[4] ;
+    rotateToZeroRLane( A[3] , A[1] , G ) ;
+    Z[0] = select( degenerate , G[0] , select( swap , -s , c ) ) ;
+    Z[1] = select( degenerate , G[1] , select( swap , -c , -s.conj() ) ) ;
+    Z[2] = select( degenerate , G[2] , select( swap , c , s ) ) ;
+    Z[3] = select( degenerate , G[3] , select( swap , -s.conj() , c ) ) ;
+
+    // Q = rotation such that Q * A * Z(:,2) = [ 0 ; r ], with r >= 0
+    C W[4] ;
+    gemm22( A , Z , W ) ;
+    rotateToZeroLLane( W[3] , -W[2] , Q ) ;
+    Q[0] = Q[0].conj() ; Q[1] = Q[1].conj() ;
+    Q[2] = Q[2].conj() ; Q[3] = Q[3].conj() ;
+
+    // D = Q * A * Z, E = Q * B * Z
+    C D[4] , E[4] ;
+    gemm22( Q , W , D ) ;
+    gemm22( B , Z , W ) ;
+    gemm22( Q , W , E ) ;
+
+    // check
+    const R tolA = 12 * eps * std::sqrt( A[0].norm() + A[1].norm() +
+                                         A[2].norm() + A[3].norm() ) ;
+    const R tolB = 12 * eps * std::sqrt( B[0].norm() + B[1].norm() +
+                                         B[2].norm() + B[3].norm() ) ;
+    const bool ok = ( D[1].abs() + D[2].abs() <= tolA ) &
+                    ( E[1].abs() + E[2].abs() <= tolB ) ;
+
+    // A = diag(diag(Q*A*Z)), B = diag(diag(Q*B*Z))
+    A[0] = D[0] ; A[1] = C{ 0 , 0 } ; A[2] = C{ 0 , 0 } ; A[3] = D[3] ;
+    B[0] = E[0] ; B[1] = C{ 0 , 0 } ; B[2] = C{ 0 , 0 } ; B[3] = E[3] ;
+    return ok ;
+  }
+
+  /**
+   * \brief Computes the values `vA`, `vB`, and `vC` of the turnover of 3
+   *        TFXY-rotation matrix gates with values `v1`, `v2`, and `v3` in
+   *        split complex arithmetic, without branches.
+   *
+   * This is the SIMD lane counterpart of turnoverTFXY: both factorizations
+   * of turnoverTFXY are computed and the one that turnoverTFXY would take is
+   * selected. Magnitudes are square roots of squared norms instead of
+   * std::abs, which is accurate for the unitary gates of a turnover.
+   *
+   * Returns false if a gate is diagonal or if a closed-form diagonalization
+   * is not accurate. The turnover then has to be computed with turnoverTFXY.
+   */
+  template <bool vee, typename R>
+  F3C_ALWAYS_INLINE bool turnoverTFXYLane( const SplitComplex< R >* v1 ,
+                                           const SplitComplex< R >* v2 ,
+                                           const SplitComplex< R >* v3 ,
+                                           SplitComplex< R >* vA ,
+                                           SplitComplex< R >* vB ,
+                                           SplitComplex< R >* vC ) {
+
+    using C = SplitComplex< R > ;
+    const auto cj = []( const C& x ) { return x.conj() ; } ;
+    const auto eps = std::numeric_limits< R >::epsilon() ;
+
+    // matrix blocks, see blocksTFXY
+    C Q1[4] , Q2[4] ;
+    if constexpr ( vee ) {
+      Q1[0] =  v3[0] * v2[0]     * v1[0] - cj(v3[3]) * cj(v2[1]) * v1[3] ;
+      Q1[1] =  v3[1] * v2[3]     * v1[0] + cj(v3[2]) * cj(v2[2]) * v1[3] ;
+      Q1[2] = -v3[0] * cj(v2[3]) * v1[1] - cj(v3[3]) * v2[2]     * v1[2] ;
+      Q1[3] =  v3[1] * cj(v2[0]) * v1[1] - cj(v3[2]) * v2[1]     * v1[2] ;
+
+      Q2[0] =  v3[2] * v2[3]     * v1[0] - cj(v3[1]) * cj(v2[2]) * v1[3] ;
+      Q2[1] =  v3[3] * v2[0]     * v1[0] + cj(v3[0]) * cj(v2[1]) * v1[3] ;
+      Q2[2] =  v3[2] * cj(v2[0]) * v1[1] + cj(v3[1]) * v2[1]     * v1[2] ;
+      Q2[3] = -v3[3] * cj(v2[3]) * v1[1] + cj(v3[0]) * v2[2]     * v1[2] ;
+    } else {
+      Q1[0] =  v3[0]     * v2[0]     * v1[0]     - cj(v3[3]) * v2[1]     * v1[3] ;
+      Q1[1] =  cj(v3[1]) * v2[3]     * v1[0]     + v3[2]     * v2[2]     * v1[3] ;
+      Q1[2] = -v3[0]     * cj(v2[3]) * cj(v1[1]) - cj(v3[3]) * cj(v2[2]) * cj(v1[2]) ;
+      Q1[3] =  cj(v3[1]) * cj(v2[0]) * cj(v1[1]) - v3[2]     * cj(v2[1]) * cj(v1[2]) ;
+
+      Q2[0] = -cj(v3[2]) * v2[3]     * v1[0]     + v3[1]     * v2[2]     * v1[3] ;
+      Q2[1] =  v3[3]     * v2[0]     * v1[0]     + cj(v3[0]) * v2[1]     * v1[3] ;
+      Q2[2] = -cj(v3[2]) * cj(v2[0]) * cj(v1[1]) - v3[1]     * cj(v2[1]) * cj(v1[2]) ;
+      Q2[3] = -v3[3]     * cj(v2[3]) * cj(v1[1]) + cj(v3[0]) * cj(v2[2]) * cj(v1[2]) ;
+    }
+
+    // factorization of turnoverTFXY
+    const R n1 = std::sqrt( Q1[0].norm() + Q1[1].norm() +
+                            Q1[2].norm() + Q1[3].norm() ) ;
+    const R n2 = std::sqrt( Q2[0].norm() + Q2[1].norm() +
+                            Q2[2].norm() + Q2[3].norm() ) ;
+    const bool first = ( n1 - n2 < 100*eps ) |
+                       ( Q2[1].norm() + Q2[2].norm() == 0 ) ;
+
+    //
+    // diagonalize, anti-diagonalize, diagonalize, anti-diagonalize
+    //
+    C U1[2] , V1[2] , Y1[2] , Z1[2] , D1[4] ;
+    bool ok1 ;
+    {
+      C U[4] , V[4] , Y[4] , Z[4] , W[4] , P[4] ;
+      C* D = D1 ;
+
+      // (1) compute U, Y that diagonalize (Q11,Q33)
+      D[0] = Q1[0] ; D[1] = Q1[1] ; D[2] = Q1[2] ; D[3] = Q1[3] ;
+      Z[0] =  cj(Q1[3]) ;
+      Z[1] = -cj(Q1[2]) ;
+      Z[2] = -cj(Q1[1]) ;
+      Z[3] =  cj(Q1[0]) ;
+      ok1 = diagonalize22Lane( D , Z , U , Y ) ;
+
+      // (2) compute V to anti-diagonalize (Q41,Q23)
+      P[0] =  cj(Q2[3]) ;
+      P[1] = -cj(Q2[2]) ;
+      P[2] = -cj(Q2[1]) ;
+      P[3] =  cj(Q2[0]) ;
+      gemm22( P , Y , W ) ;   // AD23
+      gemm22( Q2 , Y , Z ) ;  // AD41
+      const bool ad41 = Z[1].abs() + Z[3].abs() > W[1].abs() + W[3].abs() ;
+      P[0] = select( ad41 , Z[0] , W[0] ) ;
+      P[1] = select( ad41 , Z[1] , W[1] ) ;
+      P[2] = select( ad41 , Z[2] , W[2] ) ;
+      P[3] = select( ad41 , Z[3] , W[3] ) ;
+      const bool last = P[3].norm() > P[1].norm() ;
+      rotateToZeroLLane( select( last , P[2] , P[1] ) ,
+                         select( last , P[3] , P[0] ) , W ) ;
+      // V = rot90(V,2) if the first row is reduced
+      V[0] = select( last , W[0] , W[3] ) ;
+      V[1] = select( last , W[1] , W[2] ) ;
+      V[2] = select( last , W[2] , W[1] ) ;
+      V[3] = select( last , W[3] , W[0] ) ;
+      D[1] = V[1] * Z[0] + V[3] * Z[1] ;
+      D[2] = V[0] * Z[2] + V[2] * Z[3] ;
+
+      // (3) compute Z to diagonalize (Q22,Q44)
+      C* Q = P ;
+      if constexpr ( vee ) {
+        Q[0] =  v3[0] * v2[1]     * v1[0] - cj(v3[3]) * cj(v2[0]) * v1[3] ;
+        Q[1] =  v3[1] * v2[2]     * v1[0] + cj(v3[2]) * cj(v2[3]) * v1[3] ;
+        Q[2] = -v3[0] * cj(v2[2]) * v1[1] - cj(v3[3]) * v2[3]     * v1[2] ;
+        Q[3] =  v3[1] * cj(v2[1]) * v1[1] - cj(v3[2]) * v2[0]     * v1[2] ;
+      } else {
+        Q[0] =  v3[0]     * cj(v2[1]) * v1[0]     - cj(v3[3]) * cj(v2[0]) * v1[3] ;
+        Q[1] = -cj(v3[1]) * cj(v2[2]) * v1[0]     - v3[2]     * cj(v2[3]) * v1[3] ;
+        Q[2] =  v3[0]     * v2[2]     * cj(v1[1]) + cj(v3[3]) * v2[3]     * cj(v1[2]) ;
+        Q[3] =  cj(v3[1]) * v2[1]     * cj(v1[1]) - v3[2]     * v2[0]     * cj(v1[2]) ;
+      }
+      rotateToZeroRLane( V[1] * Q[2] + V[3] * Q[3] ,
+                         V[1] * Q[0] + V[3] * Q[1] , Z ) ;
+      rotateToZeroRLane( -V[1] * cj(Q[1]) + V[3] * cj(Q[0]) ,
+                          V[1] * cj(Q[3]) - V[3] * cj(Q[2]) , W ) ;
+      // free Y
+      U[1] = Y[0] ;
+      U[3] = Y[2] ;
+      gemm22( V , Q , Y ) ;
+      const bool useW = ( ( D[0] - ( Y[0]*W[0] + Y[2]*W[1] ) ).abs() +
+                          ( D[3] - ( Y[1]*W[2] + Y[3]*W[3] ) ).abs() ) <
+                        ( ( D[0] - ( Y[0]*Z[0] + Y[2]*Z[1] ) ).abs() +
+                          ( D[3] - ( Y[1]*Z[2] + Y[3]*Z[3] ) ).abs() ) ;
+
+      // (4) results, only the first rows of U, V, Y, and Z are used
+      U1[0] = U[0] ; U1[1] = U[2] ;
+      V1[0] = V[0] ; V1[1] = V[2] ;
+      Y1[0] = U[1] ; Y1[1] = U[3] ;
+      Z1[0] = select( useW , W[0] , Z[0] ) ;
+      Z1[1] = select( useW , W[2] , Z[2] ) ;
+    }
+
+    //
+    // anti-diagonalize, diagonalize, anti-diagonalize, diagonalize
+    //
+    C U2[2] , V2[2] , Y2[2] , Z2[2] , D2[4] ;
+    bool ok2 ;
+    {
+      C U[4] , V[4] , Y[4] , Z[4] , W[4] , Q[4] ;
+      C* D = D2 ;
+
+      // (1) compute V, Y that anti-diagonalize (Q23,Q41)
+      Z[0] =  cj(Q2[3]) ;
+      Z[1] =  cj(Q2[2]) ;
+      Z[2] = -cj(Q2[1]) ;
+      Z[3] = -cj(Q2[0]) ;
+      D[0] = Q2[0] ; D[1] = -Q2[1] ; D[2] = Q2[2] ; D[3] = -Q2[3] ;
+      ok2 = diagonalize22Lane( Z , D , W , Y ) ;
+      D[1] = D[0] ;
+      D[2] = D[3] ;
+      // V = flipud(V), V(:,2) = -V(:,2)
+      V[0] = W[1] ; V[1] = W[0] ; V[2] = -W[3] ; V[3] = -W[2] ;
+
+      // (2) compute U to diagonalize (Q11,Q33)
+      gemm22( Q1 , Y , Z ) ;
+      D[0] = -cj(Q1[2]) * Y[0] + cj(Q1[0]) * Y[1] ;
+      const bool lower = Z[1].norm() > D[0].norm() ;
+      rotateToZeroLLane( select( lower , Z[0] ,
+                                 cj(Q1[3]) * Y[0] - cj(Q1[1]) * Y[1] ) ,
+                         select( lower , Z[1] , D[0] ) , U ) ;
+      // D = U * Z
+      D[0] = U[0] * Z[0] + U[2] * Z[1] ;
+      D[3] = U[1] * Z[2] + U[3] * Z[3] ;
+
+      // (3) compute Z to anti-diagonalize (Q14,Q32)
+      if constexpr ( vee ) {
+        Q[0] =  v3[2] * v2[2]     * v1[0] - cj(v3[1]) * cj(v2[3]) * v1[3] ;
+        Q[1] =  v3[3] * v2[1]     * v1[0] + cj(v3[0]) * cj(v2[0]) * v1[3] ;
+        Q[2] =  v3[2] * cj(v2[1]) * v1[1] + cj(v3[1]) * v2[0]     * v1[2] ;
+        Q[3] = -v3[3] * cj(v2[2]) * v1[1] + cj(v3[0]) * v2[3]     * v1[2] ;
+      } else {
+        Q[0] =  cj(v3[2]) * cj(v2[2]) * v1[0]     - v3[1]     * cj(v2[3]) * v1[3] ;
+        Q[1] =  v3[3]     * cj(v2[1]) * v1[0]     + cj(v3[0]) * cj(v2[0]) * v1[3] ;
+        Q[2] = -cj(v3[2]) * v2[1]     * cj(v1[1]) - v3[1]     * v2[0]     * cj(v1[2]) ;
+        Q[3] =  v3[3]     * v2[2]     * cj(v1[1]) - cj(v3[0]) * v2[3]     * cj(v1[2]) ;
+      }
+      rotateToZeroRLane( U[0] * Q[2] + U[2] * Q[3] ,
+                         U[0] * Q[0] + U[2] * Q[1] , Z ) ;
+      rotateToZeroRLane( -U[0] * cj(Q[1]) + U[2] * cj(Q[0]) ,
+                          U[0] * cj(Q[3]) - U[2] * cj(Q[2]) , W ) ;
+      // free Y
+      V[1] = Y[0] ;
+      V[3] = Y[2] ;
+      gemm22( U , Q , Y ) ;
+      const bool useW = ( ( D[1] - ( Y[1]*W[0] + Y[3]*W[1] ) ).abs() +
+                          ( D[2] - ( Y[0]*W[2] + Y[2]*W[3] ) ).abs() ) <
+                        ( ( D[1] - ( Y[1]*Z[0] + Y[3]*Z[1] ) ).abs() +
+                          ( D[2] - ( Y[0]*Z[2] + Y[2]*Z[3] ) ).abs() ) ;
+
+      // (4) results, only the first rows of U, V, Y, and Z are used
+      U2[0] = U[0] ; U2[1] = U[2] ;
+      V2[0] = V[0] ; V2[1] = V[2] ;
+      Y2[0] = V[1] ; Y2[1] = V[3] ;
+      Z2[0] = select( useW , W[0] , Z[0] ) ;
+      Z2[1] = select( useW , W[2] , Z[2] ) ;
+    }
+
+    // select the factorization
+    const C y0 = select( first , Y1[0] , Y2[0] ) ;
+    const C y2 = select( first , Y1[1] , Y2[1] ) ;
+    const C z0 = select( first , Z1[0] , Z2[0] ) ;
+    const C z2 = select( first , Z1[1] , Z2[1] ) ;
+    const C u0 = select( first , U1[0] , U2[0] ) ;
+    const C u2 = select( first , U1[1] , U2[1] ) ;
+    const C w0 = select( first , V1[0] , V2[0] ) ;
+    const C w2 = select( first , V1[1] , V2[1] ) ;
+    const C v[4] = { select( first , D1[0] , D2[0] ) ,
+                     select( first , D1[1] , D2[1] ) ,
+                     select( first , D1[2] , D2[2] ) ,
+                     select( first , D1[3] , D2[3] ) } ;
+
+    // new values
+    if constexpr ( vee ) {
+      // vee --> hat
+      vA[0] = cj( y0 ) ; vA[1] = cj( z0 ) ; vA[2] = cj( z2 ) ; vA[3] = cj( y2 ) ;
+      vB[0] = v[0] ; vB[1] = v[3] ; vB[2] = v[2] ; vB[3] = v[1] ;
+      vC[0] = cj( u0 ) ; vC[1] = cj( w0 ) ; vC[2] = cj( w2 ) ; vC[3] = cj( u2 ) ;
+    } else {
+      // hat --> vee
+      vA[0] = cj( y0 ) ; vA[1] = z0 ; vA[2] = -z2 ; vA[3] = cj( y2 ) ;
+      vB[0] = v[0] ; vB[1] = cj( v[3] ) ; vB[2] = -cj( v[2] ) ; vB[3] = v[1] ;
+      vC[0] = cj( u0 ) ; vC[1] = w0 ; vC[2] = -w2 ; vC[3] = cj( u2 ) ;
+    }
+
+    // diagonal gates take the fast path of turnoverTFXY
+    const auto diagonal = []( const C* v ) {
+      return ( v[2].re == 0 ) & ( v[2].im == 0 ) &
+             ( v[3].re == 0 ) & ( v[3].im == 0 ) ;
+    } ;
+    return ( first ? ok1 : ok2 ) &
+           !( diagonal( v1 ) | diagonal( v2 ) | diagonal( v3 ) ) ;
+
+  }
+
+  /// Loads the split complex values in lane `j` of `v` with stride `ld`.
+  template <typename R>
+  F3C_ALWAYS_INLINE void loadLane( const R* v , const std::size_t ld ,
+                                   const std::size_t j ,
+                                   SplitComplex< R >* x ) {
+    x[0] = { v[j]        , v[ld + j]   } ;
+    x[1] = { v[2*ld + j] , v[3*ld + j] } ;
+    x[2] = { v[4*ld + j] , v[5*ld + j] } ;
+    x[3] = { v[6*ld + j] , v[7*ld + j] } ;
+  }
+
+  /**
+   * \brief Stores the split complex values `x` in lane `j` of `v` with
+   *        stride `ld`.
+   */
+  template <typename R>
+  F3C_ALWAYS_INLINE void storeLane( const SplitComplex< R >* x , R* v ,
+                                    const std::size_t ld ,
+                                    const std::size_t j ) {
+    R* w = v + j ;
+    w[0]    = x[0].re ;  w[ld]   = x[0].im ;
+    w[2*ld] = x[1].re ;  w[3*ld] = x[1].im ;
+    w[4*ld] = x[2].re ;  w[5*ld] = x[2].im ;
+    w[6*ld] = x[3].re ;  w[7*ld] = x[3].im ;
+  }
+
+  /**
+   * \brief Computes lane `i` of turnoverTFXYBatch with turnoverTFXYLane.
+   *
+   * The inputs are read from lane `i` with stride `li`, the outputs are
+   * written to lane `j` with stride `lo`. The split complex work arrays are
+   * local to this function, such that they are scalarized after inlining and
+   * do not become per-lane arrays of the enclosing SIMD loop.
+   */
+  template <bool vee, typename R>
+  F3C_ALWAYS_INLINE int turnoverTFXYBatchLane( const std::size_t li ,
+                                               const std::size_t i ,
+                                               const R* v1 , const R* v2 ,
+                                               const R* v3 ,
+                                               const std::size_t lo ,
+                                               const std::size_t j ,
+                                               R* vA , R* vB , R* vC ) {
+    SplitComplex< R >  x1[4] , x2[4] , x3[4] , xA[4] , xB[4] , xC[4] ;
+    loadLane( v1 , li , i , x1 ) ;
+    loadLane( v2 , li , i , x2 ) ;
+    loadLane( v3 , li , i , x3 ) ;
+    const bool ok = turnoverTFXYLane< vee >( x1 , x2 , x3 , xA , xB , xC ) ;
+    storeLane( xA , vA , lo , j ) ;
+    storeLane( xB , vB , lo , j ) ;
+    storeLane( xC , vC , lo , j ) ;
+    return ok ? 1 : 0 ;
+  }
+
+  /**
+   * \brief Computes the turnover operation of a batch of `n` triples of
+   *        TFXY-rotation matrix gates in split real/imaginary arithmetic.
+   *
+   * The real and imaginary parts of value k = 0, ..., 3 of the `i`-th gate
+   * of `v1` are stored in `v1[2*k*ld + i]` and `v1[(2*k+1)*ld + i]`, and
+   * similarly for `v2`, ..., `vC`. The inputs are copied chunk by chunk to
+   * local storage, such that the outputs can alias the inputs of the same
+   * triple. The lanes are computed with turnoverTFXYLane in a loop that is
+   * free of branches and function calls and is compiled to SIMD
+   * instructions. The lanes that turnoverTFXYLane rejects are recomputed
+   * afterwards with turnoverTFXY.
+   */
+  template <bool vee, typename R>
+  void turnoverTFXYBatch( const std::size_t n , const std::size_t ld ,
+                          const R* v1 , const R* v2 , const R* v3 ,
+                          R* vA , R* vB , R* vC ) {
+
+    using T = std::complex< R > ;
+    constexpr std::size_t chunk = 64 ;
+    R x[3][8][chunk] ;
+    int ok[chunk] ;
+
+    for ( std::size_t first = 0; first < n; first += chunk ) {
+      const std::size_t m = std::min( chunk , n - first ) ;
+      // copy inputs
+      for ( int k = 0; k < 8; k++ ) {
+        std::copy_n( v1 + k*ld + first , m , x[0][k] ) ;
+        std::copy_n( v2 + k*ld + first , m , x[1][k] ) ;
+        std::copy_n( v3 + k*ld + first , m , x[2][k] ) ;
+      }
+      // SIMD lanes
+      #pragma omp simd
+      for ( std::size_t i = 0; i < m; i++ ) {
+        ok[i] = turnoverTFXYBatchLane< vee >( chunk , i , x[0][0] , x[1][0] ,
+                                              x[2][0] , ld , first + i ,
+                                              vA , vB , vC ) ;
+      }
+      // rejected lanes
+      for ( std::size_t i = 0; i < m; i++ ) {
+        if ( ok[i] ) continue ;
+        const std::size_t j = first + i ;
+        std::array< T , 4 >  x1 , x2 , x3 , xA , xB , xC ;
+        for ( int k = 0; k < 4; k++ ) {
+          x1[k] = T( x[0][2*k][i] , x[0][2*k+1][i] ) ;
+          x2[k] = T( x[1][2*k][i] , x[1][2*k+1][i] ) ;
+          x3[k] = T( x[2][2*k][i] , x[2][2*k+1][i] ) ;
+        }
+        turnoverTFXY< vee >( x1.data() , x2.data() , x3.data() ,
+                             xA.data() , xB.data() , xC.data() ) ;
+        for ( int k = 0; k < 4; k++ ) {
+          vA[2*k*ld + j] = std::real( xA[k] ) ;
+          vA[(2*k+1)*ld + j] = std::imag( xA[k] ) ;
+          vB[2*k*ld + j] = std::real( xB[k] ) ;
+          vB[(2*k+1)*ld + j] = std::imag( xB[k] ) ;
+          vC[2*k*ld + j] = std::real( xC[k] ) ;
+          vC[(2*k+1)*ld + j] = std::imag( xC[k] ) ;
+        }
+      }
+    }
+
+  }
+
+
+  /**
+   * \brief Computes the turnover operation of a batch of 3 TFXY-rotation
+   *        matrix gates.
+   *
+   * The `i`-th gates of `gatesA`, `gatesB`, and `gatesC` are the turnover of
+   * the `i`-th gates of `gates1`, `gates2`, and `gates3`. All triples have the
+   * same orientation: `vee` is true for vee --> hat and false for hat --> vee
+   * turnovers. The turnovers are computed with turnoverTFXYBatch, triples
+   * with a diagonal gate take the fast path turnoverDiagonalTFXY.
+   */
+  template <typename R>
+  void turnoverBatch( const bool vee ,
+                      const TFXYBatch< R >& gates1 ,
+                      const TFXYBatch< R >& gates2 ,
+                      const TFXYBatch< R >& gates3 ,
+                      TFXYBatch< R >& gatesA ,
+                      TFXYBatch< R >& gatesB ,
+                      TFXYBatch< R >& gatesC ) {
+
+    const auto n = gates1.size() ;
+    assert( gates2.size() == n ) ;
+    assert( gates3.size() == n ) ;
+    gatesA.resize( n ) ;
+    gatesB.resize( n ) ;
+    gatesC.resize( n ) ;
+
+    if ( vee ) {
+      turnoverTFXYBatch< true >( n , n , gates1.data() , gates2.data() ,
+                                 gates3.data() , gatesA.data() ,
+                                 gatesB.data() , gatesC.data() ) ;
+    } else {
+      turnoverTFXYBatch< false >( n , n , gates1.data() , gates2.data() ,
+                                  gates3.data() , gatesA.data() ,
+                                  gatesB.data() , gatesC.data() ) ;
+    }
+
+  }
+
+
+  /**
+   * \brief Computes the turnover operation of a batch of `n` triples of
+   *        TFXY-rotation matrix gates.
+   *
+   * The `i`-th gates `*gatesA[i]`, `*gatesB[i]`, and `*gatesC[i]` are the
+   * turnover of the `i`-th gates `*gates1[i]`, `*gates2[i]`, and
+   * `*gates3[i]`. The output gates may be the input gates of the same triple,
+   * e.g., for a turnover in place. The values are gathered in chunks of SIMD
+   * lanes for turnoverTFXYBatch, separately for vees and hats.
+   */
+  template <typename G,
+            std::enable_if_t< f3c::is_TFXY_matrix_v< G > , bool > = true >
+  void turnoverBatch( const std::size_t n ,
+                      const G* const* gates1 ,
+                      const G* const* gates2 ,
+                      const G* const* gates3 ,
+                      G* const* gatesA ,
+                      G* const* gatesB ,
+                      G* const* gatesC ) {
+
+    using T = typename G::value_type ;
+    using R = qclab::real_t< T > ;
+    constexpr std::size_t chunk = 64 ;
+    R x[3][8][chunk] ;
+
+    // stores the values `v` in lane `i` of `x`
+    auto gather = []( R (*x)[chunk] , const std::size_t i ,
+                      const std::array< T , 4 >& v ) {
+      for ( int k = 0; k < 4; k++ ) {
+        x[2*k][i] = std::real( v[k] ) ;
+        x[2*k+1][i] = std::imag( v[k] ) ;
+      }
+    } ;
+    // returns the gate on `qubits` with the values in lane `i` of `x`
+    auto scatter = []( R (*x)[chunk] , const std::size_t i ,
+                       const std::array< int , 2 >& qubits ) {
+      return G( qubits[0] , qubits[1] , T( x[0][i] , x[1][i] ) ,
+                T( x[2][i] , x[3][i] ) , T( x[4][i] , x[5][i] ) ,
+                T( x[6][i] , x[7][i] ) ) ;
+    } ;
+
+    std::size_t lanes[chunk] ;
+    std::array< int , 2 >  qubits1[chunk] ;
+    std::array< int , 2 >  qubits2[chunk] ;
+    bool vees[chunk] ;
+    for ( std::size_t first = 0; first < n; first += chunk ) {
+      const std::size_t m = std::min( chunk , n - first ) ;
+      // orientations, before any output gate of the chunk is written
+      for ( std::size_t i = 0; i < m; i++ ) {
+        vees[i] = f3c::qubitPair( *gates2[first + i] )[0] >
+                  f3c::qubitPair( *gates1[first + i] )[0] ;
+      }
+      for ( const bool vee : { true , false } ) {
+        // gather the triples with orientation `vee`
+        std::size_t l = 0 ;
+        for ( std::size_t i = first; i < first + m; i++ ) {
+          if ( vees[i - first] != vee ) continue ;
+          gather( x[0] , l , gates1[i]->values() ) ;
+          gather( x[1] , l , gates2[i]->values() ) ;
+          gather( x[2] , l , gates3[i]->values() ) ;
+          qubits1[l] = f3c::qubitPair( *gates1[i] ) ;
+          qubits2[l] = f3c::qubitPair( *gates2[i] ) ;
+          lanes[l++] = i ;
+        }
+        if ( l == 0 ) continue ;
+        // turnovers in place
+        if ( vee ) {
+          turnoverTFXYBatch< true >( l , chunk , x[0][0] , x[1][0] , x[2][0] ,
+                                     x[0][0] , x[1][0] , x[2][0] ) ;
+        } else {
+          turnoverTFXYBatch< false >( l , chunk , x[0][0] , x[1][0] , x[2][0] ,
+                                      x[0][0] , x[1][0] , x[2][0] ) ;
+        }
+        // scatter
+        for ( std::size_t i = 0; i < l; i++ ) {
+          *gatesA[lanes[i]] = scatter( x[0] , i , qubits2[i] ) ;
+          *gatesB[lanes[i]] = scatter( x[1] , i , qubits1[i] ) ;
+          *gatesC[lanes[i]] = scatter( x[2] , i , qubits2[i] ) ;
+        }
+      }
+    }
+
+  }
+
+
+  /**
+   * \brief Computes the turnover operation of a batch of `n` triples of
+   *        X-Y-X / XX-Y-XX / X-YY-X / XX-YY-XX, ... rotation gates.
+   *
+   * The `i`-th gates `*gatesA[i]`, `*gatesB[i]`, and `*gatesC[i]` are the
+   * turnover of the `i`-th gates `*gates1[i]`, `*gates2[i]`, and
+   * `*gates3[i]`. The output gates may be the input gates of the same triple,
+   * e.g., for a turnover in place. The rotations are gathered in chunks of
+   * SIMD lanes for turnoverSU2Batch.
+   */
+  template <typename G1, typename G2,
+            std::enable_if_t< ( f3c::is_one_axis1_v< G1 > ||
+                                f3c::is_one_axis2_v< G1 > ) &&
+                              ( f3c::is_one_axis1_v< G2 > ||
+                                f3c::is_one_axis2_v< G2 > ) &&
+                              !f3c::is_same_axis_v< G1 , G2 > , bool > = true >
+  void turnoverBatch( const std::size_t n ,
+                      const G1* const* gates1 ,
+                      const G2* const* gates2 ,
+                      const G1* const* gates3 ,
+                      G2* const* gatesA ,
+                      G1* const* gatesB ,
+                      G2* const* gatesC ) {
+
+    using R = qclab::real_t< typename G1::value_type > ;
+    using rotation_type = qclab::QRotation< R > ;
+    constexpr std::size_t chunk = 64 ;
+    R in[6][chunk] ;
+    R out[6][chunk] ;
+
+    for ( std::size_t first = 0; first < n; first += chunk ) {
+      const std::size_t m = std::min( chunk , n - first ) ;
+      // gather
+      for ( std::size_t i = 0; i < m; i++ ) {
+        const auto& rot1 = gates1[first + i]->rotation() ;
+        const auto& rot2 = gates2[first + i]->rotation() ;
+        const auto& rot3 = gates3[first + i]->rotation() ;
+        in[0][i] = rot1.cos() ;  in[1][i] = rot1.sin() ;
+        in[2][i] = rot2.cos() ;  in[3][i] = rot2.sin() ;
+        in[4][i] = rot3.cos() ;  in[5][i] = rot3.sin() ;
+      }
+      // SU(2) turnovers
+      turnoverSU2Batch( m , in[0] , in[1] , in[2] , in[3] , in[4] , in[5] ,
+                        out[0] , out[1] , out[2] , out[3] , out[4] , out[5] ) ;
+      // scatter
+      for ( std::size_t i = 0; i < m; i++ ) {
+        G2  gateA( *gates2[first + i] ) ;
+        G1  gateB( *gates1[first + i] ) ;
+        G2  gateC( *gates2[first + i] ) ;
+        gateA.update( rotation_type( out[0][i] , out[1][i] ) ) ;
+        gateB.update( rotation_type( out[2][i] , out[3][i] ) ) ;
+        gateC.update( rotation_type( out[4][i] , out[5][i] ) ) ;
+        *gatesA[first + i] = gateA ;
+        *gatesB[first + i] = gateB ;
+        *gatesC[first + i] = gateC ;
+      }
+    }
+
+  }
+
+
+  /**
+   * \brief Computes the turnover operation of a batch of `n` triples of
+   *        XY/XZ/YZ-rotation gates.
+   *
+   * The `i`-th gates `*gatesA[i]`, `*gatesB[i]`, and `*gatesC[i]` are the
+   * turnover of the `i`-th gates `*gates1[i]`, `*gates2[i]`, and
+   * `*gates3[i]`. The output gates may be the input gates of the same triple,
+   * e.g., for a turnover in place. The 2 SU(2) turnovers of every triple are
+   * consecutive SIMD lanes of turnoverSU2Batch.
+   */
+  template <typename G,
+            std::enable_if_t< f3c::is_two_axes_v< G > , bool > = true >
+  void turnoverBatch( const std::size_t n ,
+                      const G* const* gates1 ,
+                      const G* const* gates2 ,
+                      const G* const* gates3 ,
+                      G* const* gatesA ,
+                      G* const* gatesB ,
+                      G* const* gatesC ) {
+
+    using R = typename G::real_type ;
+    using rotation_type = typename G::rotation_type ;
+    constexpr std::size_t chunk = 32 ;
+    R in[6][2*chunk] ;
+    R out[6][2*chunk] ;
+
+    // stores the rotations `rot1`, `rot2`, and `rot3` in lane `k`
+    auto gather = [&in]( const std::size_t k , const rotation_type& rot1 ,
+                         const rotation_type& rot2 ,
+                         const rotation_type& rot3 ) {
+      in[0][k] = rot1.cos() ;  in[1][k] = rot1.sin() ;
+      in[2][k] = rot2.cos() ;  in[3][k] = rot2.sin() ;
+      in[4][k] = rot3.cos() ;  in[5][k] = rot3.sin() ;
+    } ;
+
+    for ( std::size_t first = 0; first < n; first += chunk ) {
+      const std::size_t m = std::min( chunk , n - first ) ;
+      // gather
+      for ( std::size_t i = 0; i < m; i++ ) {
+        const auto& [ rot10 , rot11 ] = gates1[first + i]->rotations() ;
+        const auto& [ rot20 , rot21 ] = gates2[first + i]->rotations() ;
+        const auto& [ rot30 , rot31 ] = gates3[first + i]->rotations() ;
+        gather( 2*i     , rot10 , rot21 , rot30 ) ;
+        gather( 2*i + 1 , rot11 , rot20 , rot31 ) ;
+      }
+      // SU(2) turnovers
+      turnoverSU2Batch( 2*m , in[0] , in[1] , in[2] , in[3] , in[4] , in[5] ,
+                        out[0] , out[1] , out[2] , out[3] , out[4] , out[5] ) ;
+      // scatter
+      for ( std::size_t i = 0; i < m; i++ ) {
+        const std::size_t k0 = 2*i ;
+        const std::size_t k1 = 2*i + 1 ;
+        G  gateA( *gates2[first + i] ) ;
+        G  gateB( *gates1[first + i] ) ;
+        G  gateC( *gates2[first + i] ) ;
+        gateA.update( rotation_type( out[0][k1] , out[1][k1] ) ,
+                      rotation_type( out[0][k0] , out[1][k0] ) ) ;
+        gateB.update( rotation_type( out[2][k0] , out[3][k0] ) ,
+                      rotation_type( out[2][k1] , out[3][k1] ) ) ;
+        gateC.update( rotation_type( out[4][k1] , out[5][k1] ) ,
+                      rotation_type( out[4][k0] , out[5][k0] ) ) ;
+        *gatesA[first + i] = gateA ;
+        *gatesB[first + i] = gateB ;
+        *gatesC[first + i] = gateC ;
+      }
+    }
+
+  }
+
+
+  /**
+   * \brief Computes the turnover operation of a batch of `n` triples of
+   *        TFIM-rotation gates.
+   *
+   * The `i`-th gates `*gatesA[i]`, `*gatesB[i]`, and `*gatesC[i]` are the
+   * turnover of the `i`-th gates `*gates1[i]`, `*gates2[i]`, and
+   * `*gates3[i]`. The output gates may be the input gates of the same triple,
+   * e.g., for a turnover in place. Every triple is a single SIMD lane of
+   * turnoverSU2Batch.
+   */
+  template <typename G,
+            std::enable_if_t< f3c::is_TFIM_v< G > , bool > = true >
+  void turnoverBatch( const std::size_t n ,
+                      const G* const* gates1 ,
+                      const G* const* gates2 ,
+                      const G* const* gates3 ,
+                      G* const* gatesA ,
+                      G* const* gatesB ,
+                      G* const* gatesC ) {
+
+    using R = typename G::real_type ;
+    using rotation_type = typename G::rotation_type ;
+    constexpr std::size_t chunk = 64 ;
+    R in[6][chunk] ;
+    R out[6][chunk] ;
+
+    for ( std::size_t first = 0; first < n; first += chunk ) {
+      const std::size_t m = std::min( chunk , n - first ) ;
+      // gather
+      for ( std::size_t i = 0; i < m; i++ ) {
+        const auto& rot1 = gates1[first + i]->rotation() ;
+        const auto& rot2 = gates2[first + i]->rotation() ;
+        const auto& rot3 = gates3[first + i]->rotation() ;
+        in[0][i] = rot1.cos() ;  in[1][i] = rot1.sin() ;
+        in[2][i] = rot2.cos() ;  in[3][i] = rot2.sin() ;
+        in[4][i] = rot3.cos() ;  in[5][i] = rot3.sin() ;
+      }
+      // SU(2) turnovers
+      turnoverSU2Batch( m , in[0] , in[1] , in[2] , in[3] , in[4] , in[5] ,
+                        out[0] , out[1] , out[2] , out[3] , out[4] , out[5] ) ;
+      // scatter
+      for ( std::size_t i = 0; i < m; i++ ) {
+        const auto q1 = gates1[first + i]->qubitPair() ;
+        const auto q2 = gates2[first + i]->qubitPair() ;
+        *gatesA[first + i] = G( q2[0] , q2[1] ,
+                                rotation_type( out[0][i] , out[1][i] ) ) ;
+        *gatesB[first + i] = G( q1[0] , q1[1] ,
+                                rotation_type( out[2][i] , out[3][i] ) ) ;
+        *gatesC[first + i] = G( q2[0] , q2[1] ,
+                                rotation_type( out[4][i] , out[5][i] ) ) ;
+      }
+    }
+
+  }
+
+} // namespace f3c
+
+#endif
+
@@ -5,9 +5,113 @@
 
 #include "f3c/util.hpp"
 #include "qclab/QRotation.hpp"
+#include <limits>
 
 namespace f3c {
 
+  /**
+   * \brief Computes the cosine `c` and sine `s` of the rotation that rotates
+   *        the vector (`x`,`y`) to the first axis, without branches.
+   *
+   * Contrary to rotateToZero, the norm is not scaled. The vectors in the SU(2)
+   * turnover have a squared norm between 2 and 4.
+   */
+  template <typename R>
+  inline void rotateToZeroSU2( const R x , const R y , R& c , R& s ) {
+    const R tiny = std::numeric_limits< R >::min() ;
+    const R r2 = x*x + y*y ;
+    const R inv = R(1) / std::sqrt( ( r2 > tiny ) ? r2 : tiny ) ;
+    c = ( r2 > 0 ) ? x * inv : R(1) ;
+    s = y * inv ;
+  }
+
+  /**
+   * \brief Computes the cosines and sines of the turnover of 3 quantum
+   *        rotations that form SU(2).
+   *
+   * All case distinctions are selections between computed values, such that
+   * the same code runs in the SIMD lanes of turnoverSU2Batch. If one of the
+   * rotations is the identity, the result is exact.
+   */
+  template <typename R>
+  inline void turnoverSU2( const R c1 , const R s1 ,
+                           const R c2 , const R s2 ,
+                           const R c3 , const R s3 ,
+                           R& rca , R& rsa , R& rcb , R& rsb ,
+                           R& rcc , R& rsc ) {
+
+    // rot1 * rot3 and rot1 / rot3
+    const R cp = c1 * c3 - s1 * s3 ;
+    const R sp = s1 * c3 + c1 * s3 ;
+    const R cm = c1 * c3 + s1 * s3 ;
+    const R sm = s1 * c3 - c1 * s3 ;
+
+    R ar =  c2 * cp ;
+    R ai = -s2 * cm ;
+    R br =  c2 * sp ;
+    R bi = -s2 * sm ;
+
+    // rotation B
+    const R cb = std::sqrt( ar*ar + ai*ai ) ;
+    const R sb = std::sqrt( br*br + bi*bi ) ;
+    const R tiny = std::numeric_limits< R >::min() ;
+    const R icb = R(1) / ( ( cb > tiny ) ? cb : tiny ) ;
+    const R isb = R(1) / ( ( sb > tiny ) ? sb : tiny ) ;
+    ar *= icb ;
+    ai *= icb ;
+    br *= isb ;
+    bi *= isb ;
+    // rotB is the identity: only rotA * rotC is defined
+    const bool identity = ( sb == 0 ) ;
+    br = identity ? ar : br ;
+    bi = identity ? ai : bi ;
+    // rotB is a pi-rotation: only rotC / rotA is defined
+    const bool pi = !identity & ( cb == 0 ) ;
+    ar = pi ? br : ar ;
+    ai = pi ? bi : ai ;
+
+    // rotation A
+    const R xp = ar + br ;
+    const R yp = bi - ai ;
+    const R xm = -ai - bi ;
+    const R ym = br - ar ;
+    const bool plusA = ( xp*xp + yp*yp >= xm*xm + ym*ym ) ;
+    R ca , sa ;
+    rotateToZeroSU2( plusA ? xp : xm , plusA ? yp : ym , ca , sa ) ;
+
+    // rotation C
+    const bool plusC = ( yp*yp + ym*ym > xp*xp + xm*xm ) ;
+    R cc , sc ;
+    rotateToZeroSU2( plusC ? yp : xp , plusC ? ym : xm , cc , sc ) ;
+    // sign of rotation C, based on the dominant part of rotation B
+    const R fa = ar * ( ca * cc - sa * sc ) - ai * ( sa * cc + ca * sc ) ;
+    const R fb = br * ( ca * cc + sa * sc ) - bi * ( ca * sc - sa * cc ) ;
+    const R flip = ( ( cb >= sb ) ? fa : fb ) < 0 ? R(-1) : R(1) ;
+
+    // identities: exact results, the other rotations are moved or fused
+    const bool id1 = ( c1 == 1 ) & ( s1 == 0 ) ;
+    const bool id2 = ( c2 == 1 ) & ( s2 == 0 ) ;
+    const bool id3 = !id1 & ( c3 == 1 ) & ( s3 == 0 ) ;
+    const bool idA = id2 | id3 ;
+    const bool idC = id2 | id1 ;
+
+    const R cx = id1 ? c3 : ( id3 ? c1 : cb ) ;
+    const R sx = id1 ? s3 : ( id3 ? s1 : sb ) ;
+    ca = idA ? R(1) : ca ;
+    sa = idA ? R(0) : sa ;
+    cc = idC ? R(1) : flip * cc ;
+    sc = idC ? R(0) : flip * sc ;
+
+    // results
+    rca = id1 ? c2 : ca ;
+    rsa = id1 ? s2 : sa ;
+    rcb = id2 ? cp : cx ;
+    rsb = id2 ? sp : sx ;
+    rcc = id3 ? c2 : cc ;
+    rsc = id3 ? s2 : sc ;
+
+  }
+
   /// Computes the turnover operation on 3 quantum rotations that form SU(2).
   template <typename T>
   std::tuple< qclab::QRotation< T > ,
@@ -17,56 +121,35 @@ namespace f3c {
                const qclab::QRotation< T >& rot2 ,
                const qclab::QRotation< T >& rot3 ) {
 
-    const auto rot1times3 = rot1 * rot3 ;
-    const auto rot1div3 = rot1 / rot3 ;
-
-    auto ar =  rot2.cos() * rot1times3.cos() ;
-    auto ai = -rot2.sin() * rot1div3.cos() ;
-    auto br =  rot2.cos() * rot1times3.sin() ;
-    auto bi = -rot2.sin() * rot1div3.sin() ;
-
-    // rotation B
-    auto cb = std::sqrt( ar*ar + ai*ai ) ;
-    auto sb = std::sqrt( br*br + bi*bi ) ;
-    qclab::QRotation< T >  rotB( cb , sb ) ;
-
-    if ( cb != 0 ) {
-      ar = ar / cb ;
-      ai = ai / cb ;
-    }
-    if ( sb != 0 ) {
-      br = br / sb ;
-      bi = bi / sb ;
-    }
+    T ca , sa , cb , sb , cc , sc ;
+    turnoverSU2( rot1.cos() , rot1.sin() , rot2.cos() , rot2.sin() ,
+                 rot3.cos() , rot3.sin() , ca , sa , cb , sb , cc , sc ) ;
+    return { qclab::QRotation< T >( ca , sa ) ,
+             qclab::QRotation< T >( cb , sb ) ,
+             qclab::QRotation< T >( cc , sc ) } ;
 
-    // rotation A
-    T ca ;
-    T sa ;
-    if ( ( ar + br ) * ( ar + br ) + ( bi - ai ) * ( bi - ai ) >=
-         ( ai + bi ) * ( ai + bi ) + ( br - ar ) * ( br - ar ) ) {
-      std::tie( ca , sa ) = rotateToZero( ar + br , bi - ai ) ;
-    } else {
-      std::tie( ca , sa ) = rotateToZero( -ai - bi , br - ar ) ;
-    }
-    qclab::QRotation< T >  rotA( ca , sa ) ;
+  }
 
-    // rotation C
-    T cc ;
-    T sc ;
-    if ( ( bi - ai ) * ( bi - ai ) + ( br - ar ) * ( br - ar )  >
-         ( ar + br ) * ( ar + br ) + ( ai + bi ) * ( ai + bi ) ) {
-      std::tie( cc , sc ) = rotateToZero( bi - ai , br - ar ) ;
-    } else {
-      std::tie( cc , sc ) = rotateToZero( ar + br , -ai - bi ) ;
+  /**
+   * \brief Computes the turnover operation on a batch of `n` triples of
+   *        quantum rotations that form SU(2).
+   *
+   * The cosines and sines of the `i`-th triple are stored in `c1[i]`,
+   * `s1[i]`, ..., `s3[i]` and the results in `ca[i]`, `sa[i]`, ..., `sc[i]`,
+   * i.e., in structure-of-arrays layout. The loop over the triples is free of
+   * branches and function calls and is compiled to SIMD instructions.
+   */
+  template <typename R>
+  void turnoverSU2Batch( const std::size_t n ,
+                         const R* c1 , const R* s1 ,
+                         const R* c2 , const R* s2 ,
+                         const R* c3 , const R* s3 ,
+                         R* ca , R* sa , R* cb , R* sb , R* cc , R* sc ) {
+    #pragma omp simd
+    for ( std::size_t i = 0; i < n; i++ ) {
+      turnoverSU2( c1[i] , s1[i] , c2[i] , s2[i] , c3[i] , s3[i] ,
+                   ca[i] , sa[i] , cb[i] , sb[i] , cc[i] , sc[i] ) ;
     }
-    if ( sign( ar ) != sign( cb * ( ca * cc - sa * sc ) ) ) {
-      cc = -cc ;
-      sc = -sc ;
-    }
-    qclab::QRotation< T >  rotC( cc , sc ) ;
-
-    return { rotA , rotB , rotC } ;
-
   }
 
 } // namespace f3c
@@ -7,6 +7,16 @@
 #include <cmath>
 #include <array>
 #include <complex>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/// Forces inlining, e.g., of the kernels called in SIMD loops.
+#if defined(__GNUC__) || defined(__clang__)
+  #define F3C_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+  #define F3C_ALWAYS_INLINE inline
+#endif
 
 /// Fast Free Fermion Compiler namespace
 namespace f3c {
@@ -17,6 +27,29 @@ namespace f3c {
     return ( T(0) < val ) - ( val < T(0) ) ;
   }
 
+  /// Prefetches the memory at `ptr` into the cache, if supported.
+  inline void prefetch( const void* ptr ) {
+  #if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch( ptr ) ;
+  #endif
+  }
+
+  /**
+   * \brief Returns the number of threads of an OpenMP parallel region that
+   *        requests `nbThreads` threads.
+   *
+   * A positive `nbThreads` is returned as is, otherwise the default number of
+   * threads of a parallel region started by the calling thread.
+   */
+  inline int threads( const int nbThreads ) {
+    if ( nbThreads > 0 ) return nbThreads ;
+  #ifdef _OPENMP
+    return omp_get_max_threads() ;
+  #else
+    return 1 ;
+  #endif
+  }
+
   /// Returns the Frobenius norm of a 2 x 2 matrix.
   template <typename R>
   inline R norm22( const std::complex< R >* A ) {
@@ -42,7 +75,7 @@ namespace f3c {
 
   /// Multiplies two 2 x 2 matrices.
   template <typename T>
-  inline void gemm22( const T* A , const T* B , T* C ) {
+  F3C_ALWAYS_INLINE void gemm22( const T* A , const T* B , T* C ) {
 
     C[0] = A[0]*B[0] + A[2]*B[1] ;
     C[1] = A[1]*B[0] + A[3]*B[1] ;
@@ -314,6 +347,90 @@ namespace f3c {
 
   }
 
+  /**
+   * \brief Computes a closed-form diagonalization for a 2 x 2 matrix pencil
+   *        of the form:
+   * \f[\begin{bmatrix} a   &  b\\ c & d \end{bmatrix} - \lambda \sigma
+   * \begin{bmatrix} \bar{d} & -\bar{c} \\ -\bar{b} & \bar{a} \end{bmatrix},
+   * \quad |\sigma| = 1.\f]
+   *
+   * For these pencils, \f$B = \sigma \operatorname{adj}(A)^H\f$, and any
+   * special unitary `Q` and `Z` that diagonalize `A` also diagonalize `B`.
+   * Hence, `Z` is computed as the Jacobi rotation that diagonalizes
+   * \f$A^H A\f$ and `Q` as the rotation that reduces the dominant column of
+   * \f$A Z\f$. If the result is not diagonal to working precision, e.g.,
+   * because the pencil does not have the above structure, the iterative
+   * diagonalize22 is used as fallback.
+   */
+  template <typename T>
+  void diagonalize22Direct( T* A , T* B , T* Q , T* Z ) {
+
+    using R = qclab::real_t< T > ;
+
+    // A^H * A = [ h11 h12 ; conj(h12) h22 ]
+    const R h11 = std::norm( A[0] ) + std::norm( A[1] ) ;
+    const R h22 = std::norm( A[2] ) + std::norm( A[3] ) ;
+    const T h12 = std::conj( A[0] ) * A[2] + std::conj( A[1] ) * A[3] ;
+    const R a12 = std::abs( h12 ) ;
+
+    // Z
+    const auto eps = std::numeric_limits< R >::epsilon() ;
+    const R gap = std::hypot( h11 - h22 , 2 * a12 ) ;
+    if ( gap <= 4 * eps * ( h11 + h22 ) ) {
+      // A^H * A = sigma^2 * I: Z = rotation that reduces A(2,:)
+      rotateToZeroR( A[3] , A[1] , Z ) ;
+    } else {
+      // Z = Jacobi rotation that diagonalizes A^H * A
+      R c = 1 ;
+      T s = 0 ;
+      R t = 0 ;
+      if ( a12 != 0 ) {
+        const R tau = ( h22 - h11 ) / ( 2 * a12 ) ;
+        t = ( tau >= 0 ? R(1) : R(-1) ) /
+            ( std::abs( tau ) + std::sqrt( 1 + tau * tau ) ) ;
+        c = 1 / std::sqrt( 1 + t * t ) ;
+        s = ( t * c / a12 ) * h12 ;
+      }
+      if ( h11 - t * a12 <= h22 + t * a12 ) {
+        // Z = [       c s ]
+        //     [ -conj(s) c ]
+        Z[0] = c ; Z[1] = -std::conj( s ) ; Z[2] = s ; Z[3] = c ;
+      } else {
+        // swap columns such that the largest singular value is last
+        Z[0] = -s ; Z[1] = -c ; Z[2] = c ; Z[3] = -std::conj( s ) ;
+      }
+    }
+
+    // Q = rotation such that Q * A * Z(:,2) = [ 0 ; r ], with r >= 0
+    std::array< T , 4 >  W_ ;  T* W = W_.data() ;
+    gemm22( A , Z , W ) ;
+    rotateToZeroL( W[3] , -W[2] , Q ) ;
+    Q[0] = std::conj( Q[0] ) ; Q[1] = std::conj( Q[1] ) ;
+    Q[2] = std::conj( Q[2] ) ; Q[3] = std::conj( Q[3] ) ;
+
+    // D = Q * A * Z, E = Q * B * Z
+    std::array< T , 4 >  D ;
+    std::array< T , 4 >  E ;
+    gemm22( Q , W , D.data() ) ;
+    gemm22( B , Z , W ) ;
+    gemm22( Q , W , E.data() ) ;
+
+    // check
+    const auto tolA = 12 * eps * norm22( A ) ;
+    const auto tolB = 12 * eps * norm22( B ) ;
+    if ( ( std::abs( D[1] ) + std::abs( D[2] ) > tolA ) ||
+         ( std::abs( E[1] ) + std::abs( E[2] ) > tolB ) ) {
+      diagonalize22( A , B , Q , Z ) ;
+      return ;
+    }
+
+    // A = diag(diag(Q*A*Z))
+    A[0] = D[0] ; A[1] = 0 ; A[2] = 0 ; A[3] = D[3] ;
+    // B = diag(diag(Q*B*Z))
+    B[0] = E[0] ; B[1] = 0 ; B[2] = 0 ; B[3] = E[3] ;
+
+  }
+
 } // namespace f3c
 
 #endif
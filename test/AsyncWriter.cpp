@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "f3c/io/AsyncWriter.hpp"
+#include "f3c/io/QASMBuffer.hpp"
+#include <atomic>
+#include <stdexcept>
+
+/*
+ * asynchronous writer
+ */
+TEST( f3c_io_AsyncWriter , synchronous ) {
+  f3c::io::AsyncWriter  writer( 0 ) ;
+  EXPECT_EQ( writer.nbThreads() , 0 ) ;
+  int count = 0 ;
+  for ( int i = 0; i < 10; i++ ) {
+    writer.push( [&count]{ count++ ; } ) ;
+    EXPECT_EQ( count , i+1 ) ;
+  }
+  writer.finish() ;
+}
+
+TEST( f3c_io_AsyncWriter , order ) {
+  // a single writer thread runs the tasks in order
+  std::vector< int > order ;
+  {
+    f3c::io::AsyncWriter  writer( 1 , 2 ) ;
+    EXPECT_EQ( writer.nbThreads() , 1 ) ;
+    for ( int i = 0; i < 100; i++ ) {
+      writer.push( [&order,i]{ order.push_back( i ) ; } ) ;
+    }
+    writer.finish() ;
+    EXPECT_EQ( writer.nbThreads() , 0 ) ;
+  }
+  ASSERT_EQ( order.size() , 100 ) ;
+  for ( int i = 0; i < 100; i++ ) EXPECT_EQ( order[i] , i ) ;
+}
+
+TEST( f3c_io_AsyncWriter , threads ) {
+  // tasks on writer threads render with a single thread
+  std::atomic< int > threads( 0 ) ;
+  {
+    f3c::io::AsyncWriter  writer( 2 ) ;
+    for ( int i = 0; i < 4; i++ ) {
+      writer.push( [&threads]{ threads += f3c::io::renderThreads() ; } ) ;
+    }
+  }
+  EXPECT_EQ( threads , 4 ) ;
+}
+
+TEST( f3c_io_AsyncWriter , backpressure ) {
+  // at most capacity tasks are queued while 1 task is running
+  std::atomic< int > pushed( 0 ) ;
+  std::atomic< int > done( 0 ) ;
+  std::atomic< int > maxQueued( 0 ) ;
+  {
+    f3c::io::AsyncWriter  writer( 1 , 3 ) ;
+    for ( int i = 0; i < 50; i++ ) {
+      writer.push( [&]{
+        const int queued = pushed - done - 1 ;
+        if ( queued > maxQueued ) maxQueued = queued ;
+        done++ ;
+      } ) ;
+      pushed++ ;
+    }
+  }
+  EXPECT_EQ( done , 50 ) ;
+  EXPECT_LE( maxQueued , 3 ) ;
+}
+
+TEST( f3c_io_AsyncWriter , exception ) {
+  std::atomic< int > count( 0 ) ;
+  f3c::io::AsyncWriter  writer( 2 ) ;
+  for ( int i = 0; i < 10; i++ ) {
+    writer.push( [&count,i]{
+      count++ ;
+      if ( i == 5 ) throw std::runtime_error( "write failed" ) ;
+    } ) ;
+  }
+  EXPECT_THROW( writer.finish() , std::runtime_error ) ;
+  EXPECT_EQ( count , 10 ) ;
+  EXPECT_NO_THROW( writer.finish() ) ;
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "f3c/io/QASMArchive.hpp"
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+/*
+ * QASM archive
+ */
+TEST( f3c_io_QASMArchive , records ) {
+
+  const std::string filename = "f3c_test_QASMArchive.f3ca" ;
+  const std::string qasm0 = "rx(0.5) q[0];\ncx q[0], q[1];\n" ;
+  const std::string qasm1 = "" ;
+
+  // write
+  {
+    f3c::io::QASMArchiveWriter  archive( filename ) ;
+    EXPECT_EQ( archive.nbRecords() , 0 ) ;
+    archive.append( 3 , 2 , "timestep 3: hz = 1\n" , qasm0 ) ;
+    archive.append( 1 , 5 , "" , qasm1 ) ;
+    // concurrent appends
+    std::vector< std::thread > threads ;
+    for ( int t = 0; t < 4; t++ ) {
+      threads.emplace_back( [&archive,t]{
+        for ( int k = 0; k < 25; k++ ) {
+          const std::string qasm( 100*t + k , 'a' + t ) ;
+          archive.append( 1000 + 100*t + k , t , "thread" , qasm ) ;
+        }
+      } ) ;
+    }
+    for ( auto& thread : threads ) thread.join() ;
+    EXPECT_EQ( archive.nbRecords() , 102 ) ;
+    archive.close() ;
+    archive.close() ;
+  }
+
+  // read
+  {
+    f3c::io::QASMArchiveReader  archive( filename ) ;
+    EXPECT_EQ( archive.nbRecords() , 102 ) ;
+
+    const auto record0 = archive.record( 0 ) ;
+    EXPECT_EQ( record0.timestep , 3 ) ;
+    EXPECT_EQ( record0.nbQubits , 2 ) ;
+    EXPECT_EQ( record0.comment , "timestep 3: hz = 1\n" ) ;
+    EXPECT_EQ( record0.qasm , qasm0 ) ;
+
+    const auto record1 = archive.record( 1 ) ;
+    EXPECT_EQ( record1.timestep , 1 ) ;
+    EXPECT_EQ( record1.nbQubits , 5 ) ;
+    EXPECT_EQ( record1.comment , "" ) ;
+    EXPECT_EQ( record1.qasm , "" ) ;
+
+    for ( int t = 0; t < 4; t++ ) {
+      for ( int k = 0; k < 25; k++ ) {
+        const size_t r = archive.find( 1000 + 100*t + k ) ;
+        ASSERT_LT( r , archive.nbRecords() ) ;
+        const auto record = archive.record( r ) ;
+        EXPECT_EQ( record.nbQubits , t ) ;
+        EXPECT_EQ( record.comment , "thread" ) ;
+        EXPECT_EQ( record.qasm , std::string( 100*t + k , 'a' + t ) ) ;
+      }
+    }
+    EXPECT_EQ( archive.find( 3 ) , 0 ) ;
+    EXPECT_EQ( archive.find( 2 ) , archive.nbRecords() ) ;
+    EXPECT_THROW( archive.record( 102 ) , std::out_of_range ) ;
+
+    // QASM file of a record
+    f3c::io::QASMBuffer buffer ;
+    archive.qasm( 0 , buffer ) ;
+    f3c::io::QASMBuffer check ;
+    f3c::io::qasmHeader( check , "timestep 3: hz = 1\n" , 2 ) ;
+    check.append( qasm0 ) ;
+    EXPECT_EQ( buffer.view() , check.view() ) ;
+  }
+
+  std::remove( filename.c_str() ) ;
+
+}
+
+TEST( f3c_io_QASMArchive , invalid ) {
+
+  const std::string filename = "f3c_test_QASMArchive_invalid.f3ca" ;
+
+  // missing archive
+  EXPECT_THROW( f3c::io::QASMArchiveReader{ "f3c_missing.f3ca" } ,
+                std::runtime_error ) ;
+
+  // not an archive
+  {
+    std::ofstream stream( filename ) ;
+    stream << "OPENQASM 2.0;\ninclude \"qelib1.inc\";\n\nqreg q[4];\n" ;
+  }
+  EXPECT_THROW( f3c::io::QASMArchiveReader{ filename } , std::runtime_error ) ;
+
+  // truncated archive without offset table
+  {
+    f3c::io::QASMArchiveWriter  archive( filename ) ;
+    archive.append( 1 , 2 , "" , "cx q[0], q[1];\n" ) ;
+    archive.close() ;
+    std::ifstream stream( filename , std::ios::binary ) ;
+    std::string bytes( ( std::istreambuf_iterator< char >( stream ) ) ,
+                       std::istreambuf_iterator< char >() ) ;
+    stream.close() ;
+    std::ofstream truncated( filename , std::ios::binary ) ;
+    truncated << bytes.substr( 0 , bytes.size() - 8 ) ;
+  }
+  EXPECT_THROW( f3c::io::QASMArchiveReader{ filename } , std::runtime_error ) ;
+
+  std::remove( filename.c_str() ) ;
+
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "f3c/io/QASMTemplate.hpp"
+#include "f3c/qgates/functors.hpp"
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <thread>
+
+/// Binds `angles` to the input parameters `t<k>` of the QASM gates `qasm`.
+std::string test_f3c_qasm_bind( const std::string_view qasm ,
+                                const std::vector< double >& angles ) {
+  f3c::io::QASMBuffer buffer ;
+  size_t i = 0 ;
+  while ( true ) {
+    const size_t i1 = qasm.find( "(t" , i ) ;
+    if ( i1 == std::string::npos ) break ;
+    const size_t i2 = qasm.find( ')' , i1 ) ;
+    const size_t k = std::stoul( std::string( qasm.substr( i1 + 2 ,
+                                                           i2 - i1 - 2 ) ) ) ;
+    buffer.append( qasm.substr( i , i1 + 1 - i ) ).append( angles.at( k ) ) ;
+    i = i2 ;
+  }
+  buffer.append( qasm.substr( i ) ) ;
+  return buffer.str() ;
+}
+
+
+template <template <typename> class F>
+void test_f3c_io_QASMTemplate( const int N ) {
+
+  using T = std::complex< double > ;
+  using G = typename F< T >::gate_type ;
+
+  std::mt19937 gen( 2021 + N ) ;
+  std::uniform_real_distribution< double > dis( -1 , 1 ) ;
+
+  // random circuit with an offset
+  qclab::QCircuit< T , G >  circuit( N , 1 ) ;
+  for ( int l = 0; l < 3; l++ ) {
+    for ( int i = 0; i < N-1; i++ ) {
+      circuit.push_back( F< T >::init( i , dis , gen ) ) ;
+    }
+  }
+  const size_t nbParameters = circuit.nbGates() * F< T >::nbAngles ;
+
+  // template and angles
+  f3c::io::QASMBuffer symbolic ;
+  f3c::io::qasmTemplate< F< T > >( circuit , symbolic ) ;
+  std::vector< double > angles( nbParameters ) ;
+  f3c::io::qasmAngles< F< T > >( circuit , angles.data() ) ;
+  EXPECT_NE( symbolic.view().find( "(t0)" ) , std::string::npos ) ;
+  EXPECT_NE( symbolic.view().find( "(t" + std::to_string( nbParameters - 1 ) +
+                                   ")" ) , std::string::npos ) ;
+
+  // binding the angles reproduces the QASM of the circuit
+  f3c::io::QASMBuffer buffer ;
+  F< T >::toQASM( circuit , buffer ) ;
+  EXPECT_TRUE( test_f3c_qasm_bind( symbolic.view() , angles ) ==
+               buffer.view() ) ;
+
+  // header
+  f3c::io::QASMBuffer header ;
+  f3c::io::qasmTemplateHeader( header , "square" , N , nbParameters ) ;
+  const std::string_view view = header.view() ;
+  EXPECT_NE( view.find( "// square\n" ) , std::string::npos ) ;
+  EXPECT_NE( view.find( "OPENQASM 3.0;\ninclude \"stdgates.inc\";\n" ) ,
+             std::string::npos ) ;
+  EXPECT_NE( view.find( "input angle t0;\n" ) , std::string::npos ) ;
+  EXPECT_NE( view.find( "input angle t" + std::to_string( nbParameters - 1 ) +
+                        ";\n\nqubit[" + std::to_string( N ) + "] q;\n" ) ,
+             std::string::npos ) ;
+
+}
+
+
+/*
+ * parameterized QASM templates
+ */
+TEST( f3c_io_QASMTemplate , gates ) {
+  for ( int N = 2; N <= 6; N += 2 ) {
+    test_f3c_io_QASMTemplate< f3c::qgates::XYfunctor >( N ) ;
+    test_f3c_io_QASMTemplate< f3c::qgates::XZfunctor >( N ) ;
+    test_f3c_io_QASMTemplate< f3c::qgates::YZfunctor >( N ) ;
+    test_f3c_io_QASMTemplate< f3c::qgates::TFXYfunctor >( N ) ;
+    test_f3c_io_QASMTemplate< f3c::qgates::TFXZfunctor >( N ) ;
+    test_f3c_io_QASMTemplate< f3c::qgates::TFYZfunctor >( N ) ;
+    test_f3c_io_QASMTemplate< f3c::qgates::TFXYU1functor >( N ) ;
+    test_f3c_io_QASMTemplate< f3c::qgates::TFIMfunctor >( 2*N ) ;
+  }
+}
+
+
+/*
+ * angle tables
+ */
+TEST( f3c_io_QASMTemplate , table ) {
+
+  const std::string filename = "f3c_test_QASMTemplate.angles" ;
+  const size_t nbParameters = 6 ;
+
+  // write
+  {
+    f3c::io::AngleTableWriter  table( filename , nbParameters ) ;
+    EXPECT_EQ( table.nbParameters() , nbParameters ) ;
+    EXPECT_EQ( table.nbRows() , 0 ) ;
+    // concurrent appends
+    std::vector< std::thread > threads ;
+    for ( int t = 0; t < 4; t++ ) {
+      threads.emplace_back( [&table,t]{
+        for ( int k = 0; k < 25; k++ ) {
+          std::vector< double > angles( table.nbParameters() , 100*t + k ) ;
+          angles[0] = -1 ;
+          table.append( 100*t + k , angles.data() ) ;
+        }
+      } ) ;
+    }
+    for ( auto& thread : threads ) thread.join() ;
+    EXPECT_EQ( table.nbRows() , 100 ) ;
+    table.close() ;
+    table.close() ;
+  }
+
+  // read
+  {
+    f3c::io::AngleTableReader  table( filename ) ;
+    EXPECT_EQ( table.nbParameters() , nbParameters ) ;
+    EXPECT_EQ( table.nbRows() , 100 ) ;
+    std::vector< int > found( 400 , 0 ) ;
+    for ( size_t r = 0; r < table.nbRows(); r++ ) {
+      const uint64_t timestep = table.timestep( r ) ;
+      ASSERT_LT( timestep , 400 ) ;
+      found[ timestep ]++ ;
+      const auto angles = table.angles( r ) ;
+      ASSERT_EQ( angles.size() , nbParameters ) ;
+      EXPECT_EQ( angles[0] , -1 ) ;
+      for ( size_t j = 1; j < nbParameters; j++ ) {
+        EXPECT_EQ( angles[j] , double( timestep ) ) ;
+      }
+    }
+    for ( int t = 0; t < 4; t++ ) {
+      for ( int k = 0; k < 25; k++ ) EXPECT_EQ( found[ 100*t + k ] , 1 ) ;
+    }
+    EXPECT_THROW( table.timestep( 100 ) , std::out_of_range ) ;
+    EXPECT_THROW( table.angles( 100 ) , std::out_of_range ) ;
+  }
+
+  // truncated row
+  {
+    std::ofstream stream( filename , std::ios::binary | std::ios::app ) ;
+    stream.write( "abc" , 3 ) ;
+  }
+  EXPECT_THROW( f3c::io::AngleTableReader{ filename } , std::runtime_error ) ;
+
+  // not an angle table
+  {
+    std::ofstream stream( filename , std::ios::binary | std::ios::trunc ) ;
+    stream << "OPENQASM 2.0;\ninclude \"qelib1.inc\";\n" ;
+  }
+  EXPECT_THROW( f3c::io::AngleTableReader{ filename } , std::runtime_error ) ;
+  EXPECT_THROW( f3c::io::AngleTableReader{ "f3c_test_missing.angles" } ,
+                std::runtime_error ) ;
+
+  std::remove( filename.c_str() ) ;
+
+}
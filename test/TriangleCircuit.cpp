@@ -3,6 +3,8 @@
 #include "f3c/SquareCircuit.hpp"
 #include "qclab/qgates/RotationXX.hpp"
 #include "f3c/qgates/RotationXY.hpp"
+#include "f3c/qgates/RotationTFXYMatrix.hpp"
+#include <random>
 
 template <typename T>
 auto test_f3c_TriangleCircuit_init( const int n ) {
@@ -638,6 +640,181 @@ void test_f3c_TriangleCircuit() {
     EXPECT_NEAR( qclab::nrmF( square , check ) , 0.0 , 1024*10*eps ) ;
   }
 
+
+  //
+  // mergeLayer
+  //
+  for ( int n = 2; n <= 7; n++ ) {
+    for ( const bool ascend : { true , false } ) {
+      for ( const auto side : { qclab::Side::Left , qclab::Side::Right } ) {
+        auto triangle = test_f3c_TriangleCircuit_initXY< T >( n ) ;
+        auto check    = test_f3c_TriangleCircuit_initXY< T >( n ) ;
+        if ( !ascend ) {
+          triangle.makeDescend() ;
+          check.makeDescend() ;
+        }
+        // 3 pipelined timesteps followed by overlapping gates
+        qclab::QCircuit< T , XY >  layer( n ) ;
+        for ( int t = 0; t < 3; t++ ) {
+          for ( int q = 0; q < n-1; q += 2 ) {
+            layer.push_back( std::make_unique< XY >( q , q+1 ,
+                                                     0.1*q + t , 0.3 ) ) ;
+          }
+          for ( int q = 1; q < n-1; q += 2 ) {
+            layer.push_back( std::make_unique< XY >( q , q+1 ,
+                                                     0.2 , -0.1*q + t ) ) ;
+          }
+        }
+        for ( int q = n-2; q >= 0; q-- ) {
+          layer.push_back( std::make_unique< XY >( q , q+1 , 0.5 , 0.1*q ) ) ;
+        }
+        qclab::QCircuit< T , XY >  layerCheck( n ) ;
+        for ( auto it = layer.begin(); it != layer.end(); ++it ) {
+          layerCheck.push_back( std::make_unique< XY >( **it ) ) ;
+        }
+        triangle.mergeLayer( side , layer.begin() , layer.end() ) ;
+        for ( auto it = layerCheck.begin(); it != layerCheck.end(); ++it ) {
+          check.merge( side , *it ) ;
+        }
+        EXPECT_EQ( triangle.ascend() , ascend ) ;
+        for ( size_t i = 0; i < triangle.nbGates(); i++ ) {
+          EXPECT_TRUE( *triangle[i] == *check[i] ) ;
+        }
+        // the layer is not modified
+        for ( size_t i = 0; i < layer.nbGates(); i++ ) {
+          EXPECT_TRUE( *layer[i] == *layerCheck[i] ) ;
+        }
+      }
+    }
+  }
+
+
+  //
+  // identity, merge triangle and power
+  //
+  for ( int n = 2; n <= 7; n++ ) {
+    const qclab::QCircuit< T , XY >  empty( n ) ;
+    auto identityA = f3c::TriangleCircuit< T , XY >::identity( n ) ;
+    EXPECT_TRUE( identityA.ascend() ) ;
+    EXPECT_EQ( qclab::nrmF( identityA , empty ) , 0.0 ) ;
+    auto identityD = f3c::TriangleCircuit< T , XY >::identity( n , false ) ;
+    EXPECT_TRUE( identityD.descend() ) ;
+    EXPECT_EQ( qclab::nrmF( identityD , empty ) , 0.0 ) ;
+
+    for ( const auto side : { qclab::Side::Left , qclab::Side::Right } ) {
+      auto triangleA = test_f3c_TriangleCircuit_initXY< T >( n ) ;
+      auto triangleB = test_f3c_TriangleCircuit_initXY< T >( n ) ;
+      triangleB.merge( qclab::Side::Left , XY( 0 , 1 , 0.7 , -0.2 ) ) ;
+      triangleB.makeDescend() ;
+      const auto& first  = ( side == qclab::Side::Right ) ? triangleA
+                                                          : triangleB ;
+      const auto& second = ( side == qclab::Side::Right ) ? triangleB
+                                                          : triangleA ;
+      qclab::QCircuit< T , XY >  check( n ) ;
+      for ( auto it = first.begin(); it != first.end(); ++it ) {
+        check.push_back( std::make_unique< XY >( **it ) ) ;
+      }
+      for ( auto it = second.begin(); it != second.end(); ++it ) {
+        check.push_back( std::make_unique< XY >( **it ) ) ;
+      }
+      triangleA.merge( side , triangleB ) ;
+      EXPECT_NEAR( qclab::nrmF( triangleA , check ) , 0.0 , 100*eps ) ;
+    }
+
+    // triangle of 1 timestep
+    auto timestep = f3c::TriangleCircuit< T , XY >::identity( n ) ;
+    qclab::QCircuit< T , XY >  layer( n ) ;
+    for ( int q = 0; q < n-1; q += 2 ) {
+      layer.push_back( std::make_unique< XY >( q , q+1 , 0.1 , 0.3 ) ) ;
+    }
+    for ( int q = 1; q < n-1; q += 2 ) {
+      layer.push_back( std::make_unique< XY >( q , q+1 , 0.2 , -0.4 ) ) ;
+    }
+    qclab::QCircuit< T , XY >  check( n ) ;
+    for ( auto it = layer.begin(); it != layer.end(); ++it ) {
+      check.push_back( std::make_unique< XY >( **it ) ) ;
+    }
+    timestep.mergeLayer( qclab::Side::Right , layer.begin() , layer.end() ) ;
+    EXPECT_NEAR( qclab::nrmF( timestep , check ) , 0.0 , 100*eps ) ;
+
+    EXPECT_EQ( qclab::nrmF( timestep.power( 0 ) , empty ) , 0.0 ) ;
+    EXPECT_NEAR( qclab::nrmF( timestep.power( 1 ) , check ) , 0.0 , 100*eps );
+    for ( int k = 1; k < 11; k++ ) {
+      for ( int j = 0; j < n-1; j++ ) {
+        check.push_back( std::make_unique< XY >( *check[j] ) ) ;
+      }
+    }
+    EXPECT_NEAR( qclab::nrmF( timestep.power( 11 ) , check ) , 0.0 , 1000*eps );
+  }
+
+
+  //
+  // snapshotSquare
+  //
+  for ( int n = 2; n <= 9; n++ ) {
+    for ( const bool ascend : { true , false } ) {
+      auto triangle = test_f3c_TriangleCircuit_initXY< T >( n ) ;
+      if ( !ascend ) triangle.makeDescend() ;
+      const f3c::TriangleCircuit< T , XY >  copy( triangle ) ;
+      f3c::SquareCircuit< T , XY >  snapshot( n ) ;
+      for ( int r = 0; r < 2; r++ ) {
+        triangle.merge( qclab::Side::Right , XY( n/2-1 , n/2 , 0.3 , r ) ) ;
+        triangle.snapshotSquare( snapshot ) ;
+        // triangle is unchanged
+        EXPECT_EQ( triangle.ascend() , ascend ) ;
+        f3c::TriangleCircuit< T , XY >  tmptriangle( triangle ) ;
+        auto square = tmptriangle.toSquare() ;
+        ASSERT_EQ( snapshot.nbGates() , square.nbGates() ) ;
+        for ( size_t i = 0; i < square.nbGates(); i++ ) {
+          EXPECT_TRUE( *snapshot[i] == *square[i] ) ;
+        }
+      }
+      EXPECT_NEAR( qclab::nrmF( triangle , snapshot ) , 0.0 , 1000*eps ) ;
+      EXPECT_GT( qclab::nrmF( copy , snapshot ) , 0.0 ) ;
+    }
+  }
+
+}
+
+
+template <typename T>
+void test_f3c_TriangleCircuit_mergeLayerTFXY() {
+
+  using R = qclab::real_t< T > ;
+  using TFXY = f3c::qgates::RotationTFXYMatrix< T > ;
+
+  const R eps = std::numeric_limits< R >::epsilon() ;
+
+  std::mt19937 gen( 2021 ) ;
+  std::uniform_real_distribution< R > dis( -1 , 1 ) ;
+  auto random = [&]( const int q ) {
+    return std::make_unique< TFXY >( q , q+1 , dis( gen ) , dis( gen ) ,
+                                     dis( gen ) , dis( gen ) , dis( gen ) ,
+                                     dis( gen ) ) ;
+  } ;
+
+  // batched turnovers of mergeLayer agree with merge
+  for ( int n = 3; n <= 12; n += 3 ) {
+    for ( const auto side : { qclab::Side::Left , qclab::Side::Right } ) {
+      f3c::TriangleCircuit< T , TFXY >  triangle( n ) ;
+      int c = 0 ;
+      for ( int l = 0; l < n-1; l++ ) {
+        for ( int i = 0; i < n-l-1; i++ ) triangle[c++] = random( n-i-2 ) ;
+      }
+      f3c::TriangleCircuit< T , TFXY >  check( triangle ) ;
+      qclab::QCircuit< T , TFXY >  layer( n ) ;
+      for ( int t = 0; t < 2; t++ ) {
+        for ( int q = 0; q < n-1; q += 2 ) layer.push_back( random( q ) ) ;
+        for ( int q = 1; q < n-1; q += 2 ) layer.push_back( random( q ) ) ;
+      }
+      for ( auto it = layer.begin(); it != layer.end(); ++it ) {
+        check.merge( side , **it ) ;
+      }
+      triangle.mergeLayer( side , layer.begin() , layer.end() ) ;
+      EXPECT_NEAR( qclab::nrmF( triangle , check ) , 0.0 , 10*n*n*eps ) ;
+    }
+  }
+
 }
 
 
@@ -646,6 +823,7 @@ void test_f3c_TriangleCircuit() {
  */
 TEST( f3c_TriangleCircuit , complex_float ) {
   test_f3c_TriangleCircuit< std::complex< float > >() ;
+  test_f3c_TriangleCircuit_mergeLayerTFXY< std::complex< float > >() ;
 }
 
 /*
@@ -653,5 +831,6 @@ TEST( f3c_TriangleCircuit , complex_float ) {
  */
 TEST( f3c_TriangleCircuit , complex_double ) {
   test_f3c_TriangleCircuit< std::complex< double > >() ;
+  test_f3c_TriangleCircuit_mergeLayerTFXY< std::complex< double > >() ;
 }
 
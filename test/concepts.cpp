@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "f3c/concepts.hpp"
 #include "f3c/qgates/RotationTFXYMatrix.hpp"
+#include "f3c/qgates/RotationTFXYU1Matrix.hpp"
+#include "f3c/qgates/RotationTFIM.hpp"
 
 template <typename T>
 void test_f3c_concepts_is_one_axis() {
@@ -200,6 +202,63 @@ void test_f3c_concepts_is_TF_two_axes() {
 }
 
 
+template <typename T>
+void test_f3c_concepts_qubitPair() {
+
+  using XX = qclab::qgates::RotationXX< T > ;
+  using XY = f3c::qgates::RotationXY< T > ;
+  using TFXY = f3c::qgates::RotationTFXY< T > ;
+  using TFXYM = f3c::qgates::RotationTFXYMatrix< T > ;
+
+  EXPECT_FALSE( f3c::has_qubitPair_v< XX > ) ;
+  EXPECT_TRUE( f3c::has_qubitPair_v< XY > ) ;
+  EXPECT_TRUE( f3c::has_qubitPair_v< TFXY > ) ;
+  EXPECT_TRUE( f3c::has_qubitPair_v< TFXYM > ) ;
+
+  const std::array< int , 2 >  qubits = { 2 , 3 } ;
+  EXPECT_EQ( f3c::qubitPair( XX( 2 , 3 , 0.1 ) ) , qubits ) ;
+  EXPECT_EQ( f3c::qubitPair( XY( 3 , 2 , 0.1 , 0.2 ) ) , qubits ) ;
+  EXPECT_EQ( f3c::qubitPair( TFXYM( 2 , 3 , 1 , 1 , 0 , 0 ) ) , qubits ) ;
+
+}
+
+
+template <typename T>
+void test_f3c_concepts_isIdentity() {
+
+  using X = qclab::qgates::RotationX< T > ;
+  using XY = f3c::qgates::RotationXY< T > ;
+  using TFXY = f3c::qgates::RotationTFXY< T > ;
+  using TFXYM = f3c::qgates::RotationTFXYMatrix< T > ;
+  using TFXYU1 = f3c::qgates::RotationTFXYU1Matrix< T > ;
+  using TFIM = f3c::qgates::RotationTFIM< T > ;
+
+  EXPECT_TRUE( f3c::is_TFXY_matrix_v< TFXYM > ) ;
+  EXPECT_FALSE( f3c::is_TFXY_matrix_v< TFXY > ) ;
+  EXPECT_FALSE( f3c::is_TFXY_matrix_v< TFXYU1 > ) ;
+  EXPECT_TRUE( f3c::is_TFXY_U1_matrix_v< TFXYU1 > ) ;
+  EXPECT_FALSE( f3c::is_TFXY_U1_matrix_v< TFXYM > ) ;
+  EXPECT_TRUE( f3c::is_TFIM_v< TFIM > ) ;
+  EXPECT_FALSE( f3c::is_TFIM_v< TFXYU1 > ) ;
+  EXPECT_FALSE( f3c::is_TFIM_v< XY > ) ;
+  EXPECT_FALSE( f3c::is_one_axis_v< TFIM > ) ;
+  EXPECT_TRUE( f3c::has_qubitPair_v< TFIM > ) ;
+
+  EXPECT_TRUE( f3c::isIdentity( X( 0 , 0.0 ) ) ) ;
+  EXPECT_FALSE( f3c::isIdentity( X( 0 , 0.1 ) ) ) ;
+  EXPECT_TRUE( f3c::isIdentity( XY( 0 , 1 , 0.0 , 0.0 ) ) ) ;
+  EXPECT_FALSE( f3c::isIdentity( XY( 0 , 1 , 0.0 , 0.1 ) ) ) ;
+  EXPECT_TRUE( f3c::isIdentity( TFXYM( 0 , 1 , 1 , 1 , 0 , 0 ) ) ) ;
+  EXPECT_FALSE( f3c::isIdentity( TFXYM( 0 , 1 , 1 , -1 , 0 , 0 ) ) ) ;
+  EXPECT_TRUE( f3c::isIdentity( TFXYU1( 0 , 1 , 1 , 1 , 0 ) ) ) ;
+  EXPECT_FALSE( f3c::isIdentity( TFXYU1( 0 , 1 , -1 , 1 , 0 ) ) ) ;
+  EXPECT_TRUE( f3c::isIdentity( TFIM( 1 , 2 , 0.0 ) ) ) ;
+  EXPECT_FALSE( f3c::isIdentity( TFIM( 1 , 2 , 0.1 ) ) ) ;
+  EXPECT_FALSE( f3c::isIdentity( TFXY() ) ) ;
+
+}
+
+
 template <typename R>
 void test_f3c_concepts() {
 
@@ -207,6 +266,8 @@ void test_f3c_concepts() {
   test_f3c_concepts_is_same_axis< R >() ;
   test_f3c_concepts_is_two_axes< R >() ;
   test_f3c_concepts_is_TF_two_axes< R >() ;
+  test_f3c_concepts_qubitPair< R >() ;
+  test_f3c_concepts_isIdentity< R >() ;
 
 }
 
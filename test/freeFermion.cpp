@@ -0,0 +1,266 @@
+#include <gtest/gtest.h>
+#include "f3c/freeFermion.hpp"
+#include "f3c/SquareCircuit.hpp"
+#include "f3c/qgates/RotationXY.hpp"
+#include "f3c/qgates/RotationTFXYMatrix.hpp"
+#include "f3c/qgates/functors.hpp"
+#include <random>
+
+template <typename C1, typename C2>
+auto nrmF_sign( const C1& circuit1 , const C2& circuit2 ) {
+  // Frobenius norm of the difference up to a global sign
+  using R = qclab::real_t< typename C1::value_type > ;
+  const auto M1 = circuit1.matrix() ;
+  const auto M2 = circuit2.matrix() ;
+  R plus = 0 ;
+  R minus = 0 ;
+  for ( int i = 0; i < M1.rows(); i++ ) {
+    for ( int j = 0; j < M1.cols(); j++ ) {
+      plus  += std::norm( M1(i,j) - M2(i,j) ) ;
+      minus += std::norm( M1(i,j) + M2(i,j) ) ;
+    }
+  }
+  return std::sqrt( std::min( plus , minus ) ) ;
+}
+
+
+template <typename T>
+void test_f3c_freeFermion_majorana() {
+
+  using R = qclab::real_t< T > ;
+  using TFXY = f3c::qgates::RotationTFXYMatrix< T > ;
+  using XY = f3c::qgates::RotationXY< T > ;
+
+  const R eps = std::numeric_limits< R >::epsilon() ;
+  const R theta = 0.3 ;
+  const R c = std::cos( theta ) ;
+  const R s = std::sin( theta ) ;
+
+  auto check = [&]( const std::array< R , 16 >& O ,
+                    const std::array< R , 16 >& ref ) {
+    for ( int i = 0; i < 16; i++ ) EXPECT_NEAR( O[i] , ref[i] , 10*eps ) ;
+  } ;
+
+  // Z rotation on qubit 0: Givens rotation on (0,1)
+  {
+    const T a( std::cos( theta/2 ) , -std::sin( theta/2 ) ) ;
+    check( f3c::freeFermion::majorana( TFXY( 0 , 1 , a , a , 0 , 0 ) ) ,
+           { c , s , 0 , 0 , -s , c , 0 , 0 , 0 , 0 , 1 , 0 , 0 , 0 , 0 , 1 } );
+  }
+
+  // XX rotation: Givens rotation on (1,2)
+  check( f3c::freeFermion::majorana( XY( 0 , 1 , theta , 0 ) ) ,
+         { 1 , 0 , 0 , 0 , 0 , c , s , 0 , 0 , -s , c , 0 , 0 , 0 , 0 , 1 } ) ;
+
+  // YY rotation: Givens rotation on (0,3) with negative angle
+  check( f3c::freeFermion::majorana( XY( 0 , 1 , 0 , theta ) ) ,
+         { c , 0 , 0 , -s , 0 , 1 , 0 , 0 , 0 , 0 , 1 , 0 , s , 0 , 0 , c } ) ;
+
+}
+
+
+template <typename F>
+void test_f3c_freeFermion_compile( const int N ) {
+
+  using G = typename F::gate_type ;
+  using T = typename F::value_type ;
+  using R = qclab::real_t< T > ;
+
+  const R eps = std::numeric_limits< R >::epsilon() ;
+
+  std::mt19937 gen( 2021 + N ) ;
+  std::uniform_real_distribution< R > dis( -1 , 1 ) ;
+
+  // random circuit
+  qclab::QCircuit< T , G >  circuit( N ) ;
+  for ( int k = 0; k < 3*N; k++ ) {
+    circuit.push_back( F::init( ( 2*k ) % ( N-1 ) , dis , gen ) ) ;
+  }
+
+  // single-particle matrix is orthogonal
+  const int n = 2*N ;
+  const auto O = f3c::freeFermion::majoranaCircuit( circuit ) ;
+  for ( int i = 0; i < n; i++ ) {
+    for ( int j = 0; j < n; j++ ) {
+      R dot = 0 ;
+      for ( int k = 0; k < n; k++ ) dot += O[k + n*i] * O[k + n*j] ;
+      EXPECT_NEAR( dot , ( i == j ) ? 1 : 0 , 100*eps ) ;
+    }
+  }
+
+  // compile
+  const auto triangle = f3c::freeFermion::compile< T , G >( N , O ) ;
+  EXPECT_EQ( triangle.nbGates() , N*(N-1)/2 ) ;
+  const auto O2 = f3c::freeFermion::majoranaCircuit( triangle ) ;
+  for ( int i = 0; i < n*n; i++ ) EXPECT_NEAR( O[i] , O2[i] , 1000*eps ) ;
+  EXPECT_NEAR( nrmF_sign( circuit , triangle ) , 0.0 , 1000*eps ) ;
+
+}
+
+
+template <typename T>
+void test_f3c_freeFermion_generator() {
+
+  using R = qclab::real_t< T > ;
+  using TFXY = f3c::qgates::RotationTFXYMatrix< T > ;
+  using XY = f3c::qgates::RotationXY< T > ;
+
+  const R eps = std::numeric_limits< R >::epsilon() ;
+  const R t = 0.4 ;
+  const R h = 0.7 ;
+  const R J0 = 1.3 ;
+  const R J1 = -0.6 ;
+
+  auto propagator = [&]( const R h , const R J0 , const R J1 ) {
+    auto H = f3c::freeFermion::generator< R >( 2 , h , J0 , J1 ) ;
+    for ( auto& x : H ) x *= t ;
+    return f3c::freeFermion::expm( 4 , H ) ;
+  } ;
+  auto check = [&]( const std::array< R , 16 >& O ,
+                    const std::vector< R >& ref ) {
+    for ( int i = 0; i < 16; i++ ) EXPECT_NEAR( O[i] , ref[i] , 100*eps ) ;
+  } ;
+
+  // exp( -i t h ( Z I + I Z ) )
+  const T a( std::cos( 2*h*t ) , -std::sin( 2*h*t ) ) ;
+  check( f3c::freeFermion::majorana( TFXY( 0 , 1 , a , 1 , 0 , 0 ) ) ,
+         propagator( h , 0 , 0 ) ) ;
+
+  // exp( -i t ( J0 XX + J1 YY ) )
+  check( f3c::freeFermion::majorana( XY( 0 , 1 , 2*J0*t , 2*J1*t ) ) ,
+         propagator( 0 , J0 , J1 ) ) ;
+
+}
+
+
+template <typename F>
+void test_f3c_freeFermion_nrmF( const int N ) {
+
+  using G = typename F::gate_type ;
+  using T = typename F::value_type ;
+  using R = qclab::real_t< T > ;
+
+  const R eps = std::numeric_limits< R >::epsilon() ;
+
+  std::mt19937 gen( 2021 + N ) ;
+  std::uniform_real_distribution< R > dis( -1 , 1 ) ;
+
+  // random triangle and control circuit
+  f3c::TriangleCircuit< T , G >  triangle( N ) ;
+  int c = 0 ;
+  for ( int l = 0; l < N-1; l++ ) {
+    for ( int i = 0; i < N-l-1; i++ ) {
+      triangle[c] = F::init( N-i-2 , dis , gen ) ;
+      c++ ;
+    }
+  }
+  qclab::QCircuit< T , G >  circuit( N ) ;
+  for ( auto it = triangle.begin(); it != triangle.end(); ++it ) {
+    circuit.push_back( std::make_unique< G >( **it ) ) ;
+  }
+
+  // single-particle matrices are orthogonal
+  const int n = f3c::freeFermion::nbModes( circuit ) ;
+  const auto O = f3c::freeFermion::majoranaCircuit( circuit ) ;
+  for ( int i = 0; i < n; i++ ) {
+    for ( int j = 0; j < n; j++ ) {
+      R dot = 0 ;
+      for ( int k = 0; k < n; k++ ) dot += O[k + n*i] * O[k + n*j] ;
+      EXPECT_NEAR( dot , ( i == j ) ? 1 : 0 , 100*eps ) ;
+    }
+  }
+
+  // merge gates
+  for ( int k = 0; k < 2*N; k++ ) {
+    const auto gate = F::init( ( 3*k ) % ( N-1 ) , dis , gen ) ;
+    circuit.push_back( std::make_unique< G >( *gate ) ) ;
+    triangle.merge( qclab::Side::Right , *gate ) ;
+  }
+  EXPECT_NEAR( f3c::freeFermion::nrmF( triangle , circuit ) , 0.0 ,
+               1000*eps ) ;
+  f3c::TriangleCircuit< T , G >  tmptriangle( triangle ) ;
+  EXPECT_NEAR( f3c::freeFermion::nrmF( tmptriangle.toSquare() , circuit ) ,
+               0.0 , 1000*eps ) ;
+
+  // different circuit
+  circuit.push_back( F::init( 0 , dis , gen ) ) ;
+  EXPECT_GT( f3c::freeFermion::nrmF( triangle , circuit ) , 1e-3 ) ;
+
+}
+
+
+template <typename T>
+void test_f3c_freeFermion_TFIM( const int N ) {
+
+  using R = qclab::real_t< T > ;
+  using F = f3c::qgates::TFXYfunctor< T > ;
+  using FIM = f3c::qgates::TFIMfunctor< T > ;
+  using G = typename FIM::gate_type ;
+
+  const R eps = std::numeric_limits< R >::epsilon() ;
+  const R dt = 0.1 ;
+  const R hz = 0.7 ;
+  const R Jx = -1.3 ;
+
+  // timestep on the 2N modes equals the TFXY timestep on the N qubits
+  qclab::QCircuit< T , typename F::gate_type >  circuit( N , 0 , N-1 ) ;
+  F::template timestep< R >( dt , 0 , 0 , hz , Jx , 0 , 0 , circuit ) ;
+  qclab::QCircuit< T , G >  modes( 2*N , 0 , 2*N-1 ) ;
+  FIM::template timestep< R >( dt , 0 , 0 , hz , Jx , 0 , 0 , modes ) ;
+  EXPECT_EQ( f3c::freeFermion::nbModes( modes ) , 2*N ) ;
+  EXPECT_NEAR( f3c::freeFermion::nrmF( modes , circuit ) , 0.0 , 100*eps ) ;
+
+  // compile the exact propagator into N(2N-1) TFIM-rotation gates
+  const int n = 2*N ;
+  auto H = f3c::freeFermion::generator< R >( N , hz , Jx , 0 ) ;
+  for ( auto& h : H ) h *= 5*dt ;
+  const auto O = f3c::freeFermion::expm( n , H ) ;
+  const auto triangle = f3c::freeFermion::compile< T , G >( N , O ) ;
+  EXPECT_EQ( triangle.nbQubits() , n ) ;
+  EXPECT_EQ( triangle.nbGates() , N*(2*N-1) ) ;
+  const auto O2 = f3c::freeFermion::majoranaCircuit( triangle ) ;
+  for ( int i = 0; i < n*n; i++ ) EXPECT_NEAR( O[i] , O2[i] , 1000*eps ) ;
+
+}
+
+
+template <typename T>
+void test_f3c_freeFermion() {
+
+  test_f3c_freeFermion_majorana< T >() ;
+  test_f3c_freeFermion_generator< T >() ;
+
+  for ( int N = 2; N <= 6; N++ ) {
+    test_f3c_freeFermion_compile< f3c::qgates::XYfunctor< T > >( N ) ;
+    test_f3c_freeFermion_compile< f3c::qgates::TFXYfunctor< T > >( N ) ;
+    test_f3c_freeFermion_compile< f3c::qgates::TFXYU1functor< T > >( N ) ;
+    test_f3c_freeFermion_TFIM< T >( N ) ;
+  }
+
+  for ( int N = 3; N <= 6; N++ ) {
+    test_f3c_freeFermion_nrmF< f3c::qgates::XYfunctor< T > >( N ) ;
+    test_f3c_freeFermion_nrmF< f3c::qgates::XZfunctor< T > >( N ) ;
+    test_f3c_freeFermion_nrmF< f3c::qgates::YZfunctor< T > >( N ) ;
+    test_f3c_freeFermion_nrmF< f3c::qgates::TFXYfunctor< T > >( N ) ;
+    test_f3c_freeFermion_nrmF< f3c::qgates::TFXYU1functor< T > >( N ) ;
+    test_f3c_freeFermion_nrmF< f3c::qgates::TFXZfunctor< T > >( N ) ;
+    test_f3c_freeFermion_nrmF< f3c::qgates::TFYZfunctor< T > >( N ) ;
+    test_f3c_freeFermion_nrmF< f3c::qgates::TFIMfunctor< T > >( 2*N ) ;
+  }
+
+}
+
+
+/*
+ * float
+ */
+TEST( f3c_freeFermion , float ) {
+  test_f3c_freeFermion< std::complex< float > >() ;
+}
+
+/*
+ * double
+ */
+TEST( f3c_freeFermion , double ) {
+  test_f3c_freeFermion< std::complex< double > >() ;
+}
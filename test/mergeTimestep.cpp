@@ -149,14 +149,10 @@ int timings( const std::vector< int >& N , const int outer , const int inner ,
 
         // merge timestep
         tic( "  * Merge timestep..." , t_bgn ) ;
-        #pragma omp parallel for
-        for ( size_t i = 0; i < layer1.nbGates(); i++ ) {
-          triangle.merge( qclab::Side::Right , layer1[i] ) ;
-        }
-        #pragma omp parallel for
-        for ( size_t i = 0; i < layer2.nbGates(); i++ ) {
-          triangle.merge( qclab::Side::Right , layer2[i] ) ;
-        }
+        triangle.mergeLayer( qclab::Side::Right , layer1.begin() ,
+                                                  layer1.end() ) ;
+        triangle.mergeLayer( qclab::Side::Right , layer2.begin() ,
+                                                  layer2.end() ) ;
         const double ttot = toc( t_bgn , t_end ) ;
         if ( i == 0 ) time.push_back( ttot ) ;
         else if ( ttot < time.back() ) time.back() = ttot ;
@@ -194,22 +190,16 @@ int timings( const std::vector< int >& N , const int outer , const int inner ,
           layers2.push_back( qclab::QCircuit< T , G >( n , 0 , (n-1)/2 ) ) ;
           timestep< F >( layers1[i] , layers2[i] ) ;
         }
-        const size_t nb1 = layers1[0].nbGates() ;
-        const size_t nb2 = layers2[0].nbGates() ;
         toc( t_bgn , t_end ) ;
 
         // merge timesteps
         tic( "  * Merge timesteps..." , t_bgn ) ;
         for ( int i = 0; i < inner; i++ ) {
           // inner loop
-          #pragma omp parallel for
-          for ( size_t j = 0; j < nb1; j++ ) {
-            triangle.merge( qclab::Side::Right , layers1[i][j] ) ;
-          }
-          #pragma omp parallel for
-          for ( size_t j = 0; j < nb2; j++ ) {
-            triangle.merge( qclab::Side::Right , layers2[i][j] ) ;
-          }
+          triangle.mergeLayer( qclab::Side::Right , layers1[i].begin() ,
+                                                    layers1[i].end() ) ;
+          triangle.mergeLayer( qclab::Side::Right , layers2[i].begin() ,
+                                                    layers2[i].end() ) ;
         }
         const double ttot = toc( t_bgn , t_end ) / inner ;
         if ( o == 0 ) time.push_back( ttot ) ;
@@ -1,6 +1,7 @@
 #include "qclab/QCircuit.hpp"
 #include "f3c/SquareCircuit.hpp"
 #include "f3c/TriangleCircuit.hpp"
+#include "f3c/freeFermion.hpp"
 #include "f3c/qgates/functors.hpp"
 #include <random>
 #include <cstring>
@@ -114,21 +115,15 @@ int timings( const int N , std::vector< int >& n , const int repeat ) {
       }
 
       // merge timestep
-      #pragma omp parallel for
-      for ( size_t j = 0; j < layer1.nbGates(); j++ ) {
-        triangle.merge( qclab::Side::Right , layer1[j] ) ;
-      }
-      #pragma omp parallel for
-      for ( size_t j = 0; j < layer2.nbGates(); j++ ) {
-        triangle.merge( qclab::Side::Right , layer2[j] ) ;
-      }
+      triangle.mergeLayer( qclab::Side::Right , layer1.begin() , layer1.end() );
+      triangle.mergeLayer( qclab::Side::Right , layer2.begin() , layer2.end() );
 
       // Frobenius norm
       if ( n[c] == i+1 ) {
         std::cout << "timestep = " << i+1 << ":" << std::endl ;
         f3c::TriangleCircuit< T , G >  tmptriangle( triangle ) ;
         auto square = tmptriangle.toSquare() ;
-        const double nrmF = qclab::nrmF( square , circuit ) ;
+        const double nrmF = f3c::freeFermion::nrmF( square , circuit ) ;
         if ( nrmF > nrms[c] ) nrms[c] = nrmF ;
         std::printf( "  * nrmF = %.4e  ( square: %3i , circuit: %5i )\n" ,
                      nrmF , int(square.nbGates()) , int(circuit.nbGates()) ) ;
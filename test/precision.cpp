@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "f3c/precision.hpp"
+#include "f3c/freeFermion.hpp"
+#include "f3c/qgates/functors.hpp"
+#include <random>
+
+template <typename G>
+void test_f3c_precision_normalize( const G& gate ) {
+
+  using R = qclab::real_t< typename G::value_type > ;
+  const R eps = std::numeric_limits< R >::epsilon() ;
+
+  // unitary gate
+  G gate1( gate ) ;
+  EXPECT_LT( f3c::normalize( gate1 ) , 10*eps ) ;
+
+  // perturbed gate
+  G gate2( gate ) ;
+  if constexpr ( f3c::is_TFXY_matrix_v< G > ) {
+    gate2.update( R(1.001) * gate.a() , gate.b() , gate.c() ,
+                  R(1.001) * gate.d() ) ;
+  } else if constexpr ( f3c::is_TFXY_U1_matrix_v< G > ) {
+    gate2.update( R(1.001) * gate.a() , gate.b() , gate.c() ) ;
+  } else {
+    // quantum rotations are unitary by construction
+    return ;
+  }
+  EXPECT_GT( f3c::normalize( gate2 ) , 1e-4 ) ;
+  EXPECT_LT( f3c::normalize( gate2 ) , 10*eps ) ;
+  EXPECT_NEAR( qclab::nrmF( gate1 , gate2 ) , 0.0 , 1e-2 ) ;
+
+}
+
+
+template <template <typename> class F>
+void test_f3c_precision_mixed( const int N ) {
+
+  using T = std::complex< double > ;
+  using T32 = std::complex< float > ;
+  using G = typename F< T >::gate_type ;
+  using G32 = typename F< T32 >::gate_type ;
+
+  std::mt19937 gen( 2021 + N ) ;
+  std::uniform_real_distribution< double > dis( -1 , 1 ) ;
+
+  // gates and conversions
+  const auto gate = F< T >::init( 0 , dis , gen ) ;
+  test_f3c_precision_normalize( *gate ) ;
+  test_f3c_precision_normalize( f3c::convert< G32 >( *gate ) ) ;
+  const auto gate32 = f3c::convert< G32 >( *gate ) ;
+  EXPECT_NEAR( qclab::nrmF( *gate , f3c::convert< G >( gate32 ) ) , 0.0 ,
+               1e-6 ) ;
+  EXPECT_TRUE( f3c::convert< G >( *gate ) == *gate ) ;
+
+  // random triangle in double and single precision
+  f3c::TriangleCircuit< T , G >  triangle( N ) ;
+  int c = 0 ;
+  for ( int l = 0; l < N-1; l++ ) {
+    for ( int i = 0; i < N-l-1; i++ ) {
+      triangle[c] = F< T >::init( N-i-2 , dis , gen ) ;
+      c++ ;
+    }
+  }
+  auto triangle32 = f3c::convert< T32 , G32 >( triangle ) ;
+  EXPECT_EQ( triangle32.nbGates() , triangle.nbGates() ) ;
+  EXPECT_LT( f3c::freeFermion::nrmF( triangle ,
+                                     f3c::convert< T , G >( triangle32 ) ) ,
+             1e-5 ) ;
+
+  // merge the same gates in both precisions, re-unitarize every 10 gates
+  double defect = 0 ;
+  for ( int k = 0; k < 100; k++ ) {
+    const auto gate = F< T >::init( ( 3*k ) % ( N-1 ) , dis , gen ) ;
+    triangle.merge( qclab::Side::Right , *gate ) ;
+    triangle32.merge( qclab::Side::Right , f3c::convert< G32 >( *gate ) ) ;
+    if ( k % 10 == 9 ) {
+      defect = std::max( defect , double( f3c::normalize( triangle32 ) ) ) ;
+    }
+  }
+  EXPECT_LT( f3c::normalize( triangle ) , 1e-12 ) ;
+  EXPECT_LT( defect , 1e-4 ) ;
+
+  // error in double precision
+  auto escalated = f3c::convert< T , G >( triangle32 ) ;
+  EXPECT_LT( f3c::normalize( escalated ) , 1e-6 ) ;
+  const auto error = f3c::freeFermion::nrmF( triangle , escalated ) ;
+  EXPECT_LT( error , 1e-2 ) ;
+
+  // escalation to double precision keeps the error
+  for ( int k = 0; k < 100; k++ ) {
+    const auto gate = F< T >::init( ( 3*k ) % ( N-1 ) , dis , gen ) ;
+    triangle.merge( qclab::Side::Right , *gate ) ;
+    escalated.merge( qclab::Side::Right , *gate ) ;
+  }
+  EXPECT_NEAR( f3c::freeFermion::nrmF( triangle , escalated ) , error ,
+               1e-10 ) ;
+
+}
+
+
+/*
+ * mixed precision
+ */
+TEST( f3c_precision , mixed ) {
+  for ( int N = 3; N <= 6; N++ ) {
+    test_f3c_precision_mixed< f3c::qgates::XYfunctor >( N ) ;
+    test_f3c_precision_mixed< f3c::qgates::TFXYfunctor >( N ) ;
+    test_f3c_precision_mixed< f3c::qgates::TFXYU1functor >( N ) ;
+  }
+  for ( int N = 6; N <= 12; N += 2 ) {
+    test_f3c_precision_mixed< f3c::qgates::TFIMfunctor >( N ) ;
+  }
+}
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include "f3c/qasm.hpp"
+#include "f3c/io/QASMBuffer.hpp"
+#include "f3c/qgates/functors.hpp"
+#include <random>
+#include <sstream>
+
+/// Checks that the QASM of `buffer` equals `check` up to rounding of angles.
+template <typename R = double>
+void test_f3c_qasm_equal( const f3c::io::QASMBuffer& buffer ,
+                          const std::string& check ) {
+  const std::string qasm = buffer.str() ;
+  size_t i = 0 ;
+  size_t j = 0 ;
+  while ( i < qasm.size() && j < check.size() ) {
+    const size_t i1 = qasm.find( '(' , i ) ;
+    const size_t j1 = check.find( '(' , j ) ;
+    EXPECT_EQ( qasm.substr( i , i1 - i ) , check.substr( j , j1 - j ) ) ;
+    if ( i1 == std::string::npos || j1 == std::string::npos ) {
+      EXPECT_EQ( i1 , j1 ) ;
+      return ;
+    }
+    i = qasm.find( ')' , i1 ) ;
+    j = check.find( ')' , j1 ) ;
+    const R angle = std::stod( qasm.substr( i1 + 1 , i - i1 - 1 ) ) ;
+    const R angle_check = std::stod( check.substr( j1 + 1 , j - j1 - 1 ) ) ;
+    EXPECT_NEAR( angle , angle_check ,
+                 10 * std::numeric_limits< R >::epsilon() ) ;
+  }
+}
+
+
+template <typename R>
+void test_f3c_qasm_buffer() {
+
+  // numbers
+  {
+    f3c::io::QASMBuffer buffer( 1 ) ;
+    EXPECT_EQ( buffer.size() , 0 ) ;
+    buffer.append( "q[" ).append( 12 ).append( "]" ) ;
+    EXPECT_EQ( buffer.str() , "q[12]" ) ;
+    buffer.clear() ;
+    EXPECT_EQ( buffer.size() , 0 ) ;
+    const R theta = R(1) / R(3) ;
+    buffer.append( theta ) ;
+    EXPECT_EQ( R( std::stod( buffer.str() ) ) , theta ) ;
+    buffer.clear() ;
+    buffer.rx( 3 , R(0.5) ).cx( 3 , 4 ).ry( 4 , R(-2) ).rz( 0 , R(0) ) ;
+    EXPECT_EQ( buffer.str() , "rx(0.5) q[3];\n"
+                              "cx q[3], q[4];\n"
+                              "ry(-2) q[4];\n"
+                              "rz(0) q[0];\n" ) ;
+  }
+
+  // growth
+  {
+    f3c::io::QASMBuffer buffer( 1 ) ;
+    std::stringstream stream ;
+    for ( int i = 0; i < 1000; i++ ) {
+      buffer.rx( i , R(0.25) ) ;
+      stream << "rx(0.25) q[" << i << "];\n" ;
+    }
+    EXPECT_EQ( buffer.str() , stream.str() ) ;
+    const size_t capacity = buffer.capacity() ;
+    buffer.clear() ;
+    EXPECT_EQ( buffer.capacity() , capacity ) ;
+    std::stringstream write ;
+    buffer.rx( 0 , R(0.25) ) ;
+    buffer.write( write ) ;
+    EXPECT_EQ( write.str() , "rx(0.25) q[0];\n" ) ;
+  }
+
+  // gates
+  {
+    std::mt19937 gen( 2021 ) ;
+    std::uniform_real_distribution< R > dis( -3 , 3 ) ;
+    R theta[6] ;
+    for ( int i = 0; i < 6; i++ ) theta[i] = dis( gen ) ;
+    f3c::io::QASMBuffer buffer ;
+
+    f3c::qasmRxy( buffer , 1 , 2 , theta[0] , theta[1] ) ;
+    test_f3c_qasm_equal< R >( buffer , f3c::qasmRxy( 1 , 2 , theta[0] ,
+                                                       theta[1] ) ) ;
+    buffer.clear() ;
+    f3c::qasmRxx( buffer , 1 , 2 , theta[0] ) ;
+    test_f3c_qasm_equal< R >( buffer , f3c::qasmRxx( 1 , 2 , theta[0] ) ) ;
+    buffer.clear() ;
+    f3c::qasmRxz( buffer , 1 , 2 , theta[0] , theta[1] ) ;
+    test_f3c_qasm_equal< R >( buffer , f3c::qasmRxz( 1 , 2 , theta[0] ,
+                                                       theta[1] ) ) ;
+    buffer.clear() ;
+    f3c::qasmRyz( buffer , 1 , 2 , theta[0] , theta[1] ) ;
+    test_f3c_qasm_equal< R >( buffer , f3c::qasmRyz( 1 , 2 , theta[0] ,
+                                                       theta[1] ) ) ;
+    buffer.clear() ;
+    f3c::qasmTFRxy( buffer , 1 , 2 , theta[0] , theta[1] , theta[2] ,
+                                     theta[3] , theta[4] , theta[5] ) ;
+    test_f3c_qasm_equal< R >( buffer , f3c::qasmTFRxy( 1 , 2 ,
+                                    theta[0] , theta[1] , theta[2] ,
+                                    theta[3] , theta[4] , theta[5] ) ) ;
+    buffer.clear() ;
+    f3c::qasmTFRxz( buffer , 1 , 2 , theta[0] , theta[1] , theta[2] ,
+                                     theta[3] , theta[4] , theta[5] ) ;
+    test_f3c_qasm_equal< R >( buffer , f3c::qasmTFRxz( 1 , 2 ,
+                                    theta[0] , theta[1] , theta[2] ,
+                                    theta[3] , theta[4] , theta[5] ) ) ;
+    buffer.clear() ;
+    f3c::qasmTFRyz( buffer , 1 , 2 , theta[0] , theta[1] , theta[2] ,
+                                     theta[3] , theta[4] , theta[5] ) ;
+    test_f3c_qasm_equal< R >( buffer , f3c::qasmTFRyz( 1 , 2 ,
+                                    theta[0] , theta[1] , theta[2] ,
+                                    theta[3] , theta[4] , theta[5] ) ) ;
+  }
+
+}
+
+
+template <template <typename> class F>
+void test_f3c_qasm_circuit( const int N ) {
+
+  using T = std::complex< double > ;
+  using G = typename F< T >::gate_type ;
+
+  std::mt19937 gen( 2021 + N ) ;
+  std::uniform_real_distribution< double > dis( -1 , 1 ) ;
+
+  // random circuit with an offset
+  qclab::QCircuit< T , G >  circuit( N , 2 ) ;
+  for ( int i = 0; i < N-1; i++ ) {
+    circuit.push_back( F< T >::init( i , dis , gen ) ) ;
+  }
+
+  std::stringstream stream ;
+  F< T >::toQASM( circuit , stream ) ;
+  f3c::io::QASMBuffer buffer ;
+  F< T >::toQASM( circuit , buffer ) ;
+  test_f3c_qasm_equal( buffer , stream.str() ) ;
+
+}
+
+
+template <template <typename> class F>
+void test_f3c_qasm_render( const int N ) {
+
+  using T = std::complex< double > ;
+  using G = typename F< T >::gate_type ;
+
+  std::mt19937 gen( 2021 + N ) ;
+  std::uniform_real_distribution< double > dis( -1 , 1 ) ;
+
+  // circuit with more gates than the default grain
+  qclab::QCircuit< T , G >  circuit( N , 1 ) ;
+  for ( int l = 0; l < 5000 / (N-1) + 1; l++ ) {
+    for ( int i = 0; i < N-1; i++ ) {
+      circuit.push_back( F< T >::init( i , dis , gen ) ) ;
+    }
+  }
+  ASSERT_GT( circuit.nbGates() , 4096 ) ;
+
+  // sequential rendering of the functor and of the gates
+  f3c::io::QASMBuffer sequential ;
+  f3c::io::QASMBuffer gates ;
+  for ( auto it = circuit.begin(); it != circuit.end(); ++it ) {
+    qclab::QCircuit< T , G >  gate( N , circuit.offset() ) ;
+    gate.push_back( std::make_unique< G >( **it ) ) ;
+    F< T >::toQASM( gate , sequential ) ;
+    (*it)->toQASM( gates , circuit.offset() ) ;
+  }
+
+  // parallel rendering
+  f3c::io::QASMBuffer parallel ;
+  parallel.append( "header\n" ) ;
+  F< T >::toQASM( circuit , parallel ) ;
+  EXPECT_TRUE( parallel.view() == "header\n" + sequential.str() ) ;
+
+  // small ranges and reuse of the range buffers
+  for ( const size_t grain : { 7 , 100 , 1000 } ) {
+    parallel.clear() ;
+    f3c::io::renderQASM( parallel , circuit.nbGates() ,
+                         [&]( f3c::io::QASMBuffer& part , const size_t k ) {
+      circuit[k]->toQASM( part , circuit.offset() ) ;
+    } , grain ) ;
+    EXPECT_TRUE( parallel.view() == gates.view() ) ;
+  }
+
+}
+
+
+/*
+ * QASM buffer
+ */
+TEST( f3c_qasm , buffer ) {
+  test_f3c_qasm_buffer< float >() ;
+  test_f3c_qasm_buffer< double >() ;
+}
+
+TEST( f3c_qasm , circuit ) {
+  for ( int N = 2; N <= 6; N += 2 ) {
+    test_f3c_qasm_circuit< f3c::qgates::XYfunctor >( N ) ;
+    test_f3c_qasm_circuit< f3c::qgates::XZfunctor >( N ) ;
+    test_f3c_qasm_circuit< f3c::qgates::YZfunctor >( N ) ;
+    test_f3c_qasm_circuit< f3c::qgates::TFXYfunctor >( N ) ;
+    test_f3c_qasm_circuit< f3c::qgates::TFXZfunctor >( N ) ;
+    test_f3c_qasm_circuit< f3c::qgates::TFYZfunctor >( N ) ;
+    test_f3c_qasm_circuit< f3c::qgates::TFXYU1functor >( N ) ;
+    test_f3c_qasm_circuit< f3c::qgates::TFIMfunctor >( 2*N ) ;
+  }
+}
+
+TEST( f3c_qasm , render ) {
+  test_f3c_qasm_render< f3c::qgates::XYfunctor >( 10 ) ;
+  test_f3c_qasm_render< f3c::qgates::TFXYfunctor >( 10 ) ;
+  test_f3c_qasm_render< f3c::qgates::TFXZfunctor >( 10 ) ;
+  test_f3c_qasm_render< f3c::qgates::TFIMfunctor >( 20 ) ;
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "f3c/qgates/RotationTFIM.hpp"
+#include "qclab/qgates/RotationZ.hpp"
+#include "qclab/qgates/RotationXX.hpp"
+#include "qclab/QCircuit.hpp"
+
+template <typename T>
+void test_f3c_qgates_RotationTFIM() {
+
+  using R = qclab::real_t< T > ;
+  const R eps = std::numeric_limits< R >::epsilon() ;
+
+  {
+    f3c::qgates::RotationTFIM< T >  TFIM ;
+
+    EXPECT_EQ( TFIM.nbQubits() , 2 ) ;   // nbQubits
+    EXPECT_FALSE( TFIM.fixed() ) ;       // fixed
+    EXPECT_FALSE( TFIM.controlled() ) ;  // controlled
+    EXPECT_FALSE( TFIM.isXX() ) ;        // isXX
+
+    // matrix
+    auto eye = qclab::dense::eye< T >( 4 ) ;
+    EXPECT_TRUE( TFIM.matrix() == eye ) ;
+
+    // qubits
+    EXPECT_EQ( TFIM.qubit() , 0 ) ;
+    EXPECT_EQ( TFIM.qubits().size() , 2 ) ;
+    EXPECT_EQ( TFIM.qubits()[0] , 0 ) ;
+    EXPECT_EQ( TFIM.qubits()[1] , 1 ) ;
+    int qnew[2] = { 4 , 3 } ;
+    TFIM.setQubits( &qnew[0] ) ;
+    EXPECT_EQ( TFIM.qubitPair()[0] , 3 ) ;
+    EXPECT_EQ( TFIM.qubitPair()[1] , 4 ) ;
+    EXPECT_TRUE( TFIM.isXX() ) ;
+
+    // update(theta)
+    const R theta = 0.7 ;
+    TFIM.update( theta ) ;
+    EXPECT_NEAR( TFIM.theta() , theta , 10*eps ) ;
+    EXPECT_NEAR( TFIM.rotation().cos() , std::cos( theta/2 ) , 10*eps ) ;
+    EXPECT_NEAR( TFIM.rotation().sin() , std::sin( theta/2 ) , 10*eps ) ;
+
+    // print
+    TFIM.print() ;
+
+    // operators == and !=
+    {
+      f3c::qgates::RotationTFIM< T >  TFIM2( 3 , 4 , theta ) ;
+      EXPECT_TRUE( TFIM == TFIM2 ) ;
+      EXPECT_FALSE( TFIM != TFIM2 ) ;
+      TFIM2.update( -theta ) ;
+      EXPECT_TRUE( TFIM != TFIM2 ) ;
+      f3c::qgates::RotationTFIM< T >  TFIM3( 4 , 5 , theta ) ;
+      EXPECT_TRUE( TFIM != TFIM3 ) ;
+    }
+  }
+
+
+  //
+  // matrix and QASM of Z-rotations: modes 2q and 2q+1
+  //
+  {
+    const R theta = -1.3 ;
+    f3c::qgates::RotationTFIM< T >  TFIM( 4 , 5 , theta ) ;
+    EXPECT_FALSE( TFIM.isXX() ) ;
+
+    qclab::QCircuit< T >  circuit( 2 ) ;
+    circuit.push_back( std::make_unique< qclab::qgates::RotationZ< T > >(
+                                                              0 , theta ) ) ;
+    EXPECT_NEAR( qclab::nrmF( TFIM , circuit ) , 0.0 , 10*eps ) ;
+
+    std::stringstream qasm ;
+    EXPECT_EQ( TFIM.toQASM( qasm ) , 0 ) ;
+    EXPECT_EQ( qasm.str() , qclab::qasmRz( 2 , theta ) ) ;
+  }
+
+
+  //
+  // matrix and QASM of XX-rotations: modes 2q+1 and 2q+2
+  //
+  {
+    const R theta = 0.4 ;
+    f3c::qgates::RotationTFIM< T >  TFIM( 3 , 4 , theta ) ;
+    EXPECT_TRUE( TFIM.isXX() ) ;
+
+    const qclab::qgates::RotationXX< T >  Rxx( 0 , 1 , theta ) ;
+    EXPECT_NEAR( qclab::nrmF( TFIM , Rxx ) , 0.0 , 10*eps ) ;
+
+    std::stringstream qasm ;
+    EXPECT_EQ( TFIM.toQASM( qasm , 2 ) , 0 ) ;
+    EXPECT_EQ( qasm.str() , f3c::qasmRxx( 3 , 4 , theta ) ) ;
+  }
+
+
+  //
+  // operators
+  //
+  {
+    const R theta1 = 0.3 ;
+    const R theta2 = -1.1 ;
+    f3c::qgates::RotationTFIM< T >  TFIM1( 1 , 2 , theta1 ) ;
+    f3c::qgates::RotationTFIM< T >  TFIM2( 1 , 2 , theta2 ) ;
+
+    // operator *
+    const auto TFIM3 = TFIM1 * TFIM2 ;
+    EXPECT_NEAR( TFIM1.theta() , theta1 , 10*eps ) ;
+    EXPECT_NEAR( TFIM3.theta() , theta1 + theta2 , 10*eps ) ;
+    EXPECT_EQ( TFIM3.qubitPair() , TFIM1.qubitPair() ) ;
+
+    // operator *=
+    TFIM1 *= TFIM2 ;
+    EXPECT_NEAR( TFIM1.theta() , theta1 + theta2 , 10*eps ) ;
+    const f3c::qgates::RotationTFIM< T >  TFIM4( 1 , 2 , theta1 + theta2 ) ;
+    EXPECT_NEAR( qclab::nrmF( TFIM1 , TFIM4 ) , 0.0 , 10*eps ) ;
+  }
+
+}
+
+
+/*
+ * complex float
+ */
+TEST( f3c_qgates_RotationTFIM , complex_float ) {
+  test_f3c_qgates_RotationTFIM< std::complex< float > >() ;
+}
+
+/*
+ * complex double
+ */
+TEST( f3c_qgates_RotationTFIM , complex_double ) {
+  test_f3c_qgates_RotationTFIM< std::complex< double > >() ;
+}
@@ -29,6 +29,8 @@ void test_f3c_qgates_RotationTFXY() {
     EXPECT_EQ( TFRxy.qubits().size() , 2 ) ;
     EXPECT_EQ( TFRxy.qubits()[0] , 3 ) ;
     EXPECT_EQ( TFRxy.qubits()[1] , 5 ) ;
+    EXPECT_EQ( TFRxy.qubitPair()[0] , 3 ) ;
+    EXPECT_EQ( TFRxy.qubitPair()[1] , 5 ) ;
 
     // rotations and thetas
     auto [ rot0 , rot1 , rot2 , rot3 , rot4 , rot5 ] = TFRxy.rotations() ;
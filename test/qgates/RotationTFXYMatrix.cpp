@@ -29,6 +29,8 @@ void test_f3c_qgates_RotationTFXYMatrix() {
     EXPECT_EQ( TFRxy.qubits().size() , 2 ) ;
     EXPECT_EQ( TFRxy.qubits()[0] , 3 ) ;
     EXPECT_EQ( TFRxy.qubits()[1] , 5 ) ;
+    EXPECT_EQ( TFRxy.qubitPair()[0] , 3 ) ;
+    EXPECT_EQ( TFRxy.qubitPair()[1] , 5 ) ;
 
     // update(a,b,c,d)
     const T a( std::sqrt( 2. ) / 2 ) ;
@@ -69,10 +71,27 @@ void test_f3c_qgates_RotationTFXYMatrix() {
     {
       std::stringstream qasm ;
       EXPECT_EQ( TFRxy.toQASM( qasm ) , 0 ) ;
-      std::stringstream qasm_check ;
+      const auto theta = TFRxy.thetas() ;
+      const auto qasm_check = f3c::qasmTFRxy( 3 , 5 , theta[0] , theta[1] ,
+                                              theta[2] , theta[3] ,
+                                              theta[4] , theta[5] ) ;
+      EXPECT_EQ( qasm.str() , qasm_check ) ;
+    }
+
+    // thetas
+    {
+      const auto theta = TFRxy.thetas() ;
       f3c::qgates::RotationTFXY< T >  tmp( TFRxy ) ;
-      tmp.toQASM( qasm_check ) ;
-      EXPECT_EQ( qasm.str() , qasm_check.str() ) ;
+      EXPECT_NEAR( theta[0] , tmp.theta0() , 10*eps ) ;
+      EXPECT_NEAR( theta[1] , tmp.theta1() , 10*eps ) ;
+      EXPECT_NEAR( theta[2] , tmp.theta2() , 10*eps ) ;
+      EXPECT_NEAR( theta[3] , tmp.theta3() , 10*eps ) ;
+      EXPECT_NEAR( theta[4] , tmp.theta4() , 10*eps ) ;
+      EXPECT_NEAR( theta[5] , tmp.theta5() , 10*eps ) ;
+      for ( const auto t : theta ) {
+        EXPECT_GT( t , -2*pi ) ;
+        EXPECT_LE( t ,  2*pi ) ;
+      }
     }
 
     // operators == and !=
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include "f3c/qgates/RotationTFXYU1Matrix.hpp"
+#include "f3c/qgates/RotationTFXYMatrix.hpp"
+#include "f3c/qgates/RotationTFXY.hpp"
+
+template <typename T>
+void test_f3c_qgates_RotationTFXYU1Matrix() {
+
+  using R = qclab::real_t< T > ;
+  const R pi = 4 * std::atan(1) ;
+  const R eps = std::numeric_limits< R >::epsilon() ;
+
+  {
+    f3c::qgates::RotationTFXYU1Matrix< T >  TFRxy ;
+
+    EXPECT_EQ( TFRxy.nbQubits() , 2 ) ;   // nbQubits
+    EXPECT_FALSE( TFRxy.fixed() ) ;       // fixed
+    EXPECT_FALSE( TFRxy.controlled() ) ;  // controlled
+
+    // matrix
+    auto eye = qclab::dense::eye< T >( 4 ) ;
+    EXPECT_TRUE( TFRxy.matrix() == eye ) ;
+
+    // qubits
+    EXPECT_EQ( TFRxy.qubits().size() , 2 ) ;
+    EXPECT_EQ( TFRxy.qubits()[0] , 0 ) ;
+    EXPECT_EQ( TFRxy.qubits()[1] , 1 ) ;
+    int qnew[2] = { 5 , 3 } ;
+    TFRxy.setQubits( &qnew[0] ) ;
+    EXPECT_EQ( TFRxy.qubitPair()[0] , 3 ) ;
+    EXPECT_EQ( TFRxy.qubitPair()[1] , 5 ) ;
+
+    // update(a,b,c)
+    const T a( std::sqrt( 2. ) / 2 , -std::sqrt( 2. ) / 2 ) ;
+    const T b( 0 , std::sqrt( 2. ) / 2 ) ;
+    const T c( -std::sqrt( 2. ) / 2 ) ;
+    TFRxy.update( a , b , c ) ;
+    EXPECT_EQ( TFRxy.a() , a ) ;
+    EXPECT_EQ( TFRxy.b() , b ) ;
+    EXPECT_EQ( TFRxy.c() , c ) ;
+    EXPECT_EQ( TFRxy.d() , T(0) ) ;
+
+    // matrix
+    const f3c::qgates::RotationTFXYMatrix< T >  TFRxyMat( 3 , 5 ,
+                                                          a , b , c , 0 ) ;
+    EXPECT_TRUE( TFRxy.matrix() == TFRxyMat.matrix() ) ;
+
+    // print
+    TFRxy.print() ;
+
+    // toQASM
+    {
+      std::stringstream qasm ;
+      EXPECT_EQ( TFRxy.toQASM( qasm ) , 0 ) ;
+      std::stringstream qasm_check ;
+      TFRxyMat.toQASM( qasm_check ) ;
+      EXPECT_EQ( qasm.str() , qasm_check.str() ) ;
+    }
+
+    // thetas
+    {
+      const auto theta = TFRxy.thetas() ;
+      const auto theta_check = TFRxyMat.thetas() ;
+      for ( int i = 0; i < 6; i++ ) {
+        EXPECT_EQ( theta[i] , theta_check[i] ) ;
+        EXPECT_GT( theta[i] , -2*pi ) ;
+        EXPECT_LE( theta[i] ,  2*pi ) ;
+      }
+      EXPECT_NEAR( theta[2] , theta[3] , 10*eps ) ;
+    }
+
+    // operators == and !=
+    {
+      f3c::qgates::RotationTFXYU1Matrix< T >  TFRxy2( a , b , c ) ;
+      EXPECT_TRUE( TFRxy == TFRxy2 ) ;
+      EXPECT_FALSE( TFRxy != TFRxy2 ) ;
+      TFRxy2.update( 1 , 1 , 0 ) ;
+      EXPECT_TRUE( TFRxy != TFRxy2 ) ;
+      EXPECT_FALSE( TFRxy == TFRxy2 ) ;
+    }
+  }
+
+
+  //
+  // constructor with angles
+  //
+  {
+    int qubit0 = 3 ;
+    int qubit1 = 5 ;
+    const R theta0 =  pi/3 ;
+    const R theta1 = -0.33 ;
+    const R theta2 =  pi/2 ;
+    const R theta4 = -pi/5 ;
+    const R theta5 =  pi/9 ;
+    f3c::qgates::RotationTFXYU1Matrix< T >  TFRxy( qubit0 , qubit1 ,
+                                                   theta0 , theta1 , theta2 ,
+                                                   theta2 , theta4 , theta5 ) ;
+    f3c::qgates::RotationTFXY< T >  TFRxy2( qubit0 , qubit1 ,
+                                            theta0 , theta1 , theta2 ,
+                                            theta2 , theta4 , theta5 ) ;
+
+    auto qubits = TFRxy.qubits() ;
+    EXPECT_EQ( qubits[0] , qubit0 ) ;      // qubit0
+    EXPECT_EQ( qubits[1] , qubit1 ) ;      // qubit1
+
+    EXPECT_EQ( TFRxy.a() , TFRxy2.a() ) ;  // a
+    EXPECT_EQ( TFRxy.b() , TFRxy2.b() ) ;  // b
+    EXPECT_EQ( TFRxy.c() , TFRxy2.c() ) ;  // c
+    EXPECT_EQ( TFRxy2.d() , T(0) ) ;       // d
+  }
+
+
+  //
+  // constructor with gate
+  //
+  {
+    const T a( 0.6 , 0.8 ) ;
+    const T b( 0 , 0.6 ) ;
+    const T c( -0.8 ) ;
+    f3c::qgates::RotationTFXYMatrix< T >  TFRxyMat( 1 , 2 , a , b , c , 0 ) ;
+    f3c::qgates::RotationTFXYU1Matrix< T >  TFRxy( TFRxyMat ) ;
+
+    EXPECT_EQ( TFRxy.qubitPair()[0] , 1 ) ;
+    EXPECT_EQ( TFRxy.qubitPair()[1] , 2 ) ;
+    EXPECT_EQ( TFRxy.a() , a ) ;
+    EXPECT_EQ( TFRxy.b() , b ) ;
+    EXPECT_EQ( TFRxy.c() , c ) ;
+  }
+
+
+  //
+  // operators
+  //
+  {
+    const T a1 = T( -9.738248368010318e-01 , -2.273159430066567e-01 ) ;
+    const T b1 = T( -1.646607339353139e-01 , -8.390082069075593e-01 ) ;
+    const T c1 = T( -2.653946050859590e-01 ,  4.455533357892336e-01 ) ;
+
+    const T a2 = T(  5.559769099003640e-01 ,  8.311961628693497e-01 ) ;
+    const T b2 = T( -6.062117964174196e-02 ,  8.916968089208992e-01 ) ;
+    const T c2 = T( -3.703676033540890e-01 ,  2.530409293471655e-01 ) ;
+
+    f3c::qgates::RotationTFXYU1Matrix< T >  RxyA( a1 , b1 , c1 ) ;
+    f3c::qgates::RotationTFXYU1Matrix< T >  RxyB( a2 , b2 , c2 ) ;
+    f3c::qgates::RotationTFXYMatrix< T >  MatA( a1 , b1 , c1 , 0 ) ;
+    f3c::qgates::RotationTFXYMatrix< T >  MatB( a2 , b2 , c2 , 0 ) ;
+
+    // operator *
+    const auto RxyC = RxyA * RxyB ;
+    const auto MatC = MatA * MatB ;
+    EXPECT_EQ( RxyA.a() , a1 ) ;
+    EXPECT_EQ( RxyB.a() , a2 ) ;
+
+    // operator *=
+    RxyA *= RxyB ;
+    MatA *= MatB ;
+
+    for ( const auto& Rxy : { RxyA , RxyC } ) {
+      EXPECT_NEAR( std::abs( Rxy.a() - MatA.a() ) , 0 , 10*eps ) ;
+      EXPECT_NEAR( std::abs( Rxy.b() - MatA.b() ) , 0 , 10*eps ) ;
+      EXPECT_NEAR( std::abs( Rxy.c() - MatA.c() ) , 0 , 10*eps ) ;
+    }
+    EXPECT_EQ( MatA.d() , T(0) ) ;
+    EXPECT_EQ( MatC.d() , T(0) ) ;
+  }
+
+}
+
+
+/*
+ * complex float
+ */
+TEST( f3c_qgates_RotationTFXYU1Matrix , complex_float ) {
+  test_f3c_qgates_RotationTFXYU1Matrix< std::complex< float > >() ;
+}
+
+/*
+ * complex double
+ */
+TEST( f3c_qgates_RotationTFXYU1Matrix , complex_double ) {
+  test_f3c_qgates_RotationTFXYU1Matrix< std::complex< double > >() ;
+}
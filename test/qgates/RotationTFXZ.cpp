@@ -2,6 +2,7 @@
 #include "f3c/qgates/RotationTFXZ.hpp"
 #include "f3c/qgates/RotationTFXY.hpp"
 #include "f3c/qgates/RotationTFXYMatrix.hpp"
+#include "f3c/qgates/functors.hpp"
 
 template <typename T>
 void test_f3c_qgates_RotationTFXZ() {
@@ -697,6 +698,35 @@ void test_f3c_qgates_RotationTFXZ() {
     EXPECT_NEAR( thB5 , thetaB5 , 10*eps ) ;  // thetaB5
   }
 
+
+  //
+  // QASM of TFXY matrix circuit
+  //
+  {
+    using TFXY = f3c::qgates::RotationTFXYMatrix< T > ;
+    const T a( std::sqrt( 2. ) / 2 ) ;
+    const T b( 0 , std::sqrt( 2. ) / 2 ) ;
+    const T c( -std::sqrt( 2. ) / 2 ) ;
+    const T d( 0 , -std::sqrt( 2. ) / 2 ) ;
+    qclab::QCircuit< T , TFXY >  circuit( 4 , 2 ) ;
+    circuit.push_back( std::make_unique< TFXY >( 0 , 1 , a , b , c , d ) ) ;
+    circuit.push_back( std::make_unique< TFXY >( 1 , 2 , b , a , d , c ) ) ;
+    std::stringstream qasm ;
+    f3c::qgates::TFXZfunctor< T >::toQASM( circuit , qasm ) ;
+    std::string qasm_check ;
+    for ( const auto& gate : { *circuit[0] , *circuit[1] } ) {
+      const auto theta = gate.thetas() ;
+      f3c::qgates::RotationTFXZ< T >  tmp( gate ) ;
+      EXPECT_NEAR( theta[0] , tmp.theta0() , 10*eps ) ;
+      EXPECT_NEAR( theta[5] , tmp.theta5() , 10*eps ) ;
+      qasm_check += f3c::qasmTFRxz( gate.qubitPair()[0] + 2 ,
+                                    gate.qubitPair()[1] + 2 ,
+                                    theta[0] , theta[1] , theta[2] ,
+                                    theta[3] , theta[4] , theta[5] ) ;
+    }
+    EXPECT_EQ( qasm.str() , qasm_check ) ;
+  }
+
 }
 
 
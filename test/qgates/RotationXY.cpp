@@ -28,6 +28,8 @@ void test_f3c_qgates_RotationXY() {
     EXPECT_EQ( Rxy.qubits().size() , 2 ) ;
     EXPECT_EQ( Rxy.qubits()[0] , 3 ) ;
     EXPECT_EQ( Rxy.qubits()[1] , 5 ) ;
+    EXPECT_EQ( Rxy.qubitPair()[0] , 3 ) ;
+    EXPECT_EQ( Rxy.qubitPair()[1] , 5 ) ;
 
     // rotations and thetas
     auto [ rot0 , rot1 ] = Rxy.rotations() ;
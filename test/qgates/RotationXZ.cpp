@@ -28,6 +28,8 @@ void test_f3c_qgates_RotationXZ() {
     EXPECT_EQ( Rxz.qubits().size() , 2 ) ;
     EXPECT_EQ( Rxz.qubits()[0] , 3 ) ;
     EXPECT_EQ( Rxz.qubits()[1] , 5 ) ;
+    EXPECT_EQ( Rxz.qubitPair()[0] , 3 ) ;
+    EXPECT_EQ( Rxz.qubitPair()[1] , 5 ) ;
 
     // rotations and thetas
     auto [ rot0 , rot1 ] = Rxz.rotations() ;
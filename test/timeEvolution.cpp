@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "timeEvolution.hpp"
+
+template <template <typename> class F>
+void test_f3c_timeEvolution_compressChunks( const int N , const bool field ) {
+
+  using T = std::complex< double > ;
+  using P = f3c::Param< double > ;
+
+  const double eps = std::numeric_limits< double >::epsilon() ;
+
+  // time-dependent parameters, with a Z field if `field` is true
+  const size_t ntot = 40 ;
+  const double dt = 0.1 ;
+  const f3c::ConstValue< double >  hx( 0 ) ;
+  const f3c::ConstValue< double >  hy( 0 ) ;
+  const f3c::LinearRamp< double >  hz( field ? 0.2 : 0 , field ? 1.0 : 0 ,
+                                       0 , ntot ) ;
+  const f3c::LinearRamp< double >  Jx( 1.0 , 0.4 , 0 , ntot ) ;
+  const f3c::ConstValue< double >  Jy( -0.6 ) ;
+  const f3c::ConstValue< double >  Jz( 0 ) ;
+  const P* params[6] = { &hx , &hy , &hz , &Jx , &Jy , &Jz } ;
+
+  // sequential compression
+  const auto sequential = compressChunk< F< T > >( N , dt , 0 , ntot ,
+                                                   params[0] , params[1] ,
+                                                   params[2] , params[3] ,
+                                                   params[4] , params[5] ) ;
+
+  // chunks compressed in parallel and reduced in a binary tree
+  for ( const int nbChunks : { 1 , 2 , 3 , 5 } ) {
+    const auto chunked = compressChunks< F< T > >( N , dt , 0 , ntot ,
+                                                   nbChunks ,
+                                                   params[0] , params[1] ,
+                                                   params[2] , params[3] ,
+                                                   params[4] , params[5] ) ;
+    EXPECT_NEAR( qclab::nrmF( chunked , sequential ) , 0.0 , 1e3*eps ) ;
+  }
+
+}
+
+
+/*
+ * chunked compression
+ */
+TEST( f3c_timeEvolution , compressChunks ) {
+  for ( const int N : { 5 , 6 } ) {
+    test_f3c_timeEvolution_compressChunks< f3c::qgates::XYfunctor >( N ,
+                                                                     false ) ;
+    test_f3c_timeEvolution_compressChunks< f3c::qgates::TFXYfunctor >( N ,
+                                                                       true ) ;
+  }
+}
+
+
+/// Returns the number of CNOTs in the QASM of the square form of `triangle`.
+template <typename F, typename C>
+int test_f3c_timeEvolution_nbCNOTs( C triangle ) {
+  std::ostringstream  stream ;
+  F::toQASM( triangle.toSquare() , stream ) ;
+  const std::string qasm = stream.str() ;
+  int nb = 0 ;
+  for ( auto i = qasm.find( "cx " ); i != std::string::npos;
+        i = qasm.find( "cx " , i + 1 ) ) {
+    nb++ ;
+  }
+  return nb ;
+}
+
+
+/*
+ * TFIM gates versus TFXY gates for Jy = 0
+ */
+TEST( f3c_timeEvolution , TFIMvsTFXY ) {
+
+  using T = std::complex< double > ;
+  using P = f3c::Param< double > ;
+  using TFXY = f3c::qgates::TFXYfunctor< T > ;
+  using TFIM = f3c::qgates::TFIMfunctor< T > ;
+
+  // N = 5 qubits, Jy = 0
+  const int N = 5 ;
+  const size_t ntot = 20 ;
+  const double dt = 0.1 ;
+  const f3c::ConstValue< double >  zero( 0 ) ;
+  const f3c::LinearRamp< double >  hz( 0.2 , 1.0 , 0 , ntot ) ;
+  const f3c::ConstValue< double >  Jx( 1.0 ) ;
+  const P* params[3] = { &zero , &hz , &Jx } ;
+
+  const auto tfxy = compressChunk< TFXY >( wires< TFXY >( N ) , dt , 0 , ntot ,
+                                           params[0] , params[0] , params[1] ,
+                                           params[2] , params[0] , params[0] ) ;
+  const auto tfim = compressChunk< TFIM >( wires< TFIM >( N ) , dt , 0 , ntot ,
+                                           params[0] , params[0] , params[1] ,
+                                           params[2] , params[0] , params[0] ) ;
+
+  // the TFIM circuit has twice the CNOTs of the TFXY circuit
+  const int nbTFXY = test_f3c_timeEvolution_nbCNOTs< TFXY >( tfxy ) ;
+  const int nbTFIM = test_f3c_timeEvolution_nbCNOTs< TFIM >( tfim ) ;
+  EXPECT_EQ( nbTFXY , N*(N-1) ) ;
+  EXPECT_EQ( nbTFIM , 2*nbTFXY ) ;
+  EXPECT_FALSE( Engine().tfim ) ;
+
+}
+
+
+/*
+ * snapshot pool of the writer threads
+ */
+TEST( f3c_timeEvolution , SnapshotPool ) {
+
+  using T = std::complex< double > ;
+  using XY = f3c::qgates::RotationXY< T > ;
+
+  qclab::QCircuit< T , XY >  circuit( 3 ) ;
+  circuit.push_back( std::make_unique< XY >( 0 , 1 , 0.1 , 0.2 ) ) ;
+  circuit.push_back( std::make_unique< XY >( 1 , 2 , 0.3 , 0.4 ) ) ;
+
+  SnapshotPool< T , XY >  pool( 2 ) ;
+  const size_t index1 = pool.acquire( circuit ) ;
+  const size_t index2 = pool.acquire( circuit ) ;
+  EXPECT_NE( index1 , index2 ) ;
+  EXPECT_EQ( qclab::nrmF( pool[index1] , circuit ) , 0.0 ) ;
+  const XY* gate = pool[index1][0].get() ;
+
+  // a returned snapshot is overwritten in place
+  circuit.push_back( std::make_unique< XY >( 0 , 1 , 0.5 , 0.6 ) ) ;
+  *circuit[0] = XY( 0 , 1 , 0.7 , 0.8 ) ;
+  pool.release( index1 ) ;
+  EXPECT_EQ( pool.acquire( circuit ) , index1 ) ;
+  EXPECT_EQ( pool[index1][0].get() , gate ) ;
+  ASSERT_EQ( pool[index1].nbGates() , circuit.nbGates() ) ;
+  EXPECT_EQ( qclab::nrmF( pool[index1] , circuit ) , 0.0 ) ;
+  EXPECT_EQ( pool[index2].nbGates() , size_t( 2 ) ) ;
+
+}
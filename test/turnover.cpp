@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "f3c/turnover.hpp"
 #include "qclab/QCircuit.hpp"
+#include "f3c/qgates/functors.hpp"
+#include "f3c/freeFermion.hpp"
 #include <random>
 
 template <typename G1, typename G2>
@@ -1263,6 +1265,238 @@ void test_f3c_turnover_TFXY( const char type , const R min , const R max ) {
 }
 
 
+template <typename R>
+void test_f3c_turnover_TFXY_diagonal() {
+
+  using T = std::complex< R > ;
+  using TFXY = f3c::qgates::RotationTFXYMatrix< T > ;
+
+  const R eps = std::numeric_limits< R >::epsilon() ;
+
+  std::mt19937 gen( 2021 ) ;
+  std::uniform_real_distribution< R > dis( -4 , 4 ) ;
+  auto phase = [&]() { const R t = dis( gen ) ;
+                       return T( std::cos( t ) , std::sin( t ) ) ; } ;
+
+  for ( const bool vee : { true , false } ) {
+    const int q1 = vee ? 0 : 1 ;
+    const int q2 = vee ? 1 : 0 ;
+    // position of the diagonal gate, 3 = identity in all positions
+    for ( int p = 0; p < 4; p++ ) {
+      std::array< TFXY , 3 >  gates ;
+      for ( int i = 0; i < 3; i++ ) {
+        const int q = ( i == 1 ) ? q2 : q1 ;
+        if ( p == 3 ) {
+          gates[i] = TFXY( q , q+1 , 1 , 1 , 0 , 0 ) ;
+        } else if ( i == p ) {
+          gates[i] = TFXY( q , q+1 , phase() , phase() , 0 , 0 ) ;
+        } else {
+          const auto [ a , d ] = test_f3c_turnover_genSU2( R(1) ) ;
+          const auto [ b , c ] = test_f3c_turnover_genSU2( R(1) ) ;
+          gates[i] = TFXY( q , q+1 , a , b , c , d ) ;
+        }
+      }
+      const auto [ gateA , gateB , gateC ] = f3c::turnover( gates[0] ,
+                                                            gates[1] ,
+                                                            gates[2] ) ;
+      EXPECT_EQ( gateA.qubitPair() , gates[1].qubitPair() ) ;
+      EXPECT_EQ( gateB.qubitPair() , gates[0].qubitPair() ) ;
+      EXPECT_EQ( gateC.qubitPair() , gates[1].qubitPair() ) ;
+
+      // fast path leaves an identity
+      if ( p == 2 ) {
+        EXPECT_TRUE( f3c::isIdentity( gateA ) ) ;
+      } else {
+        EXPECT_TRUE( f3c::isIdentity( gateC ) ) ;
+      }
+
+      qclab::QCircuit< T >  cin( 3 ) ;
+      for ( const auto& gate : gates ) {
+        cin.push_back( std::make_unique< TFXY >( gate ) ) ;
+      }
+      qclab::QCircuit< T >  cout( 3 ) ;
+      cout.push_back( std::make_unique< TFXY >( gateA ) ) ;
+      cout.push_back( std::make_unique< TFXY >( gateB ) ) ;
+      cout.push_back( std::make_unique< TFXY >( gateC ) ) ;
+      EXPECT_NEAR( qclab::nrmF( cin , cout ) , 0.0 , 10*eps ) ;
+    }
+  }
+
+}
+
+
+template <typename R>
+void test_f3c_turnover_TFXYU1() {
+
+  using T = std::complex< R > ;
+  using TFXYU1 = f3c::qgates::RotationTFXYU1Matrix< T > ;
+  using TFXY = f3c::qgates::RotationTFXYMatrix< T > ;
+
+  const R eps = std::numeric_limits< R >::epsilon() ;
+
+  std::mt19937 gen( 2021 ) ;
+  std::uniform_real_distribution< R > dis( -4 , 4 ) ;
+
+  for ( const bool vee : { true , false } ) {
+    const int q1 = vee ? 0 : 1 ;
+    const int q2 = vee ? 1 : 0 ;
+    for ( int k = 0; k < 10; k++ ) {
+      // random gates, gate 2 is a pure hopping gate for k = 0
+      std::array< TFXYU1 , 3 >  gates ;
+      for ( int i = 0; i < 3; i++ ) {
+        const int q = ( i == 1 ) ? q2 : q1 ;
+        const R theta = dis( gen ) ;
+        const R h = ( k == 0 && i == 1 ) ? R(0) : dis( gen ) ;
+        gates[i] = TFXYU1( q , q+1 , h , dis( gen ) , theta , theta ,
+                                     dis( gen ) , dis( gen ) ) ;
+      }
+      const auto [ gateA , gateB , gateC ] = f3c::turnover( gates[0] ,
+                                                            gates[1] ,
+                                                            gates[2] ) ;
+      EXPECT_EQ( gateA.qubitPair() , gates[1].qubitPair() ) ;
+      EXPECT_EQ( gateB.qubitPair() , gates[0].qubitPair() ) ;
+      EXPECT_EQ( gateC.qubitPair() , gates[1].qubitPair() ) ;
+
+      qclab::QCircuit< T >  cin( 3 ) ;
+      qclab::QCircuit< T >  cref( 3 ) ;
+      for ( const auto& gate : gates ) {
+        cin.push_back( std::make_unique< TFXYU1 >( gate ) ) ;
+        cref.push_back( std::make_unique< TFXY >( gate.qubit() ,
+                        gate.qubit() + 1 , gate.a() , gate.b() , gate.c() ,
+                        gate.d() ) ) ;
+      }
+      qclab::QCircuit< T >  cout( 3 ) ;
+      cout.push_back( std::make_unique< TFXYU1 >( gateA ) ) ;
+      cout.push_back( std::make_unique< TFXYU1 >( gateB ) ) ;
+      cout.push_back( std::make_unique< TFXYU1 >( gateC ) ) ;
+      EXPECT_NEAR( qclab::nrmF( cin , cout ) , 0.0 , 10*eps ) ;
+      EXPECT_NEAR( qclab::nrmF( cref , cout ) , 0.0 , 10*eps ) ;
+    }
+  }
+
+}
+
+
+template <typename R>
+void test_f3c_turnover_TFIM() {
+
+  using T = std::complex< R > ;
+  using TFIM = f3c::qgates::RotationTFIM< T > ;
+
+  const R eps = std::numeric_limits< R >::epsilon() ;
+
+  std::mt19937 gen( 2021 ) ;
+  std::uniform_real_distribution< R > dis( -4 , 4 ) ;
+
+  // Z-XX-Z and XX-Z-XX triples on 4 modes
+  for ( const int k : { 0 , 1 } ) {
+    for ( const bool vee : { true , false } ) {
+      const int q1 = vee ? k : k+1 ;
+      const int q2 = vee ? k+1 : k ;
+      std::array< TFIM , 3 >  gates = { TFIM( q1 , q1+1 , dis( gen ) ) ,
+                                        TFIM( q2 , q2+1 , dis( gen ) ) ,
+                                        TFIM( q1 , q1+1 , dis( gen ) ) } ;
+      const auto [ gateA , gateB , gateC ] = f3c::turnover( gates[0] ,
+                                                            gates[1] ,
+                                                            gates[2] ) ;
+      EXPECT_EQ( gateA.qubitPair() , gates[1].qubitPair() ) ;
+      EXPECT_EQ( gateB.qubitPair() , gates[0].qubitPair() ) ;
+      EXPECT_EQ( gateC.qubitPair() , gates[1].qubitPair() ) ;
+
+      // single-particle matrices on the modes
+      qclab::QCircuit< T , TFIM >  cin( 4 ) ;
+      for ( const auto& gate : gates ) {
+        cin.push_back( std::make_unique< TFIM >( gate ) ) ;
+      }
+      qclab::QCircuit< T , TFIM >  cout( 4 ) ;
+      cout.push_back( std::make_unique< TFIM >( gateA ) ) ;
+      cout.push_back( std::make_unique< TFIM >( gateB ) ) ;
+      cout.push_back( std::make_unique< TFIM >( gateC ) ) ;
+      EXPECT_NEAR( f3c::freeFermion::nrmF( cin , cout ) , 0.0 , 10*eps ) ;
+
+      // unitaries on the qubits of the modes
+      auto push = []( qclab::QCircuit< T >& circuit , const TFIM& gate ) {
+        if ( gate.isXX() ) {
+          circuit.push_back( std::make_unique< qclab::qgates::RotationXX< T > >(
+                                                  0 , 1 , gate.theta() ) ) ;
+        } else {
+          circuit.push_back( std::make_unique< qclab::qgates::RotationZ< T > >(
+                                          gate.qubit() / 2 , gate.theta() ) ) ;
+        }
+      } ;
+      qclab::QCircuit< T >  uin( 2 ) ;
+      qclab::QCircuit< T >  uout( 2 ) ;
+      for ( const auto& gate : gates ) push( uin , gate ) ;
+      for ( const auto& gate : { gateA , gateB , gateC } ) push( uout , gate ) ;
+      EXPECT_NEAR( qclab::nrmF( uin , uout ) , 0.0 , 10*eps ) ;
+    }
+  }
+
+}
+
+
+template <typename F, typename G = typename F::gate_type>
+void test_f3c_turnover_inPlace() {
+
+  using T = typename F::value_type ;
+  using R = qclab::real_t< T > ;
+
+  std::mt19937 gen( 2021 ) ;
+  std::uniform_real_distribution< R > dis( -1 , 1 ) ;
+
+  for ( const bool vee : { true , false } ) {
+    const int q1 = vee ? 0 : 1 ;
+    const int q2 = vee ? 1 : 0 ;
+    for ( int k = 0; k < 10; k++ ) {
+      G gate1( *F::init( q1 , dis , gen ) ) ;
+      G gate2( *F::init( q2 , dis , gen ) ) ;
+      G gate3( *F::init( q1 , dis , gen ) ) ;
+      const auto [ gateA , gateB , gateC ] = f3c::turnover( gate1 , gate2 ,
+                                                            gate3 ) ;
+      // orientation given at compile time
+      G gate4( gate1 ) ;
+      G gate5( gate2 ) ;
+      G gate6( gate3 ) ;
+      if ( vee ) {
+        f3c::turnoverInPlace< true >( gate4 , gate5 , gate6 ) ;
+      } else {
+        f3c::turnoverInPlace< false >( gate4 , gate5 , gate6 ) ;
+      }
+      // outputs aliasing the inputs in rotated order
+      G gate7( gate1 ) ;
+      G gate8( gate2 ) ;
+      G gate9( gate3 ) ;
+      if ( vee ) {
+        f3c::turnover< true >( gate7 , gate8 , gate9 , gate9 , gate7 , gate8 );
+      } else {
+        f3c::turnover< false >( gate7 , gate8 , gate9 , gate9 , gate7 , gate8 );
+      }
+      // orientation determined at runtime
+      f3c::turnoverInPlace( gate1 , gate2 , gate3 ) ;
+      EXPECT_EQ( f3c::qubitPair( gate1 ) , f3c::qubitPair( gateA ) ) ;
+      EXPECT_EQ( f3c::qubitPair( gate2 ) , f3c::qubitPair( gateB ) ) ;
+      EXPECT_EQ( f3c::qubitPair( gate3 ) , f3c::qubitPair( gateC ) ) ;
+      EXPECT_TRUE( gate1 == gateA ) ;
+      EXPECT_TRUE( gate2 == gateB ) ;
+      EXPECT_TRUE( gate3 == gateC ) ;
+      EXPECT_EQ( f3c::qubitPair( gate4 ) , f3c::qubitPair( gateA ) ) ;
+      EXPECT_EQ( f3c::qubitPair( gate5 ) , f3c::qubitPair( gateB ) ) ;
+      EXPECT_EQ( f3c::qubitPair( gate6 ) , f3c::qubitPair( gateC ) ) ;
+      EXPECT_TRUE( gate4 == gateA ) ;
+      EXPECT_TRUE( gate5 == gateB ) ;
+      EXPECT_TRUE( gate6 == gateC ) ;
+      EXPECT_EQ( f3c::qubitPair( gate9 ) , f3c::qubitPair( gateA ) ) ;
+      EXPECT_EQ( f3c::qubitPair( gate7 ) , f3c::qubitPair( gateB ) ) ;
+      EXPECT_EQ( f3c::qubitPair( gate8 ) , f3c::qubitPair( gateC ) ) ;
+      EXPECT_TRUE( gate9 == gateA ) ;
+      EXPECT_TRUE( gate7 == gateB ) ;
+      EXPECT_TRUE( gate8 == gateC ) ;
+    }
+  }
+
+}
+
+
 template <typename T>
 void test_f3c_turnover() {
 
@@ -1327,6 +1561,15 @@ void test_f3c_turnover() {
   test_f3c_turnover_TF< f3c::qgates::RotationTFYZ< T > >() ;
   test_f3c_turnover_TF< f3c::qgates::RotationTFXYMatrix< T > >() ;
 
+  test_f3c_turnover_inPlace< f3c::qgates::XYfunctor< T > >() ;
+  test_f3c_turnover_inPlace< f3c::qgates::XZfunctor< T > >() ;
+  test_f3c_turnover_inPlace< f3c::qgates::YZfunctor< T > >() ;
+  test_f3c_turnover_inPlace< f3c::qgates::TFXYfunctor< T > >() ;
+  test_f3c_turnover_inPlace< f3c::qgates::TFXYfunctor< T > ,
+                             f3c::qgates::RotationTFXY< T > >() ;
+  test_f3c_turnover_inPlace< f3c::qgates::TFXYU1functor< T > >() ;
+  test_f3c_turnover_inPlace< f3c::qgates::TFIMfunctor< T > >() ;
+
 }
 
 
@@ -1339,6 +1582,9 @@ TEST( f3c_turnover , complex_float ) {
   test_f3c_turnover_TFXY< float >( 'h' , 1e-3 , 1e3 ) ;
   test_f3c_turnover_TFXY< float >( 'v' , 1e-5 , 1e5 ) ;
   test_f3c_turnover_TFXY< float >( 'h' , 1e-5 , 1e5 ) ;
+  test_f3c_turnover_TFXY_diagonal< float >() ;
+  test_f3c_turnover_TFXYU1< float >() ;
+  test_f3c_turnover_TFIM< float >() ;
 }
 
 /*
@@ -1352,5 +1598,8 @@ TEST( f3c_turnover , complex_double ) {
   test_f3c_turnover_TFXY< double >( 'h' , 1e-7 , 1e7 ) ;
   test_f3c_turnover_TFXY< double >( 'v' , 1e-12 , 1e12 ) ;
   test_f3c_turnover_TFXY< double >( 'h' , 1e-12 , 1e12 ) ;
+  test_f3c_turnover_TFXY_diagonal< double >() ;
+  test_f3c_turnover_TFXYU1< double >() ;
+  test_f3c_turnover_TFIM< double >() ;
 }
 
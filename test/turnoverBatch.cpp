@@ -0,0 +1,260 @@
+#include <gtest/gtest.h>
+#include "f3c/turnoverBatch.hpp"
+#include "qclab/QCircuit.hpp"
+#include <random>
+
+template <typename R>
+void test_f3c_turnoverBatch( const char type ) {
+
+  using T = std::complex< R > ;
+  using TFXY = f3c::qgates::RotationTFXYMatrix< T > ;
+
+  const R eps = std::numeric_limits< R >::epsilon() ;
+
+  std::mt19937 gen( 2021 ) ;
+  std::uniform_real_distribution< R > dis( -4 , 4 ) ;
+  auto rand = [&]() { return dis( gen ) ; } ;
+
+  // qubits
+  const bool vee = ( type == 'v' ) ;
+  const int q1 = vee ? 0 : 1 ;
+  const int q2 = vee ? 1 : 0 ;
+
+  // random gates (not a multiple of the SIMD width)
+  const int n = 37 ;
+  std::vector< TFXY >  gates1 ;
+  std::vector< TFXY >  gates2 ;
+  std::vector< TFXY >  gates3 ;
+  f3c::TFXYBatch< R >  batch1( n ) ;
+  f3c::TFXYBatch< R >  batch2( n ) ;
+  f3c::TFXYBatch< R >  batch3( n ) ;
+  for ( int i = 0; i < n; i++ ) {
+    gates1.push_back( TFXY( q1 , q1 + 1 , rand() , rand() , rand() ,
+                                          rand() , rand() , rand() ) ) ;
+    gates2.push_back( TFXY( q2 , q2 + 1 , rand() , rand() , rand() ,
+                                          rand() , rand() , rand() ) ) ;
+    gates3.push_back( TFXY( q1 , q1 + 1 , rand() , rand() , rand() ,
+                                          rand() , rand() , rand() ) ) ;
+    batch1.set( i , gates1[i] ) ;
+    batch2.set( i , gates2[i] ) ;
+    batch3.set( i , gates3[i] ) ;
+  }
+  // identity and diagonal gates
+  gates1[0].update( 1 , 1 , 0 , 0 ) ;
+  batch1.set( 0 , gates1[0] ) ;
+  gates2[1].update( T( 0 , 1 ) , T( 0 , -1 ) , 0 , 0 ) ;
+  batch2.set( 1 , gates2[1] ) ;
+
+  // batched turnover
+  f3c::TFXYBatch< R >  batchA ;
+  f3c::TFXYBatch< R >  batchB ;
+  f3c::TFXYBatch< R >  batchC ;
+  f3c::turnoverBatch( vee , batch1 , batch2 , batch3 ,
+                      batchA , batchB , batchC ) ;
+  EXPECT_EQ( batchA.size() , n ) ;
+  EXPECT_EQ( batchB.size() , n ) ;
+  EXPECT_EQ( batchC.size() , n ) ;
+
+  for ( int i = 0; i < n; i++ ) {
+    // compare with scalar turnover
+    auto [ gateA , gateB , gateC ] = f3c::turnover( gates1[i] , gates2[i] ,
+                                                    gates3[i] ) ;
+    const auto vA = batchA.get( i ) ;
+    const auto vB = batchB.get( i ) ;
+    const auto vC = batchC.get( i ) ;
+    for ( int k = 0; k < 4; k++ ) {
+      EXPECT_NEAR( std::abs( vA[k] - gateA.values()[k] ) , 0 , 1e3*eps ) ;
+      EXPECT_NEAR( std::abs( vB[k] - gateB.values()[k] ) , 0 , 1e3*eps ) ;
+      EXPECT_NEAR( std::abs( vC[k] - gateC.values()[k] ) , 0 , 1e3*eps ) ;
+    }
+
+    // check circuits
+    qclab::QCircuit< T >  circ123( 3 ) ;
+    circ123.push_back( std::make_unique< TFXY >( gates1[i] ) ) ;
+    circ123.push_back( std::make_unique< TFXY >( gates2[i] ) ) ;
+    circ123.push_back( std::make_unique< TFXY >( gates3[i] ) ) ;
+
+    qclab::QCircuit< T >  circABC( 3 ) ;
+    circABC.push_back( std::make_unique< TFXY >( q2 , q2 + 1 , vA[0] , vA[1] ,
+                                                               vA[2] , vA[3] ) ) ;
+    circABC.push_back( std::make_unique< TFXY >( q1 , q1 + 1 , vB[0] , vB[1] ,
+                                                               vB[2] , vB[3] ) ) ;
+    circABC.push_back( std::make_unique< TFXY >( q2 , q2 + 1 , vC[0] , vC[1] ,
+                                                               vC[2] , vC[3] ) ) ;
+
+    EXPECT_NEAR( qclab::nrmF( circ123 , circABC ) , 0.0 , 100*eps ) ;
+  }
+
+}
+
+
+template <typename G>
+G test_f3c_turnoverBatch_gate( const int qubit , std::mt19937& gen ) {
+  using R = qclab::real_t< typename G::value_type > ;
+  std::uniform_real_distribution< R > dis( -4 , 4 ) ;
+  if constexpr ( f3c::is_TFXY_matrix_v< G > ) {
+    return G( qubit , qubit + 1 , dis( gen ) , dis( gen ) , dis( gen ) ,
+                                  dis( gen ) , dis( gen ) , dis( gen ) ) ;
+  } else if constexpr ( f3c::is_two_axes_v< G > ) {
+    return G( qubit , qubit + 1 , dis( gen ) , dis( gen ) ) ;
+  } else if constexpr ( f3c::is_one_axis2_v< G > || f3c::is_TFIM_v< G > ) {
+    return G( qubit , qubit + 1 , dis( gen ) ) ;
+  } else {
+    return G( qubit , dis( gen ) ) ;
+  }
+}
+
+
+template <typename G1, typename G2>
+void test_f3c_turnoverBatch_gates() {
+
+  using R = qclab::real_t< typename G1::value_type > ;
+  const R eps = std::numeric_limits< R >::epsilon() ;
+
+  std::mt19937 gen( 2021 ) ;
+
+  // random triples (not a multiple of the SIMD width or chunk size)
+  const int n = 101 ;
+  std::vector< G1 >  gates1 ;
+  std::vector< G2 >  gates2 ;
+  std::vector< G1 >  gates3 ;
+  for ( int i = 0; i < n; i++ ) {
+    // vee and hat triples for 2-qubit gates
+    const int q1 = ( i % 2 == 0 ) ? 0 : 1 ;
+    const int q2 = ( f3c::is_one_axis1_v< G1 > ||
+                     f3c::is_one_axis1_v< G2 > ) ? q1 : 1 - q1 ;
+    gates1.push_back( test_f3c_turnoverBatch_gate< G1 >( q1 , gen ) ) ;
+    gates2.push_back( test_f3c_turnoverBatch_gate< G2 >( q2 , gen ) ) ;
+    gates3.push_back( test_f3c_turnoverBatch_gate< G1 >( q1 , gen ) ) ;
+  }
+  if constexpr ( f3c::is_TFXY_matrix_v< G1 > ) {
+    // diagonal gates
+    gates1[2].update( 1 , 1 , 0 , 0 ) ;
+    gates2[3].update( typename G1::value_type( 0 , 1 ) ,
+                      typename G1::value_type( 0 , -1 ) , 0 , 0 ) ;
+  }
+
+  // pointers
+  std::vector< G2 >  gatesA( n ) ;
+  std::vector< G1 >  gatesB( n ) ;
+  std::vector< G2 >  gatesC( n ) ;
+  std::vector< const G1* >  p1( n ) , p3( n ) ;
+  std::vector< const G2* >  p2( n ) ;
+  std::vector< G2* >  pA( n ) , pC( n ) ;
+  std::vector< G1* >  pB( n ) ;
+  for ( int i = 0; i < n; i++ ) {
+    p1[i] = &gates1[i] ;  p2[i] = &gates2[i] ;  p3[i] = &gates3[i] ;
+    pA[i] = &gatesA[i] ;  pB[i] = &gatesB[i] ;  pC[i] = &gatesC[i] ;
+  }
+
+  // batched turnover
+  f3c::turnoverBatch( n , p1.data() , p2.data() , p3.data() ,
+                      pA.data() , pB.data() , pC.data() ) ;
+
+  // compare with scalar turnover
+  auto near = [&]( const auto& rot , const auto& ref ) {
+    EXPECT_NEAR( rot.cos() , ref.cos() , 10*eps ) ;
+    EXPECT_NEAR( rot.sin() , ref.sin() , 10*eps ) ;
+  } ;
+  auto check = [&]( const auto& gate , const auto& ref ) {
+    EXPECT_EQ( gate.qubits() , ref.qubits() ) ;
+    if constexpr ( f3c::is_TFXY_matrix_v< G1 > ) {
+      for ( int k = 0; k < 4; k++ ) {
+        EXPECT_NEAR( std::abs( gate.values()[k] - ref.values()[k] ) , 0 ,
+                     1e3*eps ) ;
+      }
+    } else if constexpr ( f3c::is_two_axes_v< G1 > ) {
+      near( std::get<0>( gate.rotations() ) , std::get<0>( ref.rotations() ) );
+      near( std::get<1>( gate.rotations() ) , std::get<1>( ref.rotations() ) );
+    } else {
+      near( gate.rotation() , ref.rotation() ) ;
+    }
+  } ;
+  for ( int i = 0; i < n; i++ ) {
+    const auto [ gateA , gateB , gateC ] = f3c::turnover( gates1[i] ,
+                                                          gates2[i] ,
+                                                          gates3[i] ) ;
+    check( gatesA[i] , gateA ) ;
+    check( gatesB[i] , gateB ) ;
+    check( gatesC[i] , gateC ) ;
+  }
+
+  // in place, with the outputs of the right and left side of mergeLayer
+  if constexpr ( std::is_same_v< G1 , G2 > ) {
+    for ( const bool right : { true , false } ) {
+      std::vector< G1 >  g1( gates1 ) , g2( gates2 ) , g3( gates3 ) ;
+      std::vector< G1* >  q1( n ) , q2( n ) , q3( n ) ;
+      for ( int i = 0; i < n; i++ ) {
+        q1[i] = &g1[i] ;  q2[i] = &g2[i] ;  q3[i] = &g3[i] ;
+      }
+      std::vector< const G1* >  c1( q1.begin() , q1.end() ) ;
+      std::vector< const G1* >  c2( q2.begin() , q2.end() ) ;
+      std::vector< const G1* >  c3( q3.begin() , q3.end() ) ;
+      if ( right ) {
+        f3c::turnoverBatch( n , c1.data() , c2.data() , c3.data() ,
+                            q3.data() , q1.data() , q2.data() ) ;
+      } else {
+        f3c::turnoverBatch( n , c1.data() , c2.data() , c3.data() ,
+                            q2.data() , q3.data() , q1.data() ) ;
+      }
+      const auto& gA = right ? g3 : g2 ;
+      const auto& gB = right ? g1 : g3 ;
+      const auto& gC = right ? g2 : g1 ;
+      for ( int i = 0; i < n; i++ ) {
+        EXPECT_TRUE( gA[i] == gatesA[i] ) ;
+        EXPECT_TRUE( gB[i] == gatesB[i] ) ;
+        EXPECT_TRUE( gC[i] == gatesC[i] ) ;
+      }
+    }
+  }
+
+}
+
+
+template <typename T>
+void test_f3c_turnoverBatch_gates() {
+
+  test_f3c_turnoverBatch_gates< qclab::qgates::RotationX< T > ,
+                                qclab::qgates::RotationY< T > >() ;
+  test_f3c_turnoverBatch_gates< qclab::qgates::RotationZ< T > ,
+                                qclab::qgates::RotationX< T > >() ;
+  test_f3c_turnoverBatch_gates< qclab::qgates::RotationX< T > ,
+                                qclab::qgates::RotationYY< T > >() ;
+  test_f3c_turnoverBatch_gates< qclab::qgates::RotationZZ< T > ,
+                                qclab::qgates::RotationY< T > >() ;
+  test_f3c_turnoverBatch_gates< qclab::qgates::RotationXX< T > ,
+                                qclab::qgates::RotationZZ< T > >() ;
+
+  test_f3c_turnoverBatch_gates< f3c::qgates::RotationXY< T > ,
+                                f3c::qgates::RotationXY< T > >() ;
+  test_f3c_turnoverBatch_gates< f3c::qgates::RotationXZ< T > ,
+                                f3c::qgates::RotationXZ< T > >() ;
+  test_f3c_turnoverBatch_gates< f3c::qgates::RotationYZ< T > ,
+                                f3c::qgates::RotationYZ< T > >() ;
+
+  test_f3c_turnoverBatch_gates< f3c::qgates::RotationTFIM< T > ,
+                                f3c::qgates::RotationTFIM< T > >() ;
+
+  test_f3c_turnoverBatch_gates< f3c::qgates::RotationTFXYMatrix< T > ,
+                                f3c::qgates::RotationTFXYMatrix< T > >() ;
+
+}
+
+
+/*
+ * float
+ */
+TEST( f3c_turnoverBatch , float ) {
+  test_f3c_turnoverBatch< float >( 'v' ) ;
+  test_f3c_turnoverBatch< float >( 'h' ) ;
+  test_f3c_turnoverBatch_gates< std::complex< float > >() ;
+}
+
+/*
+ * double
+ */
+TEST( f3c_turnoverBatch , double ) {
+  test_f3c_turnoverBatch< double >( 'v' ) ;
+  test_f3c_turnoverBatch< double >( 'h' ) ;
+  test_f3c_turnoverBatch_gates< std::complex< double > >() ;
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "f3c/turnoverSU2.hpp"
+#include <array>
+#include <vector>
 
 template <typename T>
 void test_f3c_turnoverSU2() {
@@ -17,7 +19,92 @@ void test_f3c_turnoverSU2() {
     EXPECT_NEAR( rotC.theta() , 0 , eps ) ;
   }
 
-  // TODO: add more tests
+  // degenerate rotations: X-Y-X = Y-X-Y
+  using C = std::complex< T > ;
+  using M = std::array< C , 4 > ;
+  auto mult = []( const M& A , const M& B ) {
+    return M{ A[0]*B[0] + A[1]*B[2] , A[0]*B[1] + A[1]*B[3] ,
+              A[2]*B[0] + A[3]*B[2] , A[2]*B[1] + A[3]*B[3] } ;
+  } ;
+  auto rotX = []( const qclab::QRotation< T >& rot ) {
+    const C c = rot.cos() ;
+    const C s = C( 0 , -rot.sin() ) ;
+    return M{ c , s , s , c } ;
+  } ;
+  auto rotY = []( const qclab::QRotation< T >& rot ) {
+    const C c = rot.cos() ;
+    const C s = rot.sin() ;
+    return M{ c , -s , s , c } ;
+  } ;
+  const std::vector< qclab::QRotation< T > >  rots = {
+    qclab::QRotation< T >() , qclab::QRotation< T >( pi ) ,
+    qclab::QRotation< T >( -pi ) , qclab::QRotation< T >( pi/2 ) ,
+    qclab::QRotation< T >( 0.3 ) , qclab::QRotation< T >( T(-0.0) , 1 ) } ;
+  for ( const auto& rot1 : rots ) {
+    for ( const auto& rot2 : rots ) {
+      for ( const auto& rot3 : rots ) {
+        auto [ rotA , rotB , rotC ] = f3c::turnoverSU2( rot1 , rot2 , rot3 ) ;
+        const M U1 = mult( mult( rotX( rot1 ) , rotY( rot2 ) ) , rotX( rot3 ) );
+        const M U2 = mult( mult( rotY( rotA ) , rotX( rotB ) ) , rotY( rotC ) );
+        for ( int i = 0; i < 4; i++ ) {
+          EXPECT_NEAR( std::abs( U1[i] - U2[i] ) , 0 , 10*eps ) ;
+        }
+      }
+    }
+  }
+
+  // identities are moved or fused exactly
+  {
+    const qclab::QRotation< T >  I ;
+    const qclab::QRotation< T >  rot1( 0.3 ) ;
+    const qclab::QRotation< T >  rot2( -0.7 ) ;
+    auto check = []( const qclab::QRotation< T >& rot ,
+                     const qclab::QRotation< T >& ref ) {
+      EXPECT_EQ( rot.cos() , ref.cos() ) ;
+      EXPECT_EQ( rot.sin() , ref.sin() ) ;
+    } ;
+    {
+      auto [ rotA , rotB , rotC ] = f3c::turnoverSU2( I , rot1 , rot2 ) ;
+      check( rotA , rot1 ) ;  check( rotB , rot2 ) ;  check( rotC , I ) ;
+    }
+    {
+      auto [ rotA , rotB , rotC ] = f3c::turnoverSU2( rot1 , I , rot2 ) ;
+      check( rotA , I ) ;  check( rotC , I ) ;
+      EXPECT_NEAR( rotB.theta() , T(0.3) - T(0.7) , 10*eps ) ;
+    }
+    {
+      auto [ rotA , rotB , rotC ] = f3c::turnoverSU2( rot1 , rot2 , I ) ;
+      check( rotA , I ) ;  check( rotB , rot1 ) ;  check( rotC , rot2 ) ;
+    }
+  }
+
+  // batch of all degenerate triples
+  const int m = rots.size() ;
+  const int n = m * m * m ;
+  std::vector< T >  in( 6*n ) ;
+  std::vector< T >  out( 6*n ) ;
+  for ( int i = 0; i < n; i++ ) {
+    const auto& rot1 = rots[ i % m ] ;
+    const auto& rot2 = rots[ ( i / m ) % m ] ;
+    const auto& rot3 = rots[ i / ( m*m ) ] ;
+    in[i      ] = rot1.cos() ;  in[i +   n] = rot1.sin() ;
+    in[i + 2*n] = rot2.cos() ;  in[i + 3*n] = rot2.sin() ;
+    in[i + 4*n] = rot3.cos() ;  in[i + 5*n] = rot3.sin() ;
+  }
+  f3c::turnoverSU2Batch( n , &in[0] , &in[n] , &in[2*n] , &in[3*n] ,
+                         &in[4*n] , &in[5*n] , &out[0] , &out[n] ,
+                         &out[2*n] , &out[3*n] , &out[4*n] , &out[5*n] ) ;
+  for ( int i = 0; i < n; i++ ) {
+    auto [ rotA , rotB , rotC ] = f3c::turnoverSU2( rots[ i % m ] ,
+                                                    rots[ ( i / m ) % m ] ,
+                                                    rots[ i / ( m*m ) ] ) ;
+    EXPECT_NEAR( out[i      ] , rotA.cos() , 10*eps ) ;
+    EXPECT_NEAR( out[i +   n] , rotA.sin() , 10*eps ) ;
+    EXPECT_NEAR( out[i + 2*n] , rotB.cos() , 10*eps ) ;
+    EXPECT_NEAR( out[i + 3*n] , rotB.sin() , 10*eps ) ;
+    EXPECT_NEAR( out[i + 4*n] , rotC.cos() , 10*eps ) ;
+    EXPECT_NEAR( out[i + 5*n] , rotC.sin() , 10*eps ) ;
+  }
 
 }
 
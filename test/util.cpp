@@ -195,6 +195,80 @@ void test_f3c_util_diagonalize22() {
 }
 
 
+template <typename R>
+void test_f3c_util_diagonalize22Direct() {
+
+  using T = std::complex< R > ;
+  using M = std::array< T , 4 > ;
+  const R eps = std::numeric_limits< R >::epsilon() ;
+
+  auto check = [eps]( const M& A0 , const M& B0 ) {
+    M  A( A0 ) ;
+    M  B( B0 ) ;
+    M  Q ;
+    M  Z ;
+    f3c::diagonalize22Direct( A.data() , B.data() , Q.data() , Z.data() ) ;
+    EXPECT_EQ( A[1] , T(0) ) ;
+    EXPECT_EQ( A[2] , T(0) ) ;
+    EXPECT_EQ( B[1] , T(0) ) ;
+    EXPECT_EQ( B[2] , T(0) ) ;
+    // Q and Z are special unitary
+    EXPECT_NEAR( std::abs( Q[0] - std::conj( Q[3] ) ) , 0 , 10*eps ) ;
+    EXPECT_NEAR( std::abs( Q[1] + std::conj( Q[2] ) ) , 0 , 10*eps ) ;
+    EXPECT_NEAR( std::norm( Q[0] ) + std::norm( Q[1] ) , 1 , 10*eps ) ;
+    EXPECT_NEAR( std::abs( Z[0] - std::conj( Z[3] ) ) , 0 , 10*eps ) ;
+    EXPECT_NEAR( std::abs( Z[1] + std::conj( Z[2] ) ) , 0 , 10*eps ) ;
+    EXPECT_NEAR( std::norm( Z[0] ) + std::norm( Z[1] ) , 1 , 10*eps ) ;
+    // Q * A0 * Z = A and Q * B0 * Z = B
+    M  W ;
+    M  D ;
+    f3c::gemm22( A0.data() , Z.data() , W.data() ) ;
+    f3c::gemm22( Q.data() , W.data() , D.data() ) ;
+    for ( int i = 0; i < 4; ++i ) {
+      EXPECT_NEAR( std::abs( D[i] - A[i] ) , 0 , 20*eps ) ;
+    }
+    f3c::gemm22( B0.data() , Z.data() , W.data() ) ;
+    f3c::gemm22( Q.data() , W.data() , D.data() ) ;
+    for ( int i = 0; i < 4; ++i ) {
+      EXPECT_NEAR( std::abs( D[i] - B[i] ) , 0 , 20*eps ) ;
+    }
+    // ordering: A(2,2) real, nonnegative and largest in modulus
+    EXPECT_LE( std::abs( A[0] ) , std::abs( A[3] ) + 10*eps ) ;
+    EXPECT_NEAR( std::imag( A[3] ) , 0 , 10*eps ) ;
+    EXPECT_GE( std::real( A[3] ) , 0 ) ;
+    return A ;
+  } ;
+
+  // same pencil as diagonalize22: equal diagonals
+  M  A0( { T( -1.773751566188252e-01 ,  1.978110534643607e-01 ) ,
+           T( -1.960534878073328e-01 ,  1.587699089974059e+00 ) ,
+           T(  1.419310150642549e+00 , -8.044659563495471e-01 ) ,
+           T(  2.915843739841825e-01 ,  6.966244158496073e-01 ) } ) ;
+  M  B0( { T(  2.915843739841825e-01 , -6.966244158496073e-01 ) ,
+           T( -1.419310150642549e+00 , -8.044659563495471e-01 ) ,
+           T(  1.960534878073328e-01 ,  1.587699089974059e+00 ) ,
+           T( -1.773751566188252e-01 , -1.978110534643607e-01 ) } ) ;
+  const M A = check( A0 , B0 ) ;
+  EXPECT_NEAR( std::real( A[0] ) , -5.978906623049421e-01 , 10*eps ) ;
+  EXPECT_NEAR( std::imag( A[0] ) , -1.246098865369929e+00 , 10*eps ) ;
+  EXPECT_NEAR( std::real( A[3] ) ,  1.987836689883845e+00 , 10*eps ) ;
+
+  // degenerate pencil: A is a multiple of a unitary matrix
+  const T a( 0.6 , 0.0 ) ;
+  const T b( 0.0 , 0.8 ) ;
+  M  A1( { R(2) * a , -R(2) * std::conj( b ) , R(2) * b , R(2) * std::conj( a ) } ) ;
+  M  B1( { T(0,2) * a , -T(0,2) * std::conj( b ) , T(0,2) * b ,
+           T(0,2) * std::conj( a ) } ) ;
+  check( A1 , B1 ) ;
+
+  // diagonal pencil
+  M  A2( { T( 0.5 , 0.5 ) , T(0) , T(0) , T( 2.0 , -1.0 ) } ) ;
+  M  B2( { T( 2.0 , 1.0 ) , T(0) , T(0) , T( 0.5 , -0.5 ) } ) ;
+  check( A2 , B2 ) ;
+
+}
+
+
 template <typename R>
 void test_f3c_util() {
 
@@ -203,6 +277,7 @@ void test_f3c_util() {
   test_f3c_util_rotateToZeroL< R >() ;
   test_f3c_util_rotateToZeroR< R >() ;
   test_f3c_util_diagonalize22< R >() ;
+  test_f3c_util_diagonalize22Direct< R >() ;
 
 }
 